@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+#include "config_number.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr uint32_t NUMBER_COUNT = 4096;
+
+// Text representations of typical configuration values
+struct NumberTexts {
+    std::vector<std::string> texts;
+    size_t bytes = 0;
+
+    explicit NumberTexts(bool floating) {
+        uint64_t state = 0x9e3779b97f4a7c15ull;
+        char buf[64];
+        for(uint32_t i = 0; i < NUMBER_COUNT; i++) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            if(floating) {
+                // Short decimals as written by hand and shortest round-trip output of arbitrary values
+                if(i % 2 == 0) snprintf(buf, sizeof(buf), "%u.%02u", static_cast<uint32_t>(state >> 52), i % 100);
+                else snprintf(buf, sizeof(buf), "%.9g", static_cast<double>(state >> 11) * 1e-10);
+            } else {
+                snprintf(buf, sizeof(buf), "%u", static_cast<uint32_t>(state >> (32 + i % 32)));
+            }
+            texts.emplace_back(buf);
+            bytes += texts.back().size();
+        }
+    }
+};
+
+void BM_ParseUint32(benchmark::State& state) {
+    const NumberTexts numbers(false);
+    for(auto _ : state) {
+        for(const std::string& text : numbers.texts) {
+            uint32_t value;
+            config_parseUint32(text.data(), text.size(), &value, nullptr);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numbers.bytes);
+    state.SetItemsProcessed(state.iterations() * NUMBER_COUNT);
+}
+
+// Previous path of the uint32 parsing
+void BM_Strtoull(benchmark::State& state) {
+    const NumberTexts numbers(false);
+    for(auto _ : state) {
+        for(const std::string& text : numbers.texts) {
+            const uint32_t value = strtoull(text.c_str(), nullptr, 10);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numbers.bytes);
+    state.SetItemsProcessed(state.iterations() * NUMBER_COUNT);
+}
+
+void BM_ParseFloat(benchmark::State& state) {
+    const NumberTexts numbers(true);
+    for(auto _ : state) {
+        for(const std::string& text : numbers.texts) {
+            float value;
+            config_parseFloat(text.data(), text.size(), &value, nullptr);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numbers.bytes);
+    state.SetItemsProcessed(state.iterations() * NUMBER_COUNT);
+}
+
+// Previous path of the float parsing
+void BM_Strtof(benchmark::State& state) {
+    const NumberTexts numbers(true);
+    for(auto _ : state) {
+        for(const std::string& text : numbers.texts) {
+            const float value = strtof(text.c_str(), nullptr);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numbers.bytes);
+    state.SetItemsProcessed(state.iterations() * NUMBER_COUNT);
+}
+
+void BM_ParseDouble(benchmark::State& state) {
+    const NumberTexts numbers(true);
+    for(auto _ : state) {
+        for(const std::string& text : numbers.texts) {
+            double value;
+            config_parseDouble(text.data(), text.size(), &value, nullptr);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numbers.bytes);
+    state.SetItemsProcessed(state.iterations() * NUMBER_COUNT);
+}
+
+void BM_Strtod(benchmark::State& state) {
+    const NumberTexts numbers(true);
+    for(auto _ : state) {
+        for(const std::string& text : numbers.texts) {
+            const double value = strtod(text.c_str(), nullptr);
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * numbers.bytes);
+    state.SetItemsProcessed(state.iterations() * NUMBER_COUNT);
+}
+}  // namespace
+
+BENCHMARK(BM_ParseUint32);
+BENCHMARK(BM_Strtoull);
+BENCHMARK(BM_ParseFloat);
+BENCHMARK(BM_Strtof);
+BENCHMARK(BM_ParseDouble);
+BENCHMARK(BM_Strtod);
@@ -0,0 +1,384 @@
+#include <benchmark/benchmark.h>
+#include "config_parallel.h"
+#include "config_table.h"
+#include "config_trie.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+// Number of prepared keys or indices the benchmarks cycle through
+constexpr uint32_t QUERY_COUNT = 4096;
+constexpr uint32_t STRING_SIZE = 24;
+
+enum class Lookup {
+    Linear,
+    Sorted,
+    Indexed
+};
+
+struct Field {
+    const char* name;
+    ConfigType_t type;
+};
+
+// Fields of every instance, the entry types follow from the field
+constexpr Field fields[] = {
+    {"enabled", CONFIG_BOOL},
+    {"gain", CONFIG_FLOAT},
+    {"offset", CONFIG_INT32},
+    {"name", CONFIG_STRING},
+    {"rate_hz", CONFIG_UINT32},
+    {"filter.cutoff_hz", CONFIG_FLOAT},
+    {"timeout_ms", CONFIG_UINT32},
+    {"mode", CONFIG_UINT32},
+};
+constexpr const char* groups[] = {
+    "net.wifi.ap", "net.eth", "sensor.imu", "sensor.temp", "motor", "ui.display", "power.battery", "can.node",
+};
+
+// Storage for the value of one entry of any type
+struct alignas(8) Value {
+    char data[STRING_SIZE];
+};
+
+// Table with dotted struct paths like "cfg.sensor.imu3.filter.cutoff_hz" and mixed entry types
+struct BenchTable {
+    std::vector<Value> values;
+    std::vector<std::string> keys;
+    std::vector<ConfigEntry_t> entries;
+    std::vector<ConfigIndexSlot_t> slots;
+    ConfigIndex_t index{};
+    ConfigTable_t table{};
+
+    BenchTable(uint32_t count, Lookup lookup)
+        : values(count), keys(count), entries(count), slots(CFG_INDEX_SLOT_COUNT(count)) {
+        constexpr uint32_t field_count = std::size(fields);
+        constexpr uint32_t group_count = std::size(groups);
+        for(uint32_t i = 0; i < count; i++) {
+            const Field& field = fields[i % field_count];
+            const uint32_t instance = i / field_count;
+            keys[i] = std::string("cfg.") + groups[instance % group_count] + std::to_string(instance / group_count) +
+                      "." + field.name;
+            const uint32_t size = field.type == CONFIG_STRING ? STRING_SIZE : field.type == CONFIG_BOOL ? 1 : 4;
+            if(field.type == CONFIG_STRING) snprintf(values[i].data, STRING_SIZE, "node %u", i);
+            else memcpy(values[i].data, &i, size);
+            entries[i] = {keys[i].c_str(), field.type, values[i].data, size};
+        }
+        table.entries = entries.data();
+        table.count = count;
+        if(lookup == Lookup::Sorted) config_sortTable(&table);
+        if(lookup == Lookup::Indexed) {
+            index.slots = slots.data();
+            index.slot_count = slots.size();
+            config_buildIndex(&table, &index);
+        }
+    }
+
+    // Indices of entries with the given type in a pseudo-random order, so lookups do not walk the table
+    std::vector<uint32_t> queries(ConfigType_t type) const {
+        std::vector<uint32_t> matching;
+        for(uint32_t i = 0; i < table.count; i++) {
+            if(entries[i].type == type) matching.push_back(i);
+        }
+        std::vector<uint32_t> result(QUERY_COUNT);
+        uint64_t state = 0x9e3779b97f4a7c15ull;
+        for(uint32_t& idx : result) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            idx = matching[(state >> 33) % matching.size()];
+        }
+        return result;
+    }
+};
+
+void BM_GetIdxFromKey(benchmark::State& state, Lookup lookup) {
+    BenchTable t(state.range(0), lookup);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_UINT32);
+    uint32_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getIdxFromKey(&t.table, t.entries[queries[i]].key));
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetIdxFromKeyMiss(benchmark::State& state, Lookup lookup) {
+    BenchTable t(state.range(0), lookup);
+    // Unknown keys share the prefix of the table keys
+    std::vector<std::string> keys(QUERY_COUNT);
+    for(uint32_t i = 0; i < QUERY_COUNT; i++) keys[i] = "cfg.sensor.imu" + std::to_string(i) + ".unknown";
+    uint32_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getIdxFromKey(&t.table, keys[i].c_str()));
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Trie over the keys of a table
+struct BenchTrie {
+    std::vector<ConfigTrieNode_t> nodes;
+    std::vector<uint32_t> order;
+    ConfigTrie_t trie{};
+
+    explicit BenchTrie(const ConfigTable_t& table) : nodes(config_trieNodeCount(&table)), order(table.count) {
+        trie.nodes = nodes.data();
+        trie.node_capacity = nodes.size();
+        trie.order = order.data();
+        config_trieBuild(&trie, &table);
+    }
+};
+
+// Instance prefixes like "cfg.sensor.imu3" in a pseudo-random order, each with one entry per field
+std::vector<std::string> instancePrefixes(uint32_t count) {
+    const uint32_t instance_count = (count + std::size(fields) - 1) / std::size(fields);
+    std::vector<std::string> prefixes(QUERY_COUNT);
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for(std::string& prefix : prefixes) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const uint32_t instance = (state >> 33) % instance_count;
+        prefix = std::string("cfg.") + groups[instance % std::size(groups)] + std::to_string(instance / std::size(groups));
+    }
+    return prefixes;
+}
+
+void BM_TrieGetIdx(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    BenchTrie trie(t.table);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_UINT32);
+    uint32_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_trieGetIdx(&trie.trie, t.entries[queries[i]].key));
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_TrieGetPrefix(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    BenchTrie trie(t.table);
+    const std::vector<std::string> prefixes = instancePrefixes(t.table.count);
+    uint32_t i = 0;
+    for(auto _ : state) {
+        const uint32_t* indices = nullptr;
+        uint32_t count = 0;
+        config_trieGetPrefix(&trie.trie, prefixes[i].c_str(), &indices, &count);
+        // Visit the matching entries like a caller listing them would
+        uint32_t sum = 0;
+        for(uint32_t j = 0; j < count; j++) sum += indices[j];
+        benchmark::DoNotOptimize(sum);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Baseline for BM_TrieGetPrefix: string matching every key of the table
+void BM_PrefixScan(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    const std::vector<std::string> prefixes = instancePrefixes(t.table.count);
+    uint32_t i = 0;
+    for(auto _ : state) {
+        const char* prefix = prefixes[i].c_str();
+        const size_t len = prefixes[i].size();
+        uint32_t sum = 0;
+        for(uint32_t j = 0; j < t.table.count; j++) {
+            const char* key = t.entries[j].key;
+            if(strncmp(key, prefix, len) == 0 && (key[len] == '.' || key[len] == '\0')) sum += j;
+        }
+        benchmark::DoNotOptimize(sum);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetUint32ByKey(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Indexed);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_UINT32);
+    uint32_t i = 0;
+    uint32_t value;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getUint32ByKey(&t.table, t.entries[queries[i]].key, &value));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetUint32ByIdx(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_UINT32);
+    uint32_t i = 0;
+    uint32_t value;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getUint32ByIdx(&t.table, queries[i], &value));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetFloatByKey(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Indexed);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_FLOAT);
+    uint32_t i = 0;
+    float value;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getFloatByKey(&t.table, t.entries[queries[i]].key, &value));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetFloatByIdx(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_FLOAT);
+    uint32_t i = 0;
+    float value;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getFloatByIdx(&t.table, queries[i], &value));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetStringByKey(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Indexed);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_STRING);
+    uint32_t i = 0;
+    char value[STRING_SIZE];
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getStringByKey(&t.table, t.entries[queries[i]].key, value, sizeof(value)));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetStringByIdx(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_STRING);
+    uint32_t i = 0;
+    char value[STRING_SIZE];
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_getStringByIdx(&t.table, queries[i], value, sizeof(value)));
+        benchmark::DoNotOptimize(value);
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SetByIdx(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_UINT32);
+    uint32_t i = 0;
+    uint32_t value = 0;
+    for(auto _ : state) {
+        // Every write changes the stored value
+        value++;
+        benchmark::DoNotOptimize(config_setByIdx(&t.table, queries[i], &value, sizeof(value)));
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ParseKVStr(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Indexed);
+    const std::vector<uint32_t> queries = t.queries(CONFIG_UINT32);
+    std::vector<std::string> lines(QUERY_COUNT);
+    size_t bytes = 0;
+    for(uint32_t i = 0; i < QUERY_COUNT; i++) {
+        lines[i] = std::string(t.entries[queries[i]].key) + ": " + std::to_string(i * 7919u);
+        bytes += lines[i].size();
+    }
+    char line[FILE_MAX_LINE_LEN];
+    uint32_t i = 0;
+    for(auto _ : state) {
+        // The line is modified while parsing
+        const uint32_t len = lines[i].size() + 1;
+        memcpy(line, lines[i].c_str(), len);
+        benchmark::DoNotOptimize(config_parseKVStr(&t.table, line, len));
+        i = (i + 1) % QUERY_COUNT;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * bytes / QUERY_COUNT);
+}
+
+long fileSize(const char* filename) {
+    FILE* file_ptr = fopen(filename, "rb");
+    if(file_ptr == nullptr) return 0;
+    fseek(file_ptr, 0, SEEK_END);
+    const long size = ftell(file_ptr);
+    fclose(file_ptr);
+    return size;
+}
+
+void BM_LoadFromFile(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Indexed);
+    constexpr char filename[] = "bench_table_load.txt";
+    config_saveToFile(&t.table, filename);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_loadFromFile(&t.table, filename));
+    }
+    state.SetItemsProcessed(state.iterations() * t.table.count);
+    state.SetBytesProcessed(state.iterations() * fileSize(filename));
+    remove(filename);
+}
+
+// Startup of a service with one config file per module, loaded with the given number of threads
+void BM_ParallelLoad(benchmark::State& state) {
+    constexpr uint32_t module_count = 32;
+    constexpr uint32_t entry_count = 1000;
+    std::vector<std::unique_ptr<BenchTable>> tables;
+    std::vector<std::string> filenames;
+    std::vector<ConfigParallelJob_t> jobs;
+    for(uint32_t i = 0; i < module_count; i++) {
+        tables.push_back(std::make_unique<BenchTable>(entry_count, Lookup::Indexed));
+        filenames.push_back("bench_module_" + std::to_string(i) + ".txt");
+    }
+    for(uint32_t i = 0; i < module_count; i++) jobs.push_back({&tables[i]->table, filenames[i].c_str(), CFG_RC_ERROR});
+    config_parallelSave(jobs.data(), module_count, module_count);
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_parallelLoad(jobs.data(), module_count, state.range(0)));
+    }
+    state.SetItemsProcessed(state.iterations() * module_count * entry_count);
+    for(const std::string& filename : filenames) remove(filename.c_str());
+}
+
+void BM_SaveToFile(benchmark::State& state) {
+    BenchTable t(state.range(0), Lookup::Linear);
+    constexpr char filename[] = "bench_table_save.txt";
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config_saveToFile(&t.table, filename));
+    }
+    state.SetItemsProcessed(state.iterations() * t.table.count);
+    state.SetBytesProcessed(state.iterations() * fileSize(filename));
+    remove(filename);
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_GetIdxFromKey, linear, Lookup::Linear)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK_CAPTURE(BM_GetIdxFromKey, sorted, Lookup::Sorted)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK_CAPTURE(BM_GetIdxFromKey, indexed, Lookup::Indexed)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK_CAPTURE(BM_GetIdxFromKeyMiss, linear, Lookup::Linear)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK_CAPTURE(BM_GetIdxFromKeyMiss, sorted, Lookup::Sorted)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK_CAPTURE(BM_GetIdxFromKeyMiss, indexed, Lookup::Indexed)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_TrieGetIdx)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_TrieGetPrefix)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_PrefixScan)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_GetUint32ByKey)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_GetUint32ByIdx)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_GetFloatByKey)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_GetFloatByIdx)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_GetStringByKey)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_GetStringByIdx)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_SetByIdx)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_ParseKVStr)->RangeMultiplier(10)->Range(10, 100000);
+// File I/O includes waiting for the storage device, which does not count as CPU time
+BENCHMARK(BM_LoadFromFile)->RangeMultiplier(10)->Range(10, 100000)->UseRealTime();
+BENCHMARK(BM_SaveToFile)->RangeMultiplier(10)->Range(10, 100000)->UseRealTime();
+BENCHMARK(BM_ParallelLoad)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+#include "config_table.h"
+#include "config_tokenizer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+// Indexed table of uint32 entries with dotted keys and the matching text representation.
+// The index keeps key lookups from dominating the measured parsing time
+struct TextTable {
+    std::vector<uint32_t> values;
+    std::vector<std::string> keys;
+    std::vector<ConfigEntry_t> entries;
+    std::vector<ConfigIndexSlot_t> slots;
+    ConfigIndex_t index{};
+    ConfigTable_t table{};
+    std::string text;
+
+    explicit TextTable(uint32_t count)
+        : values(count), keys(count), entries(count), slots(CFG_INDEX_SLOT_COUNT(count)) {
+        for(uint32_t i = 0; i < count; i++) {
+            keys[i] = "cfg.module" + std::to_string(i / 16) + ".setting" + std::to_string(i % 16);
+            entries[i] = {keys[i].c_str(), CONFIG_UINT32, &values[i], sizeof(uint32_t)};
+            text += keys[i] + ": " + std::to_string(i * 7919u) + "\n";
+        }
+        table.entries = entries.data();
+        table.count = count;
+        index.slots = slots.data();
+        index.slot_count = slots.size();
+        config_buildIndex(&table, &index);
+    }
+};
+
+void BM_Tokenize(benchmark::State& state) {
+    TextTable t(state.range(0));
+    ConfigKVSpan_t spans[64];
+    for(auto _ : state) {
+        ConfigTokenizer_t tokenizer;
+        config_tokenizerInit(&tokenizer, t.text.data(), t.text.size());
+        uint32_t count = 0;
+        while(config_tokenizerNext(&tokenizer, spans, 64, &count) == CFG_RC_ERROR_INCOMPLETE) {
+            benchmark::DoNotOptimize(spans);
+        }
+        benchmark::DoNotOptimize(spans);
+    }
+    state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+
+// Previous path: split into lines, strlen and config_parseKVStr for every line
+void BM_ParsePerLine(benchmark::State& state) {
+    TextTable t(state.range(0));
+    std::vector<char> buf(t.text.size() + 1);
+    for(auto _ : state) {
+        memcpy(buf.data(), t.text.data(), t.text.size() + 1);
+        char* line = buf.data();
+        while(*line != '\0') {
+            char* line_end = strchr(line, '\n');
+            *line_end = '\0';
+            config_parseKVStr(&t.table, line, strlen(line) + 1);
+            line = line_end + 1;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+
+void BM_ParseBuffer(benchmark::State& state) {
+    TextTable t(state.range(0));
+    std::vector<char> buf(t.text.size() + 1);
+    for(auto _ : state) {
+        memcpy(buf.data(), t.text.data(), t.text.size());
+        config_parseBuffer(&t.table, buf.data(), t.text.size(), nullptr, nullptr);
+    }
+    state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+
+void writeFile(const char* filename, const std::string& text) {
+    FILE* file_ptr = fopen(filename, "w");
+    fwrite(text.data(), 1, text.size(), file_ptr);
+    fclose(file_ptr);
+}
+
+void BM_LoadDefault(benchmark::State& state) {
+    TextTable t(state.range(0));
+    constexpr char filename[] = "bench_tokenizer_default.txt";
+    writeFile(filename, t.text);
+    for(auto _ : state) {
+        config_loadFromFile(&t.table, filename);
+    }
+    state.SetBytesProcessed(state.iterations() * t.text.size());
+    remove(filename);
+}
+
+void BM_LoadBuffered(benchmark::State& state) {
+    TextTable t(state.range(0));
+    constexpr char filename[] = "bench_tokenizer_buffered.txt";
+    writeFile(filename, t.text);
+    for(auto _ : state) {
+        config_loadFromFileBuffered(&t.table, filename, nullptr, nullptr);
+    }
+    state.SetBytesProcessed(state.iterations() * t.text.size());
+    remove(filename);
+}
+}  // namespace
+
+BENCHMARK(BM_Tokenize)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_ParsePerLine)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_ParseBuffer)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_LoadDefault)->RangeMultiplier(10)->Range(10, 100000);
+BENCHMARK(BM_LoadBuffered)->RangeMultiplier(10)->Range(10, 100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,48 @@
+#include <cstdint>
+#include <iostream>
+
+#include "config_table.hpp"
+
+// File where configuration changes are stored
+#define CONFIG_FILE "example_cfg_file.cfg"
+
+// Same configuration structure as in example_with_config_struct.cpp
+struct Configuration {
+    struct {
+        char ssid[128] = "";
+        char password[128] = "";
+    } wifi;
+    uint32_t baud_rate = 9600;
+    uint32_t execution_counter = 0;
+};
+Configuration cfg;
+
+// The schema is built at compile time. Type and size of every entry are derived from the
+// struct members and a duplicate key would fail the compilation
+inline constexpr auto schema = cfgtable::makeSchema(
+    CFG_TABLE_ENTRY(cfg.wifi.ssid),
+    CFG_TABLE_ENTRY_PERM(cfg.wifi.password, CFG_PERM_SECRET_RW),
+    CFG_TABLE_ENTRY(cfg.baud_rate),
+    CFG_TABLE_ENTRY(cfg.execution_counter)
+);
+
+// The table itself needs a mutable copy of the entries
+auto config_entries = schema.entries;
+ConfigTable_t config_table = cfgtable::makeTable(config_entries);
+
+int main() {
+    config_loadFromFile(&config_table, CONFIG_FILE);
+    // Keys are resolved to constant indices at compile time, no string comparison happens at runtime
+    constexpr uint32_t baud_rate_idx = CFG_KEY_IDX_TYPED(schema, "cfg.baud_rate", CONFIG_UINT32);
+    uint32_t baud_rate = 0;
+    config_getUint32ByIdx(&config_table, baud_rate_idx, &baud_rate);
+    std::cout << "cfg.baud_rate: " << baud_rate << std::endl;
+
+    uint32_t counter = 0;
+    config_getUint32ByIdx(&config_table, CFG_KEY_IDX(schema, "cfg.execution_counter"), &counter);
+    counter++;
+    config_setByIdx(&config_table, CFG_KEY_IDX(schema, "cfg.execution_counter"), &counter, sizeof(counter));
+    std::cout << "cfg.execution_counter: " << counter << std::endl;
+    config_saveToFile(&config_table, CONFIG_FILE);
+    return 0;
+}
@@ -0,0 +1,112 @@
+#ifndef CONFIG_BINARY_H
+#define CONFIG_BINARY_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Binary snapshot format
+ * ===================================================================
+ * Alternative to the "key: value" text format which does not need any parsing.
+ * Pass config_binarySaveFunc and config_binaryLoadFunc to config_setSaveLoadFunctions to use it
+ * for config_saveToFile and config_loadFromFile. Passing NULL switches back to the text format,
+ * which stays available for humans through config_formatTable and config_loadFromFileBuffered as well.
+ *
+ * Layout, header fields in little endian:
+ *   0  magic "CFGB"
+ *   4  uint16 format version
+ *   6  uint16 byte order mark, 0x0102 in the byte order of the writer
+ *   8  uint32 schema fingerprint, see config_binaryFingerprint
+ *  12  uint32 number of entries
+ *  16  uint32 size of the schema section
+ *  20  uint32 size of the value section
+ *  24  uint32 CRC-32 over the header fields above and both sections
+ *  28  schema section: per entry uint8 type, uint32 size and the null-terminated key
+ *      value section: the raw values of all entries in table order
+ *
+ * Values are stored in the byte order of the writer, so files can only be loaded on
+ * machines with the same byte order.
+ */
+
+// Current version of the binary format
+#define CFG_BINARY_VERSION (1)
+// Size of the file header in bytes
+#define CFG_BINARY_HEADER_SIZE (28)
+
+/**
+ * Returns a fingerprint over the keys, types and sizes of all saved entries.
+ * Tables with the same fingerprint have the same value layout.
+ * @param cfg [IN] Configuration table
+ * @return fingerprint or 0 if cfg is NULL
+ */
+uint32_t config_binaryFingerprint(const ConfigTable_t* cfg);
+
+/**
+ * Returns the size of the binary snapshot of the table in bytes
+ * @param cfg [IN] Configuration table
+ * @return size in bytes or 0 if cfg is NULL
+ */
+uint32_t config_binaryGetSize(const ConfigTable_t* cfg);
+
+/**
+ * Writes the binary snapshot of the table into a buffer
+ * @param cfg [IN] Configuration table
+ * @param buf [OUT] Output buffer
+ * @param buf_size [IN] Size of buf. Use config_binaryGetSize to get a sufficient size
+ * @param len [OUT] Number of bytes written
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, buf or len are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if buf is too small
+ */
+CfgRet_t config_binaryFormat(const ConfigTable_t* cfg, uint8_t* buf, uint32_t buf_size, uint32_t* len);
+
+/**
+ * Loads a binary snapshot from a buffer.
+ * If the fingerprint matches the table, all values are copied in table order without any key lookup.
+ * Otherwise every stored entry is matched to the table by key. Strings may change their size
+ * as long as the stored string fits, other entries are skipped if type or size differ.
+ * Read-only entries are skipped in both cases.
+ * @param cfg [INOUT] Configuration table
+ * @param buf [IN] Snapshot
+ * @param len [IN] Size of the snapshot in bytes
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or buf are NULL
+ * @return CFG_RC_ERROR_FORMAT if buf does not contain a valid snapshot of a supported version and byte order
+ * @return CFG_RC_ERROR_INVALID if the checksum does not match. No value has been changed in that case
+ * @return CFG_RC_ERROR_INCOMPLETE if any stored entry could not be matched to the table.
+ *  Other entries have still been loaded.
+ */
+CfgRet_t config_binaryParse(ConfigTable_t* cfg, const uint8_t* buf, uint32_t len);
+
+/**
+ * Save function writing the binary snapshot with a single write call.
+ * Can be passed to config_setSaveLoadFunctions.
+ * @param cfg [IN] Configuration table
+ * @param filename [IN] Name of the file where config entries should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or filename are NULL
+ * @return CFG_RC_ERROR if the file could not be opened or written
+ * @return CFG_RC_ERROR_TOO_LARGE if the buffer for the file contents could not be allocated
+ */
+CfgRet_t config_binarySaveFunc(const ConfigTable_t* cfg, const char* filename);
+
+/**
+ * Load function reading a binary snapshot with a single read call.
+ * Can be passed to config_setSaveLoadFunctions.
+ * @param cfg [INOUT] Configuration table
+ * @param filename [IN] Name of the file to read for config values
+ * @return CFG_RC_ERROR if the file could not be opened or read
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the file contents could be allocated
+ * @return any return value of config_binaryParse
+ */
+CfgRet_t config_binaryLoadFunc(ConfigTable_t* cfg, const char* filename);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_BINARY_H
@@ -0,0 +1,174 @@
+#ifndef CONFIG_LAYER_H
+#define CONFIG_LAYER_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifndef CFG_LAYER_MAX_COUNT
+    // Maximum number of layers of a stack. At most 256, the source layer of an entry is stored in 8 bits
+    #define CFG_LAYER_MAX_COUNT (16)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Layered configuration
+ * ===================================================================
+ * A stack of layers over one table, e.g. compiled defaults, a site file, a device file and runtime overrides.
+ * Every layer holds its own copy of the values it sets. Layer 0 holds the defaults and sets every entry,
+ * higher layers override lower ones. The table itself always contains the effective value of every entry,
+ * so reads are plain getter calls, and the layer the value came from is recorded per entry.
+ *
+ * Changing a layer only updates the entries it affects. Effective values are written with config_setByIdx,
+ * so dirty tracking, the change log and notifications work as usual. Write values through the layers
+ * instead of directly to the table, otherwise they are replaced by the next change of a layer.
+ * Read-only entries keep their default value.
+ *
+ * All storage is provided by the user. The layer functions must not be called concurrently.
+ * The stack refers to entries by index. Changes which invalidate handles, e.g. config_sortTable, are
+ * detected and make all layer functions fail until the stack is initialized again with config_layerInit,
+ * which takes the current values as the new defaults.
+ */
+
+typedef struct {
+    // Optional name for diagnostics, e.g. "defaults" or "site"
+    const char* name;
+    // User-provided storage with config_layerValueSize bytes, aligned to 8 bytes
+    void* values;
+    // User-provided bitmap with CFG_DIRTY_WORD_COUNT(count) words. A set bit marks an entry set by this layer
+    uint32_t* present;
+} ConfigLayer_t;
+
+typedef struct {
+    // User-provided storage: layers with the lowest priority first
+    ConfigLayer_t* layers;
+    uint32_t layer_count;
+    // User-provided storage: one element per entry each
+    uint32_t* offsets;
+    uint8_t* sources;
+
+    // Managed by the config_layer* functions
+    ConfigTable_t* cfg;
+    uint32_t generation;
+} ConfigLayers_t;
+
+/**
+ * Returns the number of bytes of value storage needed by every layer of the table
+ * @param cfg [IN] Configuration table
+ * @return storage size in bytes or 0 if cfg is NULL
+ */
+uint32_t config_layerValueSize(const ConfigTable_t* cfg);
+
+/**
+ * Initializes the layers of a table. The current values of the table become the defaults in layer 0,
+ * all other layers are empty
+ * @param layers [INOUT] Layer stack with user-provided storage
+ * @param cfg [INOUT] Configuration table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if layers, cfg or any storage are NULL
+ * @return CFG_RC_ERROR_INVALID if there are no layers
+ * @return CFG_RC_ERROR_TOO_LARGE if there are more than CFG_LAYER_MAX_COUNT layers
+ */
+CfgRet_t config_layerInit(ConfigLayers_t* layers, ConfigTable_t* cfg);
+
+/**
+ * Sets the value of an entry in a layer and updates the effective value if no higher layer sets the entry
+ * @param layers [INOUT] Initialized layer stack
+ * @param layer [IN] Index of the layer
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [IN] New value
+ * @param size [IN] Size of the value in bytes
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if layers or value are NULL or the layers are not initialized
+ * @return CFG_RC_ERROR_RANGE if the layer or the entry does not exist
+ * @return CFG_RC_ERROR_TOO_LARGE if the value is larger than the entry
+ * @return CFG_RC_ERROR_READ_ONLY if the entry is read-only
+ * @return CFG_RC_ERROR_INVALID if the table has been sorted since config_layerInit
+ */
+CfgRet_t config_layerSet(ConfigLayers_t* layers, uint32_t layer, uint32_t idx, const void* value, uint32_t size);
+
+/**
+ * Removes an entry from a layer, so the next lower layer setting it provides the effective value
+ * @param layers [INOUT] Initialized layer stack
+ * @param layer [IN] Index of the layer, at least 1
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return CFG_RC_SUCCESS on success, also if the layer did not set the entry
+ * @return CFG_RC_ERROR_NULLPTR if layers is NULL or the layers are not initialized
+ * @return CFG_RC_ERROR_RANGE if the layer or the entry does not exist
+ * @return CFG_RC_ERROR_INVALID for layer 0, the defaults cannot be removed, or if the table has been sorted
+ *         since config_layerInit
+ */
+CfgRet_t config_layerUnset(ConfigLayers_t* layers, uint32_t layer, uint32_t idx);
+
+/**
+ * Removes all entries from a layer. Changed effective values are notified as one batch
+ * @param layers [INOUT] Initialized layer stack
+ * @param layer [IN] Index of the layer, at least 1
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if layers is NULL or the layers are not initialized
+ * @return CFG_RC_ERROR_RANGE if the layer does not exist
+ * @return CFG_RC_ERROR_INVALID for layer 0 or if the table has been sorted since config_layerInit
+ */
+CfgRet_t config_layerClear(ConfigLayers_t* layers, uint32_t layer);
+
+/**
+ * Parses "key: value" lines into a layer, like config_parseBuffer does for the table.
+ * Entries not contained in the buffer keep their state in the layer.
+ * Changed effective values are notified as one batch
+ * @param layers [INOUT] Initialized layer stack
+ * @param layer [IN] Index of the layer
+ * @param buf [INOUT] Buffer with the lines to parse. Must provide space for one additional character at buf[len]
+ * @param len [IN] Number of characters in buf
+ * @param on_error [IN] Function called for every line that could not be parsed. May be NULL
+ * @param ctx [IN] User context passed to on_error
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if layers or buf are NULL or the layers are not initialized
+ * @return CFG_RC_ERROR_RANGE if the layer does not exist
+ * @return CFG_RC_ERROR_INVALID if the table has been sorted since config_layerInit
+ * @return CFG_RC_ERROR_INCOMPLETE if any line could not be parsed. Other lines have still been parsed.
+ */
+CfgRet_t config_layerParseBuffer(ConfigLayers_t* layers, uint32_t layer, char* buf, uint32_t len,
+                                 parseErrorFunc on_error, void* ctx);
+
+/**
+ * Replaces the contents of a layer with the entries of a file in the text format.
+ * Entries which were set by the layer but are missing in the file are removed from it.
+ * Changed effective values are notified as one batch
+ * @param layers [INOUT] Initialized layer stack
+ * @param layer [IN] Index of the layer, at least 1
+ * @param filename [IN] Name of the file to read
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if layers or filename are NULL or the layers are not initialized
+ * @return CFG_RC_ERROR_RANGE if the layer does not exist
+ * @return CFG_RC_ERROR_INVALID for layer 0 or if the table has been sorted since config_layerInit
+ * @return CFG_RC_ERROR if the file could not be read. The layer is unchanged
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the file contents could be allocated
+ * @return CFG_RC_ERROR_INCOMPLETE if any line could not be parsed. Other lines have still been parsed.
+ */
+CfgRet_t config_layerLoadFromFile(ConfigLayers_t* layers, uint32_t layer, const char* filename);
+
+/**
+ * Returns the layer which provides the effective value of an entry
+ * @param layers [IN] Initialized layer stack
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return index of the highest layer setting the entry or -1 if the entry or the layers do not exist or
+ *         the table has been sorted since config_layerInit
+ */
+int32_t config_layerGetSource(const ConfigLayers_t* layers, uint32_t idx);
+
+/**
+ * Returns true if the layer sets the entry
+ * @param layers [IN] Initialized layer stack
+ * @param layer [IN] Index of the layer
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return true if the layer sets the entry, false otherwise or on invalid arguments
+ */
+bool config_layerIsSet(const ConfigLayers_t* layers, uint32_t layer, uint32_t idx);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_LAYER_H
@@ -0,0 +1,176 @@
+#ifndef CONFIG_LOG_H
+#define CONFIG_LOG_H
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "config_table.h"
+
+#ifndef CFG_LOG_FSYNC
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CFG_LOG_FSYNC (1)
+    #else
+        // Without fsync, compaction only flushes the new snapshot to the operating system
+        #define CFG_LOG_FSYNC (0)
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Append-only change log persistence
+ * ===================================================================
+ * The configuration is stored as a snapshot file and a log file, both in the
+ * "key: value" text format. While a log is attached to a table, every write which
+ * changes a value appends the line of that entry to the log, so a single update
+ * costs one small write instead of rewriting the whole table.
+ * On open, the snapshot is loaded and the log is replayed on top of it.
+ * Once the log exceeds the compaction threshold, the table is written to a new
+ * snapshot and the log is truncated.
+ *
+ * By default, the setter crossing the threshold writes the snapshot itself. To keep the setters at
+ * O(1) I/O, set request_compaction to a function which signals a background task. The setter then
+ * only continues the log in a new file, keeps the current one as "<log_filename>.old" and calls
+ * request_compaction. The background task calls config_logCompactPrevious, which writes the snapshot
+ * and removes the old file while the setters keep appending to the new one.
+ *
+ * Both files are read and written with the C standard library, independent of the
+ * load and save functions of the table. Lines of any length are supported.
+ */
+
+/**
+ * Function pointer definition for requesting a background compaction
+ * @param ctx [IN] request_ctx of the log
+ */
+typedef void (*configLogRequestFunc)(void* ctx);
+
+typedef struct ConfigLog {
+    // File holding the complete table as of the last compaction
+    const char* snapshot_filename;
+    // File the changed entries are appended to
+    const char* log_filename;
+    // Log size in bytes at which the log is compacted into a new snapshot
+    uint32_t compaction_threshold;
+    // Optional, called instead of compacting inside the setters. Has to make a background task call
+    // config_logCompactPrevious and must not block. Set these after config_logOpen
+    configLogRequestFunc request_compaction;
+    void* request_ctx;
+    // Open log file, managed by the config_log* functions
+    FILE* file;
+    // Current size of the log file in bytes
+    uint32_t size;
+    // Log size at which the next compaction is started. Grows by the threshold after a failed compaction
+    uint32_t next_compaction;
+    // Set while "<log_filename>.old" waits for config_logCompactPrevious. Accessed atomically
+    bool compaction_pending;
+} ConfigLog_t;
+
+/**
+ * Loads the snapshot, replays the log on top of it and attaches the log to the table.
+ * A log which is already attached to the table is closed first.
+ * A previous log file left by an interrupted background compaction is replayed before the log
+ * and compacted right away. Missing files are treated as empty. Files which exist but cannot be read fail the open, so a later
+ * compaction does not replace a snapshot which was not loaded. An incomplete last record left by an interrupted
+ * write is dropped and the log is compacted right away, so new records start on a fresh line.
+ * @param cfg [INOUT] Configuration table
+ * @param log [OUT] Log state. Has to stay valid until config_logClose is called
+ * @param snapshot_filename [IN] Name of the snapshot file
+ * @param log_filename [IN] Name of the log file
+ * @param compaction_threshold [IN] Log size in bytes at which the log is compacted
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if any parameter is NULL
+ * @return CFG_RC_ERROR if the snapshot or the log exist but could not be read. The log is not attached
+ * @return CFG_RC_ERROR if the log file could not be opened for writing
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the file contents could be allocated
+ * @return CFG_RC_ERROR_INCOMPLETE if any line of the snapshot or log could not be parsed.
+ *  The log is attached anyway
+ */
+CfgRet_t config_logOpen(ConfigTable_t* cfg, ConfigLog_t* log, const char* snapshot_filename, const char* log_filename,
+                        uint32_t compaction_threshold);
+
+/**
+ * Appends the current value of an entry to the attached log.
+ * Called by the setter functions for every write which changes a value, so
+ * calling this directly is only necessary after writing to a value variable directly.
+ * @note The record is flushed to the operating system but not synced to the storage device
+ * @param cfg [IN] Configuration table with attached log
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL or has no log attached
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ * @return CFG_RC_ERROR if the record could not be written
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the record could be allocated
+ * @return any error of config_logCompact if the log was compacted. The record has been written in that case
+ *  and the compaction is attempted again once the log has grown by another threshold
+ */
+CfgRet_t config_logAppend(ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Appends the current values of several entries to the attached log with a single write
+ * @param cfg [IN] Configuration table with attached log
+ * @param indices [IN] Indices of the configuration entries in the config table
+ * @param count [IN] Number of elements in indices
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or indices are NULL or cfg has no log attached
+ * @return CFG_RC_ERROR_RANGE if any index is larger than the number of entries in the configuration table.
+ *  Nothing has been written in that case
+ * @return CFG_RC_ERROR if the records could not be written
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the records could be allocated
+ * @return any error of config_logCompact if the log was compacted. The records have been written in that case
+ */
+CfgRet_t config_logAppendEntries(ConfigTable_t* cfg, const uint32_t* indices, uint32_t count);
+
+/**
+ * Returns true if the log has reached the size for the next compaction or a previous log file waits
+ * for config_logCompactPrevious
+ * @param log [IN] Log state
+ */
+bool config_logNeedsCompaction(const ConfigLog_t* log);
+
+/**
+ * Writes the whole table to a new snapshot and truncates the log.
+ * The snapshot is first written to "<snapshot_filename>.tmp", synced to the storage device with
+ * fsync if CFG_LOG_FSYNC is set and then renamed. The log is only truncated once the rename has been
+ * synced as well, so an interrupted compaction leaves either the old snapshot and the log or the
+ * new snapshot behind. A previous log file is removed as well.
+ * Call this from the thread writing the table, not while config_logCompactPrevious is running
+ * @param cfg [IN] Configuration table with attached log
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL or has no log attached
+ * @return CFG_RC_ERROR if the snapshot could not be written or replaced. The log is kept in that case
+ * @return CFG_RC_ERROR if the log could not be truncated
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the snapshot could be allocated
+ */
+CfgRet_t config_logCompact(ConfigTable_t* cfg);
+
+/**
+ * Writes the whole table to a new snapshot like config_logCompact and removes the previous log file
+ * started by the last compaction request. Does nothing if no previous log file waits for compaction.
+ * Meant for the background task signaled by request_compaction: the setters keep appending to the
+ * current log meanwhile. Values are read with the same guarantees as the getters, so concurrent writes
+ * require CFG_THREAD_SAFE. Wait for this function to return before calling config_logClose
+ * @param cfg [IN] Configuration table with attached log
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL or has no log attached
+ * @return CFG_RC_ERROR if the snapshot could not be written or replaced or the previous log could not be
+ *  removed. The previous log is kept and the next request retries the compaction
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the snapshot could be allocated
+ */
+CfgRet_t config_logCompactPrevious(const ConfigTable_t* cfg);
+
+/**
+ * Closes the log file and detaches the log from the table
+ * @param cfg [INOUT] Configuration table with attached log
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL or has no log attached
+ * @return CFG_RC_ERROR if the log file could not be closed properly
+ */
+CfgRet_t config_logClose(ConfigTable_t* cfg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_LOG_H
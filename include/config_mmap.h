@@ -0,0 +1,122 @@
+#ifndef CONFIG_MMAP_H
+#define CONFIG_MMAP_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Memory-mapped persistent tables
+ * ===================================================================
+ * The values of all entries are moved into a memory-mapped file. Every write through the
+ * setter functions then goes directly to the page cache and is persisted by the operating
+ * system without any save call. Opening an existing file only maps it, nothing is parsed.
+ *
+ * While the table is mapped, the value pointers of the entries refer to the mapping instead of
+ * the original variables. Access values through the table functions or call config_mmapClose
+ * to copy the final values back to the original variables.
+ *
+ * Layout: ConfigMmapHeader_t, followed by the schema section with one record per entry
+ * (uint8 type, uint32 size, uint32 value offset, null-terminated key) and the value section.
+ * Every value starts at a multiple of CFG_MMAP_ALIGNMENT. All fields use the byte order of the machine.
+ */
+
+#ifndef CFG_MMAP_SUPPORTED
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CFG_MMAP_SUPPORTED (1)
+    #else
+        // Without mmap, all functions return CFG_RC_ERROR_INVALID
+        #define CFG_MMAP_SUPPORTED (0)
+    #endif
+#endif
+
+// Current version of the mapped file layout
+#define CFG_MMAP_VERSION (1)
+// Alignment of every value in the file
+#define CFG_MMAP_ALIGNMENT (8)
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    // 0x0102 in the byte order of the writer
+    uint16_t byte_order_mark;
+    // Fingerprint over keys, types and sizes, see config_binaryFingerprint
+    uint32_t fingerprint;
+    uint32_t entry_count;
+    uint32_t schema_size;
+    // Offset of the value section from the start of the file
+    uint32_t values_offset;
+    uint32_t values_size;
+    uint32_t reserved;
+} ConfigMmapHeader_t;
+
+typedef struct {
+    // Value pointer of the entry before mapping, restored by config_mmapClose
+    void* original;
+    // Value of the entry in the mapping
+    uint8_t* mapped;
+} ConfigMmapValue_t;
+
+typedef struct {
+    ConfigTable_t* cfg;
+    uint8_t* base;
+    uint32_t size;
+    int fd;
+    // One element per mapped entry, ordered by the address in the mapping.
+    // Entries are matched by their value pointer, so sorting the table while mapped is fine
+    ConfigMmapValue_t* values;
+    uint32_t value_count;
+} ConfigMmap_t;
+
+/**
+ * Maps the file and moves the values of the table into it.
+ * If the file does not exist or is empty, it is created with the current values of the table.
+ * If the file was written for a different table definition, values are migrated by key:
+ * entries with the same key and type keep their value, strings also if the stored string
+ * still fits. The file with the new layout is written to "<filename>.tmp", synced and renamed
+ * over the old file, so the old file stays intact until the new one is complete.
+ * Read-only entries always keep the value of the table definition.
+ * @param cfg [INOUT] Configuration table. The value pointers of the entries are changed
+ * @param map [OUT] Mapping state. Has to stay valid until config_mmapClose is called
+ * @param filename [IN] Name of the mapped file
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if any parameter is NULL
+ * @return CFG_RC_ERROR if the file could not be opened, resized or mapped
+ * @return CFG_RC_ERROR_FORMAT if the file exists but is not a mapped table file. It is left untouched
+ * @return CFG_RC_ERROR_TOO_LARGE if no memory for the original value pointers or the temporary file name
+ *  could be allocated
+ * @return CFG_RC_ERROR_INCOMPLETE if any entry of a migrated file could not be matched to the table.
+ *  The table is mapped anyway
+ * @return CFG_RC_ERROR_INVALID if memory-mapped files are not supported on this platform
+ */
+CfgRet_t config_mmapOpen(ConfigTable_t* cfg, ConfigMmap_t* map, const char* filename);
+
+/**
+ * Writes all modified pages of the mapping to the storage device and waits for completion
+ * @param map [IN] Mapping state
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if map is NULL or not mapped
+ * @return CFG_RC_ERROR if syncing failed
+ * @return CFG_RC_ERROR_INVALID if memory-mapped files are not supported on this platform
+ */
+CfgRet_t config_mmapFlush(ConfigMmap_t* map);
+
+/**
+ * Flushes and unmaps the file. The current values are copied back to the original
+ * variables and the value pointers of the entries are restored
+ * @param map [INOUT] Mapping state
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if map is NULL or not mapped
+ * @return CFG_RC_ERROR if syncing or unmapping failed. The table is restored anyway
+ * @return CFG_RC_ERROR_INVALID if memory-mapped files are not supported on this platform
+ */
+CfgRet_t config_mmapClose(ConfigMmap_t* map);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_MMAP_H
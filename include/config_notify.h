@@ -0,0 +1,180 @@
+#ifndef CONFIG_NOTIFY_H
+#define CONFIG_NOTIFY_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Change notifications
+ * ===================================================================
+ * While a notifier is attached, every write which changes a value marks the entry as pending.
+ * config_notifyDispatch delivers all pending entries in one batch: every subscription is called
+ * at most once with the indices of the changed entries it is interested in.
+ * Writes which leave the value unchanged do not notify.
+ *
+ * Dispatching happens either inline, right after the setter returns, or explicitly, e.g. from a
+ * worker thread woken through the wake function. Loading a file opens a batch, so all lines of
+ * the file are delivered together once loading has finished.
+ *
+ * All storage is provided by the user. Callbacks may set values, the resulting changes are
+ * delivered by the next dispatch.
+ *
+ * Pending notifications refer to entry indices. config_sortTable therefore delivers them on the calling
+ * thread before it reorders the entries, and entry subscriptions follow their entry to its new index.
+ */
+
+/**
+ * Function pointer definition for change callbacks
+ * @param ctx [IN] User context given when subscribing
+ * @param cfg [IN] Configuration table
+ * @param changed [IN] Indices of the changed entries matching the subscription, in ascending order
+ * @param changed_count [IN] Number of elements in changed, at least 1
+ */
+typedef void (*configChangeFunc)(void* ctx, const ConfigTable_t* cfg, const uint32_t* changed, uint32_t changed_count);
+
+/**
+ * Function pointer definition for waking a dispatching thread. Called by the writing thread
+ * whenever a new notification becomes pending outside of a batch
+ * @param ctx [IN] User context of the notifier
+ */
+typedef void (*configWakeFunc)(void* ctx);
+
+typedef enum {
+    CFG_SUBSCRIBE_ENTRY,
+    CFG_SUBSCRIBE_PREFIX,
+    CFG_SUBSCRIBE_TABLE
+} ConfigSubscriptionKind_t;
+
+typedef struct {
+    ConfigSubscriptionKind_t kind;
+    // Entry index and key for CFG_SUBSCRIBE_ENTRY. The key finds the entry again after sorting
+    uint32_t idx;
+    const char* key;
+    // Key prefix for CFG_SUBSCRIBE_PREFIX. Has to stay valid while subscribed
+    const char* prefix;
+    uint32_t prefix_len;
+    configChangeFunc callback;
+    void* ctx;
+} ConfigSubscription_t;
+
+typedef struct ConfigNotifier {
+    // User-provided storage: pending bitmap with CFG_DIRTY_WORD_COUNT(count) words
+    uint32_t* pending;
+    // User-provided storage: two index buffers with one element per entry each
+    uint32_t* changed;
+    uint32_t* matched;
+    // User-provided storage for subscriptions
+    ConfigSubscription_t* subscriptions;
+    uint32_t subscription_capacity;
+    uint32_t subscription_count;
+    // If set, the setters dispatch notifications themselves once no batch is open
+    bool inline_dispatch;
+    // Optional function called when a notification becomes pending and inline_dispatch is not set
+    configWakeFunc wake;
+    void* wake_ctx;
+    // Managed by the config_notify* functions
+    uint32_t batch_depth;
+    bool dispatching;
+} ConfigNotifier_t;
+
+/**
+ * Attaches a notifier to the table. Storage pointers, inline_dispatch and the wake function
+ * have to be set before. Pending notifications and subscriptions are cleared.
+ * To detach the notifier, set the notifier member of the table to NULL.
+ * @param cfg [INOUT] Configuration table
+ * @param notifier [INOUT] Notifier with user-provided storage
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, notifier or any storage pointer is NULL
+ */
+CfgRet_t config_notifyAttach(ConfigTable_t* cfg, ConfigNotifier_t* notifier);
+
+/**
+ * Subscribes to changes of a single entry
+ * @note The entry is resolved to its index. config_sortTable updates the index
+ * @param cfg [INOUT] Configuration table with attached notifier
+ * @param key [IN] Key of the configuration entry
+ * @param callback [IN] Function called with the changed entry
+ * @param ctx [IN] User context passed to the callback
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, key or callback are NULL or no notifier is attached
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if the key does not exist
+ * @return CFG_RC_ERROR_TOO_LARGE if the subscription storage is full
+ */
+CfgRet_t config_subscribeEntry(ConfigTable_t* cfg, const char* key, configChangeFunc callback, void* ctx);
+
+/**
+ * Subscribes to changes of all entries whose key starts with prefix, e.g. "cfg.wifi."
+ * @param cfg [INOUT] Configuration table with attached notifier
+ * @param prefix [IN] Key prefix. Has to stay valid while subscribed
+ * @param callback [IN] Function called with the changed entries
+ * @param ctx [IN] User context passed to the callback
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, prefix or callback are NULL or no notifier is attached
+ * @return CFG_RC_ERROR_TOO_LARGE if the subscription storage is full
+ */
+CfgRet_t config_subscribePrefix(ConfigTable_t* cfg, const char* prefix, configChangeFunc callback, void* ctx);
+
+/**
+ * Subscribes to changes of all entries
+ * @param cfg [INOUT] Configuration table with attached notifier
+ * @param callback [IN] Function called with the changed entries
+ * @param ctx [IN] User context passed to the callback
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or callback are NULL or no notifier is attached
+ * @return CFG_RC_ERROR_TOO_LARGE if the subscription storage is full
+ */
+CfgRet_t config_subscribeTable(ConfigTable_t* cfg, configChangeFunc callback, void* ctx);
+
+/**
+ * Removes all subscriptions with the given callback and context.
+ * May be called from a callback, the removed subscriptions are not called anymore, not even for the running batch
+ * @param cfg [INOUT] Configuration table with attached notifier
+ * @param callback [IN] Subscribed function
+ * @param ctx [IN] User context given when subscribing
+ * @return number of removed subscriptions
+ */
+uint32_t config_unsubscribe(ConfigTable_t* cfg, configChangeFunc callback, void* ctx);
+
+/**
+ * Marks an entry as changed. Called by the setter functions for every write which changes a value,
+ * so calling this directly is only necessary after writing to a value variable directly
+ * @param cfg [INOUT] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ */
+void config_notifyChanged(ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Opens a batch. Notifications are collected until the matching config_notifyEndBatch.
+ * Batches may be nested
+ * @param cfg [INOUT] Configuration table
+ */
+void config_notifyBeginBatch(ConfigTable_t* cfg);
+
+/**
+ * Closes a batch. Closing the outermost batch dispatches inline or wakes the dispatching thread
+ * @param cfg [INOUT] Configuration table
+ */
+void config_notifyEndBatch(ConfigTable_t* cfg);
+
+/**
+ * Returns true if any notification is pending
+ * @param cfg [IN] Configuration table
+ */
+bool config_notifyHasPending(const ConfigTable_t* cfg);
+
+/**
+ * Delivers all pending notifications. Has to be called from one thread at a time
+ * @param cfg [INOUT] Configuration table
+ * @return number of changed entries which have been delivered
+ */
+uint32_t config_notifyDispatch(ConfigTable_t* cfg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_NOTIFY_H
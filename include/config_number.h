@@ -0,0 +1,124 @@
+#ifndef CONFIG_NUMBER_H
+#define CONFIG_NUMBER_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Locale-independent number formatting without printf
+ * ===================================================================
+ * All functions write the text representation without a null-terminator
+ * and return the number of characters written. The buffer has to provide
+ * at least the number of characters given by the matching *_MAX_LEN define.
+ */
+
+// Maximum number of characters written by config_formatUint32
+#define CFG_UINT32_MAX_LEN (10)
+// Maximum number of characters written by config_formatInt32
+#define CFG_INT32_MAX_LEN (11)
+// Maximum number of characters written by config_formatUint64
+#define CFG_UINT64_MAX_LEN (20)
+// Maximum number of characters written by config_formatInt64
+#define CFG_INT64_MAX_LEN (20)
+// Maximum number of characters written by config_formatFloat, e.g. "-0.0000123456789"
+#define CFG_FLOAT_MAX_LEN (16)
+// Maximum number of characters written by config_formatDouble, e.g. "-0.000012345678901234567"
+#define CFG_DOUBLE_MAX_LEN (24)
+
+uint32_t config_formatUint32(char* buf, uint32_t value);
+uint32_t config_formatInt32(char* buf, int32_t value);
+uint32_t config_formatUint64(char* buf, uint64_t value);
+uint32_t config_formatInt64(char* buf, int64_t value);
+
+/**
+ * Writes the shortest decimal representation of value which parses back to exactly the same float.
+ * Magnitudes from 1e-5 up to 1e9 are written without exponent, e.g. "0.1" or "1500",
+ * all others in scientific notation, e.g. "1e-7" or "3.4028235e38". Infinity and NaN are written
+ * as "inf", "-inf" and "nan".
+ * @param buf [OUT] Buffer of at least CFG_FLOAT_MAX_LEN characters
+ * @param value [IN] Value to format
+ * @return number of characters written
+ */
+uint32_t config_formatFloat(char* buf, float value);
+
+/**
+ * Writes the shortest decimal representation of value which parses back to exactly the same double.
+ * Uses the same notation as config_formatFloat
+ * @param buf [OUT] Buffer of at least CFG_DOUBLE_MAX_LEN characters
+ * @param value [IN] Value to format
+ * @return number of characters written
+ */
+uint32_t config_formatDouble(char* buf, double value);
+
+/**
+ * Locale-independent number parsing without errno
+ * ===================================================================
+ * All functions parse the number at the start of the first len characters of str,
+ * which does not need to be null-terminated. No whitespace is skipped.
+ *
+ * Integers have an optional sign followed by decimal digits, or hexadecimal digits
+ * after "0x" or binary digits after "0b". The magnitude is checked against the
+ * destination type, so e.g. "-1" is out of range for unsigned types.
+ *
+ * Floating point numbers have an optional sign, decimal digits with an optional
+ * fraction and an optional exponent, e.g. "-1.5e-3", or are one of "inf" and "nan".
+ * They are rounded correctly to the nearest value of the destination type.
+ * Magnitudes too small for the destination type become 0, too large ones are out of range.
+ *
+ * If consumed is NULL, the number has to span all len characters. Otherwise the number
+ * of characters belonging to the number is stored in consumed and anything may follow.
+ * value is only written on success.
+ *
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if str or value are NULL
+ * @return CFG_RC_ERROR_FORMAT if str does not start with a number,
+ *  or if consumed is NULL and other characters follow the number
+ * @return CFG_RC_ERROR_RANGE if the number does not fit into the destination type
+ */
+CfgRet_t config_parseUint32(const char* str, uint32_t len, uint32_t* value, uint32_t* consumed);
+CfgRet_t config_parseInt32(const char* str, uint32_t len, int32_t* value, uint32_t* consumed);
+CfgRet_t config_parseUint64(const char* str, uint32_t len, uint64_t* value, uint32_t* consumed);
+CfgRet_t config_parseInt64(const char* str, uint32_t len, int64_t* value, uint32_t* consumed);
+CfgRet_t config_parseFloat(const char* str, uint32_t len, float* value, uint32_t* consumed);
+CfgRet_t config_parseDouble(const char* str, uint32_t len, double* value, uint32_t* consumed);
+
+/**
+ * Numeric entry types
+ * ===================================================================
+ */
+
+/**
+ * Returns the element type of an array type
+ * @param type [IN] Entry type
+ * @return element type, e.g. CONFIG_FLOAT for CONFIG_FLOAT_ARRAY, CONFIG_NONE for all other types
+ */
+ConfigType_t config_arrayElementType(ConfigType_t type);
+
+/**
+ * Returns the size of a numeric value in bytes
+ * @param type [IN] Entry type
+ * @return size of the value, 0 for types which are not numeric
+ */
+uint32_t config_numberSize(ConfigType_t type);
+
+/**
+ * Parses a number of the given numeric type with the matching function, e.g. config_parseFloat for CONFIG_FLOAT
+ * @param type [IN] Numeric entry type
+ * @param str [IN] Characters to parse
+ * @param len [IN] Number of characters in str
+ * @param value [OUT] Parsed value with config_numberSize(type) bytes
+ * @param consumed [OUT] Number of characters of the number, may be NULL
+ * @return any return value of the matching parse function
+ * @return CFG_RC_ERROR_INVALID if type is not numeric
+ */
+CfgRet_t config_parseNumber(ConfigType_t type, const char* str, uint32_t len, void* value, uint32_t* consumed);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_NUMBER_H
@@ -0,0 +1,72 @@
+#ifndef CONFIG_PARALLEL_H
+#define CONFIG_PARALLEL_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifndef CFG_PARALLEL_SUPPORTED
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CFG_PARALLEL_SUPPORTED (1)
+    #else
+        // Without POSIX threads, the jobs run one after another on the calling thread
+        #define CFG_PARALLEL_SUPPORTED (0)
+    #endif
+#endif
+
+#ifndef CFG_PARALLEL_MAX_THREADS
+    // Upper limit for the number of threads used by one call
+    #define CFG_PARALLEL_MAX_THREADS (16)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parallel loading and saving
+ * ===================================================================
+ * Loads or saves many tables, e.g. the config files of all modules at startup, on a small pool of threads.
+ * The calling thread works on the jobs as well and returns once all jobs are done. Every job is run with
+ * config_loadFromFile or config_saveToFile, so each table uses the functions of its io context.
+ *
+ * Tables without an io context share the functions set by config_setSaveLoadFunctions, which must not be
+ * changed during the call. Notification callbacks dispatched inline run on the thread which loaded the table.
+ * Every table may only appear in one job.
+ */
+
+typedef struct {
+    ConfigTable_t* cfg;
+    const char* filename;
+    // Result of config_loadFromFile or config_saveToFile, set once the job is done
+    CfgRet_t result;
+} ConfigParallelJob_t;
+
+/**
+ * Loads all tables concurrently
+ * @param jobs [INOUT] Tables and their files
+ * @param job_count [IN] Number of jobs
+ * @param thread_count [IN] Number of threads including the calling thread, limited to
+ *  CFG_PARALLEL_MAX_THREADS and the number of jobs. 0 is treated as 1
+ * @return CFG_RC_SUCCESS if all jobs succeeded
+ * @return CFG_RC_ERROR_NULLPTR if jobs is NULL while job_count is not 0
+ * @return CFG_RC_ERROR_INCOMPLETE if any job failed, see the results of the jobs
+ */
+CfgRet_t config_parallelLoad(ConfigParallelJob_t* jobs, uint32_t job_count, uint32_t thread_count);
+
+/**
+ * Saves all tables concurrently
+ * @param jobs [INOUT] Tables and their files
+ * @param job_count [IN] Number of jobs
+ * @param thread_count [IN] Number of threads including the calling thread, limited to
+ *  CFG_PARALLEL_MAX_THREADS and the number of jobs. 0 is treated as 1
+ * @return CFG_RC_SUCCESS if all jobs succeeded
+ * @return CFG_RC_ERROR_NULLPTR if jobs is NULL while job_count is not 0
+ * @return CFG_RC_ERROR_INCOMPLETE if any job failed, see the results of the jobs
+ */
+CfgRet_t config_parallelSave(ConfigParallelJob_t* jobs, uint32_t job_count, uint32_t thread_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_PARALLEL_H
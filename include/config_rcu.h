@@ -0,0 +1,154 @@
+#ifndef CONFIG_RCU_H
+#define CONFIG_RCU_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Immutable table snapshots (read-copy-update)
+ * ===================================================================
+ * A writer changes the table with the usual setter functions and then publishes a copy
+ * of all values as an immutable snapshot. Readers acquire the current snapshot without
+ * any lock and get a consistent view of several entries, e.g. SSID and password which
+ * were changed together. The read side only touches the slot of the reader and the
+ * pointer to the current snapshot, so its cost does not depend on the number of threads.
+ *
+ * Replaced snapshots are freed once every reader has left the read-side section which
+ * could still reference them (grace period). Readers register with a fixed slot index,
+ * at most one thread may use a slot at a time.
+ *
+ * Publishing and reclaiming have to be serialized by the caller, e.g. by writing the
+ * table only from one thread. Readers must not access the table itself while another
+ * thread writes it, unless the library is compiled with CFG_THREAD_SAFE.
+ */
+
+#ifndef CFG_RCU_SUPPORTED
+    #if defined(__GNUC__) || defined(__clang__)
+        #define CFG_RCU_SUPPORTED (1)
+    #else
+        // Without the atomic builtins, all functions return CFG_RC_ERROR_INVALID or NULL
+        #define CFG_RCU_SUPPORTED (0)
+    #endif
+#endif
+
+// Alignment of every value inside a snapshot
+#define CFG_RCU_ALIGNMENT (8)
+// Reader slots are padded to a cache line so readers do not share cache lines
+#define CFG_RCU_CACHE_LINE_SIZE (64)
+
+typedef struct ConfigSnapshot {
+    const ConfigTable_t* cfg;
+    // Generation of the table the offsets were computed for
+    uint32_t generation;
+    // Offset of the value of every entry in values
+    const uint32_t* offsets;
+    uint8_t* values;
+    // Epoch in which the snapshot was replaced, managed by the config_rcu* functions
+    uint64_t retired_epoch;
+    struct ConfigSnapshot* next_retired;
+} ConfigSnapshot_t;
+
+typedef struct {
+    // Epoch in which the reader entered its read-side section, 0 while outside
+    uint64_t epoch;
+    uint8_t padding[CFG_RCU_CACHE_LINE_SIZE - sizeof(uint64_t)];
+} ConfigRcuReader_t;
+
+typedef struct {
+    ConfigTable_t* cfg;
+    // Snapshot returned to new readers
+    ConfigSnapshot_t* current;
+    // Replaced snapshots waiting for their grace period, newest first
+    ConfigSnapshot_t* retired;
+    uint64_t epoch;
+    ConfigRcuReader_t* readers;
+    uint32_t reader_count;
+    uint32_t* offsets;
+    uint32_t values_size;
+    // Generation of the table at initialization. The offsets refer to the entry order of that generation
+    uint32_t generation;
+} ConfigRcu_t;
+
+/**
+ * Prepares the snapshot state of a table and publishes the first snapshot
+ * @param rcu [OUT] Snapshot state. Has to stay valid until config_rcuDestroy is called
+ * @param cfg [IN] Configuration table
+ * @param readers [IN] Storage for one slot per reader
+ * @param reader_count [IN] Number of elements in readers
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if rcu, cfg or readers are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if no memory for the snapshot could be allocated
+ * @return CFG_RC_ERROR_INVALID if snapshots are not supported with this compiler
+ */
+CfgRet_t config_rcuInit(ConfigRcu_t* rcu, ConfigTable_t* cfg, ConfigRcuReader_t* readers, uint32_t reader_count);
+
+/**
+ * Copies the current values of the table into a new snapshot and makes it the current one.
+ * Replaced snapshots are freed as soon as no reader can reference them anymore
+ * @param rcu [INOUT] Snapshot state
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if rcu is NULL or not initialized
+ * @return CFG_RC_ERROR_TOO_LARGE if no memory for the snapshot could be allocated.
+ *  The previous snapshot stays current
+ * @return CFG_RC_ERROR_INVALID if snapshots are not supported with this compiler or the table has been
+ *  sorted since config_rcuInit. Snapshots still held by readers keep the old entry order, so the
+ *  snapshot state has to be destroyed and initialized again once no reader uses it
+ */
+CfgRet_t config_rcuPublish(ConfigRcu_t* rcu);
+
+/**
+ * Enters the read-side section of a reader and returns the current snapshot.
+ * The snapshot stays valid until config_rcuReadUnlock is called with the same slot
+ * @param rcu [IN] Snapshot state
+ * @param reader [IN] Slot index of the reader, smaller than reader_count
+ * @return current snapshot or NULL if rcu is NULL or reader is out of range
+ */
+const ConfigSnapshot_t* config_rcuReadLock(ConfigRcu_t* rcu, uint32_t reader);
+
+/**
+ * Leaves the read-side section of a reader. Snapshots acquired by it must not be used anymore
+ * @param rcu [IN] Snapshot state
+ * @param reader [IN] Slot index of the reader
+ */
+void config_rcuReadUnlock(ConfigRcu_t* rcu, uint32_t reader);
+
+/**
+ * Frees all replaced snapshots whose grace period has passed.
+ * Called by config_rcuPublish, call it directly to free memory without publishing
+ * @param rcu [INOUT] Snapshot state
+ * @return number of replaced snapshots which are still referenced by readers
+ */
+uint32_t config_rcuReclaim(ConfigRcu_t* rcu);
+
+/**
+ * Frees all snapshots. No reader may be inside its read-side section
+ * @param rcu [INOUT] Snapshot state
+ */
+void config_rcuDestroy(ConfigRcu_t* rcu);
+
+/**
+ * Returns a pointer to the value of an entry inside a snapshot
+ * @param snapshot [IN] Snapshot acquired with config_rcuReadLock
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return pointer to entry size bytes or NULL if snapshot is NULL or idx is out of range
+ */
+const void* config_snapshotGetValue(const ConfigSnapshot_t* snapshot, uint32_t idx);
+
+/**
+ * Returns a pointer to the value of an entry inside a snapshot
+ * @param snapshot [IN] Snapshot acquired with config_rcuReadLock
+ * @param key [IN] Key of the configuration entry
+ * @return pointer to entry size bytes or NULL if snapshot or key are NULL, the key is unknown
+ *  or the table has been sorted since the snapshot was published
+ */
+const void* config_snapshotGetValueByKey(const ConfigSnapshot_t* snapshot, const char* key);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_RCU_H
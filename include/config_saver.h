@@ -0,0 +1,140 @@
+#ifndef CONFIG_SAVER_H
+#define CONFIG_SAVER_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifndef CFG_SAVER_SUPPORTED
+    #if defined(__unix__) || defined(__APPLE__)
+        #define CFG_SAVER_SUPPORTED (1)
+    #else
+        // Without POSIX threads, all functions return CFG_RC_ERROR_INVALID
+        #define CFG_SAVER_SUPPORTED (0)
+    #endif
+#endif
+
+#if CFG_SAVER_SUPPORTED
+    #include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Asynchronous debounced persistence
+ * ===================================================================
+ * A background thread saves the table with config_saveToFile, so callers never block on file I/O.
+ * config_saverRequest only marks a save as requested. The first request starts the debounce window,
+ * all further requests until the window has passed are saved together.
+ *
+ * The thread copies all values into a private table and saves that copy, so writers are only
+ * excluded while the values are copied. Set lock and unlock to the functions protecting the table
+ * against concurrent writers, e.g. a mutex, to get a consistent copy of several entries.
+ */
+
+/**
+ * Function pointer definition for locking and unlocking the table while its values are copied
+ * @param ctx [IN] lock_ctx of the saver
+ */
+typedef void (*configLockFunc)(void* ctx);
+
+typedef struct {
+    // Result of the last save
+    CfgRet_t last_error;
+    // Duration of the last save including the copy of the values in microseconds
+    uint32_t last_latency_us;
+    // Number of completed saves
+    uint32_t save_count;
+    // Number of requests which were coalesced into these saves
+    uint32_t request_count;
+} ConfigSaverStats_t;
+
+typedef struct {
+    // Optional, set before config_saverStart
+    configLockFunc lock;
+    configLockFunc unlock;
+    void* lock_ctx;
+
+    // Managed by the config_saver* functions
+    ConfigTable_t* cfg;
+    const char* filename;
+    uint32_t debounce_ms;
+    // Private copy of the table which is saved by the thread
+    ConfigTable_t shadow;
+    ConfigEntry_t* shadow_entries;
+    uint8_t* shadow_values;
+    // Generation of the table when the private copy was prepared
+    uint32_t generation;
+    // Requests increment requested, the thread sets saved to the requested count it has saved
+    uint32_t requested;
+    uint32_t saved;
+    bool flush;
+    bool stop;
+    ConfigSaverStats_t stats;
+#if CFG_SAVER_SUPPORTED
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+#endif
+} ConfigSaver_t;
+
+/**
+ * Prepares the private copy of the table and starts the saving thread.
+ * The private copy has the entry order of the table at this point. Saves fail with CFG_RC_ERROR_INVALID
+ * once the table has been sorted, stop and start the saver again after sorting
+ * @param saver [INOUT] Saver state. Has to stay valid until config_saverStop is called
+ * @param cfg [IN] Configuration table
+ * @param filename [IN] Name of the file where the table is saved. Has to stay valid until config_saverStop
+ * @param debounce_ms [IN] Time from the first request until the save in milliseconds
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if saver, cfg or filename are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if no memory for the private copy could be allocated
+ * @return CFG_RC_ERROR if the thread could not be started
+ * @return CFG_RC_ERROR_INVALID if threads are not supported on this platform
+ */
+CfgRet_t config_saverStart(ConfigSaver_t* saver, ConfigTable_t* cfg, const char* filename, uint32_t debounce_ms);
+
+/**
+ * Requests a save. Returns immediately
+ * @param saver [INOUT] Saver state
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if saver is NULL or not started
+ * @return CFG_RC_ERROR_INVALID if threads are not supported on this platform
+ */
+CfgRet_t config_saverRequest(ConfigSaver_t* saver);
+
+/**
+ * Saves all requested changes without waiting for the debounce window and waits for completion.
+ * Returns immediately if no save is pending
+ * @param saver [INOUT] Saver state
+ * @return result of the last save
+ * @return CFG_RC_ERROR_NULLPTR if saver is NULL or not started
+ * @return CFG_RC_ERROR_INVALID if threads are not supported on this platform
+ */
+CfgRet_t config_saverFlush(ConfigSaver_t* saver);
+
+/**
+ * Returns the statistics of the saver
+ * @param saver [IN] Saver state
+ * @param stats [OUT] Statistics
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if saver or stats are NULL or the saver is not started
+ * @return CFG_RC_ERROR_INVALID if threads are not supported on this platform
+ */
+CfgRet_t config_saverGetStats(ConfigSaver_t* saver, ConfigSaverStats_t* stats);
+
+/**
+ * Saves all requested changes, stops the thread and frees the private copy
+ * @param saver [INOUT] Saver state
+ * @return result of the last save
+ * @return CFG_RC_ERROR_NULLPTR if saver is NULL or not started
+ * @return CFG_RC_ERROR_INVALID if threads are not supported on this platform
+ */
+CfgRet_t config_saverStop(ConfigSaver_t* saver);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_SAVER_H
@@ -0,0 +1,152 @@
+#ifndef CONFIG_STATS_H
+#define CONFIG_STATS_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifndef CFG_STATS_BUCKET_COUNT
+    // Number of latency histogram buckets. Bucket 0 counts durations below 1 microsecond, bucket i durations
+    // from 2^(i-1) to 2^i - 1 microseconds and the last bucket all longer durations
+    #define CFG_STATS_BUCKET_COUNT (24)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Instrumentation
+ * ===================================================================
+ * With CFG_STATS set to 1, a table with attached statistics counts key lookups, writes and errors and
+ * measures how long loading, saving and parsing take. All counters are updated with relaxed atomic
+ * additions, so they may be updated from several threads but a copy of all counters is not a consistent
+ * snapshot. Requires GCC or Clang.
+ *
+ * With CFG_STATS set to 0, which is the default, the instrumentation is removed from the library
+ * and all functions except config_histogramPercentile return CFG_RC_ERROR_INVALID.
+ */
+
+typedef enum {
+    // Key lookups by any function taking a key
+    CFG_STAT_LOOKUPS,
+    // Key lookups which did not find the key
+    CFG_STAT_LOOKUP_MISSES,
+    // Accesses rejected with CFG_RC_ERROR_TYPE_MISMATCH
+    CFG_STAT_TYPE_MISMATCHES,
+    // Successful writes to an entry, including writes which leave the value unchanged
+    CFG_STAT_SETS,
+    // Writes rejected with CFG_RC_ERROR_READ_ONLY
+    CFG_STAT_READ_ONLY_REJECTIONS,
+    // Lines which could not be parsed or applied
+    CFG_STAT_PARSE_ERRORS,
+    // Bytes read from files or passed to the streaming parser
+    CFG_STAT_BYTES_READ,
+    // Bytes written to files
+    CFG_STAT_BYTES_WRITTEN,
+    CFG_STAT_COUNTER_COUNT
+} ConfigStatCounter_t;
+
+typedef enum {
+    // config_loadFromFile
+    CFG_STAT_LOAD,
+    // config_saveToFile and in-place updates of config_saveDirty
+    CFG_STAT_SAVE,
+    // config_parseBuffer
+    CFG_STAT_PARSE,
+    CFG_STAT_HISTOGRAM_COUNT
+} ConfigStatHistogram_t;
+
+typedef struct {
+    uint64_t buckets[CFG_STATS_BUCKET_COUNT];
+    // Number of measurements, their sum and maximum in microseconds
+    uint64_t count;
+    uint64_t total_us;
+    uint64_t max_us;
+} ConfigHistogram_t;
+
+/**
+ * Function pointer definition for a monotonic clock
+ * @return current time in microseconds
+ */
+typedef uint64_t (*configClockFunc)(void);
+
+typedef struct ConfigStats {
+    // Optional clock, set before config_statsAttach. If NULL, CLOCK_MONOTONIC is used on POSIX systems,
+    // on other systems no latencies are measured
+    configClockFunc clock;
+
+    // Managed by the config_stats* functions
+    uint64_t counters[CFG_STAT_COUNTER_COUNT];
+    ConfigHistogram_t histograms[CFG_STAT_HISTOGRAM_COUNT];
+} ConfigStats_t;
+
+/**
+ * Resets the statistics and attaches them to the table.
+ * To detach the statistics, set the stats member of the table to NULL
+ * @param cfg [INOUT] Configuration table
+ * @param stats [INOUT] User-provided statistics storage
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or stats are NULL
+ * @return CFG_RC_ERROR_INVALID if the library was compiled without CFG_STATS
+ */
+CfgRet_t config_statsAttach(ConfigTable_t* cfg, ConfigStats_t* stats);
+
+/**
+ * Copies the counters and histograms of the table
+ * @param cfg [IN] Configuration table with attached statistics
+ * @param stats [OUT] Copy of the statistics
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or stats are NULL or no statistics are attached
+ * @return CFG_RC_ERROR_INVALID if the library was compiled without CFG_STATS
+ */
+CfgRet_t config_statsRead(const ConfigTable_t* cfg, ConfigStats_t* stats);
+
+/**
+ * Sets all counters and histograms of the table to 0
+ * @param cfg [INOUT] Configuration table with attached statistics
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL or no statistics are attached
+ * @return CFG_RC_ERROR_INVALID if the library was compiled without CFG_STATS
+ */
+CfgRet_t config_statsReset(ConfigTable_t* cfg);
+
+/**
+ * Estimates a percentile of a latency histogram
+ * @param histogram [IN] Histogram, e.g. of a copy returned by config_statsRead
+ * @param percent [IN] Percentile from 0 to 100
+ * @return upper bound of the bucket containing the percentile in microseconds, limited to the maximum.
+ *  0 if the histogram is empty or NULL
+ */
+uint64_t config_histogramPercentile(const ConfigHistogram_t* histogram, uint32_t percent);
+
+#if CFG_STATS
+/**
+ * Functions used by the library to update the statistics, only called if statistics are attached
+ */
+uint64_t config_statsStart(const ConfigTable_t* cfg);
+void config_statsRecord(const ConfigTable_t* cfg, ConfigStatHistogram_t histogram, uint64_t start);
+
+    #define CFG_STATS_ADD(cfg, counter, n)                                                                   \
+        do {                                                                                                 \
+            if((cfg) != NULL && (cfg)->stats != NULL) {                                                      \
+                __atomic_fetch_add(&(cfg)->stats->counters[(counter)], (uint64_t)(n), __ATOMIC_RELAXED);     \
+            }                                                                                                \
+        } while(0)
+    // Start time of a measured operation, 0 without attached statistics
+    #define CFG_STATS_START(cfg) (((cfg) != NULL && (cfg)->stats != NULL) ? config_statsStart(cfg) : 0)
+    #define CFG_STATS_RECORD(cfg, histogram, start)                                                          \
+        do {                                                                                                 \
+            if((cfg) != NULL && (cfg)->stats != NULL) config_statsRecord((cfg), (histogram), (start));       \
+        } while(0)
+#else
+    // The table is still evaluated, so functions only using it for statistics have no unused parameter
+    #define CFG_STATS_ADD(cfg, counter, n) ((void)(cfg))
+    #define CFG_STATS_START(cfg) ((void)(cfg), (uint64_t)0)
+    #define CFG_STATS_RECORD(cfg, histogram, start) ((void)(cfg), (void)(start))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_STATS_H
@@ -0,0 +1,122 @@
+#ifndef CONFIG_STREAM_H
+#define CONFIG_STREAM_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifndef CFG_STREAM_KEY_LEN
+    // Maximum key length in characters. config_streamBegin rejects tables with longer keys
+    #define CFG_STREAM_KEY_LEN (64)
+#endif
+
+#ifndef CFG_STREAM_NUMBER_LEN
+    // Maximum length of a single number in characters. Longer numbers are reported as CFG_RC_ERROR_TOO_LARGE
+    #define CFG_STREAM_NUMBER_LEN (64)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Streaming parser
+ * ===================================================================
+ * Parses the "key: value" text format from chunks of any size, e.g. as they arrive from a UART or a pipe.
+ * Partial keys and values are carried over between calls in the parser state, so a line may be split
+ * at any character. Every entry is written as soon as its line is complete, lines which could not be
+ * applied are reported through the error callback and leave the entry unchanged.
+ *
+ * Only keys and single numbers are kept as text. Values are converted into the user-provided buffer
+ * while they arrive and whitespace is skipped without being stored, so lines of any length are parsed
+ * without a heap allocation. The buffer only has to hold the largest value of the table.
+ *
+ * Values are parsed like config_parseKVStr does.
+ */
+
+typedef enum {
+    CFG_STREAM_STATE_KEY,
+    CFG_STREAM_STATE_VALUE,
+    // Rest of the line is ignored, either because of an error or a complete boolean value
+    CFG_STREAM_STATE_SKIP
+} ConfigStreamState_t;
+
+typedef struct {
+    // User-provided storage for the value of the current line, see config_streamBufferSize
+    uint8_t* buffer;
+    uint32_t buffer_size;
+    // Optional function called for every line which could not be applied
+    parseErrorFunc on_error;
+    void* error_ctx;
+
+    // Managed by the config_stream* functions
+    ConfigTable_t* cfg;
+    ConfigStreamState_t state;
+    // Current line number starting at 1
+    uint32_t line;
+    // Number of lines which could not be applied since config_streamBegin
+    uint32_t error_count;
+    // First error of the current line
+    CfgRet_t line_error;
+    // Entry of the current line, valid in CFG_STREAM_STATE_VALUE
+    uint32_t idx;
+    char key[CFG_STREAM_KEY_LEN + 1];
+    uint32_t key_len;
+    // Characters of the current number
+    char number[CFG_STREAM_NUMBER_LEN];
+    uint32_t number_len;
+    // Characters of a string value or number of parsed array elements
+    uint32_t value_len;
+    // Length of a string value without trailing whitespace
+    uint32_t trimmed_len;
+    // A non-whitespace character of the value was seen
+    bool has_value;
+    // Whitespace followed a single number, so only whitespace may follow
+    bool number_done;
+    // An array element is expected after a comma
+    bool expect_element;
+} ConfigStream_t;
+
+/**
+ * Returns the buffer size needed to parse every entry of the table
+ * @param cfg [IN] Configuration table
+ * @return buffer size in bytes, 0 if cfg is NULL
+ */
+uint32_t config_streamBufferSize(const ConfigTable_t* cfg);
+
+/**
+ * Starts parsing a new stream. The buffer and the optional error callback have to be set before
+ * @param stream [INOUT] Parser state with user-provided buffer
+ * @param cfg [IN] Configuration table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if stream, cfg or the buffer are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if a key of the table is longer than CFG_STREAM_KEY_LEN
+ */
+CfgRet_t config_streamBegin(ConfigStream_t* stream, ConfigTable_t* cfg);
+
+/**
+ * Parses the next chunk of the stream and writes all entries whose lines are completed by it.
+ * Changed entries of one chunk are notified together
+ * @param stream [INOUT] Parser state
+ * @param data [IN] Next characters of the stream, need not be null-terminated
+ * @param len [IN] Number of characters in data
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if stream or data are NULL or the stream was not started
+ * @return CFG_RC_ERROR_INCOMPLETE if any line completed by this chunk could not be applied.
+ *  The error of every such line is reported through the error callback
+ */
+CfgRet_t config_streamFeed(ConfigStream_t* stream, const char* data, uint32_t len);
+
+/**
+ * Parses the last line if it is not terminated by a line ending and ends the stream
+ * @param stream [INOUT] Parser state
+ * @return CFG_RC_SUCCESS if all lines of the stream have been applied
+ * @return CFG_RC_ERROR_NULLPTR if stream is NULL or the stream was not started
+ * @return CFG_RC_ERROR_INCOMPLETE if any line of the stream could not be applied
+ */
+CfgRet_t config_streamEnd(ConfigStream_t* stream);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_STREAM_H
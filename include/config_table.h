@@ -7,7 +7,6 @@
 extern "C" {
 #endif
 // Ideas:
-// Callbacks on changes
 // Persistent storage support
 // Default values
 // JSON/CLI Adapter
@@ -19,7 +18,13 @@ extern "C" {
     #define FILE_MAX_LINE_LEN (256)
 #endif
 
+#ifndef KV_SEP_CHAR
+    // Character separating key and value in the text format
+    #define KV_SEP_CHAR ':'
+#endif
+
 typedef enum {
+    CFG_RC_ERROR_DUPLICATE_KEY = -10, // The same key is used by more than one entry
     CFG_RC_ERROR_READ_ONLY = -9,      // The setting is read-only
     CFG_RC_ERROR_INCOMPLETE = -8,     // Operation was partially successful
     CFG_RC_ERROR_INVALID = -7,        // Invalid state detected
@@ -50,7 +55,44 @@ typedef enum {
     // ignored for example when printing the settings somewhere
 } CfgPermissions_t;
 
-typedef enum { CONFIG_NONE = 0, CONFIG_UINT32, CONFIG_INT32, CONFIG_FLOAT, CONFIG_STRING, CONFIG_BOOL } ConfigType_t;
+/**
+ * Types of configuration values. New types are appended, the numeric values are part of the binary formats.
+ * Array types hold a fixed number of elements, given by the entry size divided by the element size.
+ * In the text format the elements are separated by commas, e.g. "1, 2, 3". Missing trailing
+ * elements are set to 0 when parsing.
+ */
+typedef enum {
+    CONFIG_NONE = 0,
+    CONFIG_UINT32,
+    CONFIG_INT32,
+    CONFIG_FLOAT,
+    CONFIG_STRING,
+    CONFIG_BOOL,
+    CONFIG_UINT64,
+    CONFIG_INT64,
+    CONFIG_DOUBLE,
+    CONFIG_UINT32_ARRAY,
+    CONFIG_INT32_ARRAY,
+    CONFIG_FLOAT_ARRAY,
+    CONFIG_UINT64_ARRAY,
+    CONFIG_INT64_ARRAY,
+    CONFIG_DOUBLE_ARRAY
+} ConfigType_t;
+
+#ifndef CFG_THREAD_SAFE
+    // If set to 1, every entry carries a sequence counter which allows reading values
+    // from multiple threads without locks while other threads write them.
+    // Getters retry instead of blocking if a write is in progress and writers never wait for readers.
+    // Writers to the same entry exclude each other. Has to be set identically for the library and its users.
+    // The change log is not thread-safe, serialize writes while a log is attached
+    #define CFG_THREAD_SAFE (0)
+#endif
+
+#ifndef CFG_STATS
+    // If set to 1, tables can count lookups, writes and errors and measure load, save and parse latencies,
+    // see config_stats.h. Set to 0 to remove the instrumentation. Has to be set identically for the library and its users
+    #define CFG_STATS (0)
+#endif
 
 typedef struct {
     const char* key;
@@ -58,13 +100,86 @@ typedef struct {
     void* value;
     uint32_t size;
     CfgPermissions_t perm;
+#if CFG_THREAD_SAFE
+    // Sequence counter, odd while a write is in progress. Initialize with 0
+    uint32_t seq;
+#endif
 } ConfigEntry_t;
 
+/**
+ * Slot of the optional key hash index. A slot is empty if entry is 0,
+ * otherwise it refers to the configuration entry at index entry - 1.
+ */
+typedef struct {
+    uint32_t hash;
+    uint32_t entry;
+} ConfigIndexSlot_t;
+
+/**
+ * Optional hash index over the keys of a configuration table.
+ * The slot storage is provided by the user to avoid dynamic allocation.
+ * Use CFG_INDEX_SLOT_COUNT to determine a suitable number of slots.
+ */
+typedef struct {
+    ConfigIndexSlot_t* slots;
+    uint32_t slot_count;
+} ConfigIndex_t;
+
+#ifndef CFG_INDEX_SLOT_COUNT
+    // Recommended number of index slots for a table with the given number of entries.
+    // Keeps the load factor at or below 50% to keep probe sequences short
+    #define CFG_INDEX_SLOT_COUNT(entry_count) ((entry_count) * 2 + 1)
+#endif
+
+#ifndef CFG_DIRTY_WORD_COUNT
+    // Number of 32 bit words of a dirty bitmap for a table with the given number of entries
+    #define CFG_DIRTY_WORD_COUNT(entry_count) (((entry_count) + 31) / 32)
+#endif
+
+struct ConfigLog;
+struct ConfigNotifier;
+struct ConfigStats;
+struct ConfigIo;
+
 typedef struct {
     ConfigEntry_t* entries;
     uint32_t count;
+    // Optional key index. If NULL, key lookups fall back to a linear search
+    ConfigIndex_t* index;
+    // Incremented whenever previously resolved handles become invalid
+    uint32_t generation;
+    // Set if the entries are sorted by key. Enables binary search for key lookups
+    // if no index is attached. Set by config_sortTable or by the user for tables sorted at build time
+    bool sorted;
+    // Optional dirty bitmap with one bit per entry. Bits are set by writes which change a value.
+    // Attached by config_enableDirtyTracking
+    uint32_t* dirty;
+    // Optional change log. If set, every write which changes a value is appended to the log.
+    // Attached by config_logOpen, see config_log.h
+    struct ConfigLog* log;
+    // Optional change notifier. If set, every write which changes a value marks a pending notification.
+    // Attached by config_notifyAttach, see config_notify.h
+    struct ConfigNotifier* notifier;
+    // Optional save and load functions of this table. If NULL, the functions set by
+    // config_setSaveLoadFunctions are used
+    const struct ConfigIo* io;
+#if CFG_STATS
+    // Optional counters and latency histograms. Attached by config_statsAttach, see config_stats.h
+    struct ConfigStats* stats;
+#endif
 } ConfigTable_t;
 
+/**
+ * Handle to a configuration entry with a resolved key.
+ * Handles carry the index and type of the entry as well as the table generation
+ * at the time of resolution, so stale handles can be detected cheaply.
+ */
+typedef struct {
+    uint32_t idx;
+    ConfigType_t type;
+    uint32_t generation;
+} ConfigHandle_t;
+
 /**
  * Function pointer definition for overwriting the save function
  */
@@ -75,9 +190,62 @@ typedef CfgRet_t (*saveToFileFunc)(const ConfigTable_t* cfg, const char* filenam
  */
 typedef CfgRet_t (*loadFromFileFunc)(ConfigTable_t* cfg, const char* filename);
 
+/**
+ * Save and load functions of a single table, e.g. for a storage backend.
+ * Tables with an io context never use the functions set by config_setSaveLoadFunctions,
+ * so tables with different backends can be loaded and saved from several threads at once.
+ * The functions can reach the backend context through cfg->io->ctx.
+ * One context may be shared by several tables
+ */
+typedef struct ConfigIo {
+    // NULL selects the default text format
+    saveToFileFunc save;
+    loadFromFileFunc load;
+    // User context of the backend, e.g. a filesystem handle
+    void* ctx;
+} ConfigIo_t;
+
+/**
+ * Builds a hash index over the keys of the configuration table and attaches it
+ * to the table. Afterwards all key lookups are done in constant time.
+ * The index has to be rebuilt if the entries of the table are changed.
+ * To detach the index, set the index member of the table to NULL.
+ * @note If the table contains duplicate keys, only the first entry with that key is indexed
+ * @param cfg [INOUT] Configuration table
+ * @param index [INOUT] Index with user-provided slot storage
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, index or the slot storage are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if the index does not have more slots than the table has entries
+ */
+CfgRet_t config_buildIndex(ConfigTable_t* cfg, ConfigIndex_t* index);
+
+/**
+ * Sorts the entries of the configuration table by key and marks the table as sorted.
+ * Afterwards key lookups use a binary search if no hash index is attached.
+ * If the table is already sorted, the entries are only checked for duplicates.
+ * @note Sorting changes the entry indices. Handles are invalidated and an attached index is rebuilt.
+ *  Pending notifications of an attached notifier are delivered before and entry subscriptions are updated
+ * @param cfg [INOUT] Configuration table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_DUPLICATE_KEY if more than one entry uses the same key.
+ *  The entries are sorted, but the table is not marked as sorted.
+ */
+CfgRet_t config_sortTable(ConfigTable_t* cfg);
+
+/**
+ * Function pointer definition for reporting errors while parsing multiple lines
+ * @param ctx [IN] User context passed through from the parsing function
+ * @param line [IN] Line number of the line that failed, starting at 1
+ * @param error [IN] Error returned while parsing that line
+ */
+typedef void (*parseErrorFunc)(void* ctx, uint32_t line, CfgRet_t error);
+
 /**
  * Searches for the given key in the config table and returns the corresponding
  * index if it exists.
+ * @note Uses the hash index of the table if one is attached, else a binary search
+ *  if the table is sorted and a linear search otherwise
  * @param cfg [IN] Configuration table
  * @param key [IN] Configuration key
  * @return Index of configuration entry matching the key or -1 if no matching key was found
@@ -123,6 +291,7 @@ CfgRet_t config_getByIdx(const ConfigTable_t* cfg, uint32_t idx, ConfigEntry_t*
  * @return CFG_RC_ERROR_TOO_LARGE if the given value does not
  *  fit into the allocated memory for the configuration value
  * @return CFG_RC_ERROR_READ_ONLY if the setting to change is read-only
+ * @return any error of config_logAppend if a change log is attached. The value has still been set
  */
 CfgRet_t config_setByKey(ConfigTable_t* cfg, const char* key, const void* value, uint32_t size);
 
@@ -139,9 +308,26 @@ CfgRet_t config_setByKey(ConfigTable_t* cfg, const char* key, const void* value,
  * @return CFG_RC_ERROR_TOO_LARGE if the given value does not
  *  fit into the allocated memory for the configuration value
  * @return CFG_RC_ERROR_READ_ONLY if the setting to change is read-only
+ * @return any error of config_logAppend if a change log is attached. The value has still been set
  */
 CfgRet_t config_setByIdx(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size);
 
+/**
+ * Copies the raw value of a configuration entry
+ * @note Unlike config_getByIdx this copies the value itself, which is safe against concurrent writes
+ *  if CFG_THREAD_SAFE is set
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [OUT] Buffer for the value
+ * @param size [IN] Size of value in bytes. Has to be at least the size of the entry
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or value are NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ * @return CFG_RC_ERROR_TOO_LARGE if the value does not fit into the buffer
+ */
+CfgRet_t config_copyValueByIdx(const ConfigTable_t* cfg, uint32_t idx, void* value, uint32_t size);
+
 /**
  * Type specific getter and setter functions
  * ===================================================================
@@ -273,11 +459,361 @@ CfgRet_t config_getBoolByKey(const ConfigTable_t* cfg, const char* key, bool* va
  */
 CfgRet_t config_getBoolByIdx(const ConfigTable_t* cfg, uint32_t idx, bool* value);
 
+/**
+ * Returns the uint64 value for the given key if the type matches
+ * @param cfg [IN] Configuration table
+ * @param key [IN] Configuration key string
+ * @param value [OUT] Pointer to a uint64_t where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or key are NULL
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if no matching key was found
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the requested config entry has the wrong type
+ */
+CfgRet_t config_getUint64ByKey(const ConfigTable_t* cfg, const char* key, uint64_t* value);
+/**
+ * Returns the uint64 value for the given index if the type matches
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [OUT] Pointer to a uint64_t where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ *  @return CFG_RC_ERROR_TYPE_MISMATCH if the requested config entry has the wrong type
+ */
+CfgRet_t config_getUint64ByIdx(const ConfigTable_t* cfg, uint32_t idx, uint64_t* value);
+
+/**
+ * Returns the int64 value for the given key if the type matches
+ * @param cfg [IN] Configuration table
+ * @param key [IN] Configuration key string
+ * @param value [OUT] Pointer to a int64_t where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or key are NULL
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if no matching key was found
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the requested config entry has the wrong type
+ */
+CfgRet_t config_getInt64ByKey(const ConfigTable_t* cfg, const char* key, int64_t* value);
+/**
+ * Returns the int64 value for the given index if the type matches
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [OUT] Pointer to a int64_t where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ *  @return CFG_RC_ERROR_TYPE_MISMATCH if the requested config entry has the wrong type
+ */
+CfgRet_t config_getInt64ByIdx(const ConfigTable_t* cfg, uint32_t idx, int64_t* value);
+
+/**
+ * Returns the double value for the given key if the type matches
+ * @param cfg [IN] Configuration table
+ * @param key [IN] Configuration key string
+ * @param value [OUT] Pointer to a double where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or key are NULL
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if no matching key was found
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the requested config entry has the wrong type
+ */
+CfgRet_t config_getDoubleByKey(const ConfigTable_t* cfg, const char* key, double* value);
+/**
+ * Returns the double value for the given index if the type matches
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [OUT] Pointer to a double where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ *  @return CFG_RC_ERROR_TYPE_MISMATCH if the requested config entry has the wrong type
+ */
+CfgRet_t config_getDoubleByIdx(const ConfigTable_t* cfg, uint32_t idx, double* value);
+
+/**
+ * Returns the number of elements of an array entry
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return entry size divided by the element size, 0 if the entry is not an array or idx is out of range
+ */
+uint32_t config_getArrayLength(const ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Handle based getter and setter functions
+ * ===================================================================
+ * Resolve a key once with config_getHandle and use the handle for repeated access.
+ * The type of the entry is checked during resolution, so the accessors only compare
+ * the handle against the table generation and the expected type of the accessor.
+ */
+
+/**
+ * Resolves a key to a handle for the given type
+ * @param cfg [IN] Configuration table
+ * @param key [IN] Configuration key string
+ * @param type [IN] Expected type of the configuration entry
+ * @param handle [OUT] Resolved handle
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, key or handle are NULL
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if no matching key was found
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the entry does not have the expected type
+ */
+CfgRet_t config_getHandle(const ConfigTable_t* cfg, const char* key, ConfigType_t type, ConfigHandle_t* handle);
+
+/**
+ * Resolves an index to a handle for the given type
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param type [IN] Expected type of the configuration entry
+ * @param handle [OUT] Resolved handle
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or handle are NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the entry does not have the expected type
+ */
+CfgRet_t config_getHandleByIdx(const ConfigTable_t* cfg, uint32_t idx, ConfigType_t type, ConfigHandle_t* handle);
+
+/**
+ * Invalidates all handles resolved for the given table so far.
+ * Call this whenever entries of the table are moved, added or removed.
+ * @param cfg [INOUT] Configuration table
+ */
+void config_invalidateHandles(ConfigTable_t* cfg);
+
+/**
+ * Returns the uint32 value referred to by the handle
+ * @param cfg [IN] Configuration table
+ * @param handle [IN] Handle resolved by config_getHandle
+ * @param value [OUT] Pointer to a uint32_t where the config value should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or value are NULL
+ * @return CFG_RC_ERROR_INVALID if the handle is stale
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the handle was not resolved for this type
+ */
+CfgRet_t config_getUint32ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, uint32_t* value);
+/**
+ * Returns the int32 value referred to by the handle
+ * @see config_getUint32ByHandle for return values
+ */
+CfgRet_t config_getInt32ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, int32_t* value);
+/**
+ * Returns the float value referred to by the handle
+ * @see config_getUint32ByHandle for return values
+ */
+CfgRet_t config_getFloatByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, float* value);
+/**
+ * Returns the bool value referred to by the handle
+ * @see config_getUint32ByHandle for return values
+ */
+CfgRet_t config_getBoolByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, bool* value);
+/**
+ * Returns the uint64 value referred to by the handle
+ * @see config_getUint32ByHandle for return values
+ */
+CfgRet_t config_getUint64ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, uint64_t* value);
+/**
+ * Returns the int64 value referred to by the handle
+ * @see config_getUint32ByHandle for return values
+ */
+CfgRet_t config_getInt64ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, int64_t* value);
+/**
+ * Returns the double value referred to by the handle
+ * @see config_getUint32ByHandle for return values
+ */
+CfgRet_t config_getDoubleByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, double* value);
+/**
+ * Returns the string referred to by the handle
+ * @param cfg [IN] Configuration table
+ * @param handle [IN] Handle resolved by config_getHandle
+ * @param str [INOUT] string buffer of size str_size
+ * @param str_size [IN] Maximum size of str string
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or str are NULL
+ * @return CFG_RC_ERROR_INVALID if the handle is stale
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the handle was not resolved for this type
+ * @return CFG_RC_ERROR_TOO_LARGE if the stored string does not fit into the provided str parameter.
+ *  In that case, no data will be written to str
+ */
+CfgRet_t config_getStringByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, char* str, uint32_t str_size);
+
+/**
+ * Sets the uint32 value referred to by the handle
+ * @param cfg [INOUT] Configuration table
+ * @param handle [IN] Handle resolved by config_getHandle
+ * @param value [IN] New value
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_INVALID if the handle is stale
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the handle was not resolved for this type
+ * @return CFG_RC_ERROR_READ_ONLY if the setting to change is read-only
+ */
+CfgRet_t config_setUint32ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, uint32_t value);
+/**
+ * Sets the int32 value referred to by the handle
+ * @see config_setUint32ByHandle for return values
+ */
+CfgRet_t config_setInt32ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, int32_t value);
+/**
+ * Sets the float value referred to by the handle
+ * @see config_setUint32ByHandle for return values
+ */
+CfgRet_t config_setFloatByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, float value);
+/**
+ * Sets the bool value referred to by the handle
+ * @see config_setUint32ByHandle for return values
+ */
+CfgRet_t config_setBoolByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, bool value);
+/**
+ * Sets the uint64 value referred to by the handle
+ * @see config_setUint32ByHandle for return values
+ */
+CfgRet_t config_setUint64ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, uint64_t value);
+/**
+ * Sets the int64 value referred to by the handle
+ * @see config_setUint32ByHandle for return values
+ */
+CfgRet_t config_setInt64ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, int64_t value);
+/**
+ * Sets the double value referred to by the handle
+ * @see config_setUint32ByHandle for return values
+ */
+CfgRet_t config_setDoubleByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, double value);
+/**
+ * Sets the string referred to by the handle
+ * @param cfg [INOUT] Configuration table
+ * @param handle [IN] Handle resolved by config_getHandle
+ * @param str [IN] Null-terminated string
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or str are NULL
+ * @return CFG_RC_ERROR_INVALID if the handle is stale
+ * @return CFG_RC_ERROR_TYPE_MISMATCH if the handle was not resolved for this type
+ * @return CFG_RC_ERROR_TOO_LARGE if the string does not fit into the allocated memory
+ * @return CFG_RC_ERROR_READ_ONLY if the setting to change is read-only
+ */
+CfgRet_t config_setStringByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, const char* str);
+
+/**
+ * Batch access
+ * ===================================================================
+ * Reads or writes many entries with one call. The table is validated once per batch and
+ * every item only compares its handle against the table generation and type.
+ */
+
+typedef struct {
+    // Entry to access, resolved by config_getHandle or config_getHandleByIdx
+    ConfigHandle_t handle;
+    // Destination for config_getBatch, source for config_setBatch
+    void* value;
+    // Size of value in bytes. Strings are read into and written from buffers of this size,
+    // other types need at least the size of the entry for reading
+    uint32_t size;
+    // Result of the access to this item
+    CfgRet_t result;
+} ConfigBatchItem_t;
+
+/**
+ * Reads the values of all items
+ * @param cfg [IN] Configuration table
+ * @param items [INOUT] Items to read. The result member of every item is set
+ * @param count [IN] Number of items
+ * @return CFG_RC_SUCCESS if all items have been read
+ * @return CFG_RC_ERROR_NULLPTR if cfg or items are NULL
+ * @return CFG_RC_ERROR_INCOMPLETE if any item could not be read. The result of such items is
+ *  CFG_RC_ERROR_NULLPTR, CFG_RC_ERROR_INVALID, CFG_RC_ERROR_TYPE_MISMATCH or CFG_RC_ERROR_TOO_LARGE
+ *  like for the handle based getters
+ */
+CfgRet_t config_getBatch(const ConfigTable_t* cfg, ConfigBatchItem_t* items, uint32_t count);
+
+/**
+ * Writes the values of all items. Changes are notified as one batch if a notifier is attached
+ * @param cfg [INOUT] Configuration table
+ * @param items [INOUT] Items to write. The result member of every item is set
+ * @param count [IN] Number of items
+ * @return CFG_RC_SUCCESS if all items have been written
+ * @return CFG_RC_ERROR_NULLPTR if cfg or items are NULL
+ * @return CFG_RC_ERROR_INCOMPLETE if any item could not be written. Other items have still been written.
+ *  The result of such items is any error of the handle based setters or of config_logAppend
+ */
+CfgRet_t config_setBatch(ConfigTable_t* cfg, ConfigBatchItem_t* items, uint32_t count);
+
+/**
+ * Dirty tracking
+ * ===================================================================
+ * With a dirty bitmap attached, every write through the setter and parsing functions
+ * which changes a value marks the entry as dirty. config_saveDirty uses these bits
+ * to skip saving entirely or to rewrite only the lines of the changed entries.
+ */
+
+/**
+ * Attaches a dirty bitmap to the table and clears it.
+ * @param cfg [INOUT] Configuration table
+ * @param bitmap [IN] User-provided storage of word_count words. Pass NULL to disable dirty tracking
+ * @param word_count [IN] Number of words in bitmap. Use CFG_DIRTY_WORD_COUNT to determine a sufficient size
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if the bitmap has fewer bits than the table has entries
+ */
+CfgRet_t config_enableDirtyTracking(ConfigTable_t* cfg, uint32_t* bitmap, uint32_t word_count);
+
+/**
+ * Returns true if the entry has been changed since the dirty state was last cleared
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return false if cfg is NULL, idx is out of range or dirty tracking is disabled
+ */
+bool config_isDirty(const ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Returns the number of dirty entries
+ * @param cfg [IN] Configuration table
+ * @return number of dirty entries or 0 if cfg is NULL or dirty tracking is disabled
+ */
+uint32_t config_getDirtyCount(const ConfigTable_t* cfg);
+
+/**
+ * Marks an entry as dirty. Needed after writing to a value variable directly
+ * @param cfg [INOUT] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg is NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ * @return CFG_RC_ERROR_INVALID if dirty tracking is disabled
+ */
+CfgRet_t config_markDirty(ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Clears the dirty state of a single entry
+ * @see config_markDirty for return values
+ */
+CfgRet_t config_clearDirty(ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Clears the dirty state of all entries
+ * @param cfg [INOUT] Configuration table
+ */
+void config_clearAllDirty(ConfigTable_t* cfg);
+
 /**
  * Storage and parsing
  * ===================================================================
  */
 
+/**
+ * Parses a value string into the configuration entry with the given key.
+ * Neither key nor value need to be null-terminated, which allows parsing
+ * key and value spans directly from a larger buffer.
+ * @param cfg [INOUT] Configuration table
+ * @param key [IN] Key without surrounding whitespace
+ * @param key_len [IN] Number of characters in key
+ * @param value [IN] Value without surrounding whitespace. The character at value[value_len]
+ *  is overwritten with a null-terminator during parsing
+ * @param value_len [IN] Number of characters in value
+ * @return same as config_parseKVStr, CFG_RC_ERROR_FORMAT is only returned for malformed values
+ */
+CfgRet_t config_parseKV(ConfigTable_t* cfg, const char* key, uint32_t key_len, char* value, uint32_t value_len);
+
 /**
  * Attempt to parse a key-value string into a configuration entry
  * with a matching key and type.
@@ -289,50 +825,174 @@ CfgRet_t config_getBoolByIdx(const ConfigTable_t* cfg, uint32_t idx, bool* value
  *
  * @note Parsing of booleans is done by checking the first character
  *  of the boolean value string for the characters 'T' 't' 'F' 'f' '1' '0'
+ * @note Array elements are parsed directly into a scratch buffer of the entry size and
+ *  written with a single config_setByIdx, so a malformed array leaves the entry unchanged
  * @param len [IN] size of str string including null-terminator
+ * @note Numbers are parsed with config_parseUint32 and its siblings for the entry type,
+ *  so they are locale-independent and may be given in hexadecimal ("0x1F") or binary ("0b101")
  * @return CFG_RC_SUCCESS on success
- * @return CFG_RC_ERROR if parsing of value failed
+ * @return CFG_RC_ERROR if parsing of a boolean value failed
+ * @return CFG_RC_ERROR_RANGE if a number does not fit into the entry type
  * @return CFG_RC_ERROR_INVALID if the entry with a matching key has no type associated with it
  * @return CFG_RC_ERROR_NULLPTR if cfg or str is NULL
- * @return CFG_RC_ERROR_FORMAT if the separator between key and value was not found
+ * @return CFG_RC_ERROR_FORMAT if the separator between key and value was not found,
+ *  a number is malformed or followed by other characters,
+ *  or an array element is missing or followed by anything but a comma
+ * @return CFG_RC_ERROR_TOO_LARGE if an array has more elements than the entry can hold
  * @return CFG_RC_ERROR_UNKNOWN_KEY if the key provided in str was not found
  * @return any error caused by config_setByIdx
  */
 CfgRet_t config_parseKVStr(ConfigTable_t* cfg, char* str, uint32_t len);
 
 /**
- * Attempts to read configuration entries from a file
+ * Parses a buffer containing multiple "key: value" lines in place.
+ * Lines are terminated by '\n' and may have any length. Empty lines are skipped.
+ * The buffer is split into key and value spans with the tokenizer from config_tokenizer.h.
+ * Values are null-terminated in place during parsing.
+ * @param cfg [INOUT] Configuration table
+ * @param buf [INOUT] Buffer with the lines to parse. Must provide space for
+ *  one additional character at buf[len]
+ * @param len [IN] Number of characters in buf
+ * @param on_error [IN] Function called for every line that could not be parsed. May be NULL
+ * @param ctx [IN] User context passed to on_error
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or buf are NULL
+ * @return CFG_RC_ERROR_INCOMPLETE if any line could not be parsed. Other lines have still been parsed.
+ */
+CfgRet_t config_parseBuffer(ConfigTable_t* cfg, char* buf, uint32_t len, parseErrorFunc on_error, void* ctx);
+
+/**
+ * Reads the whole file with a single read call and parses it in place with config_parseBuffer.
+ * Unlike the default load function this has no limit on the line length.
  * @param cfg [INOUT] Configuration table where matching key-value pairs will be stored
  * @param filename [IN] Name of the file to read for config values
+ * @param on_error [IN] Function called for every line that could not be parsed. May be NULL
+ * @param ctx [IN] User context passed to on_error
  * @return CFG_RC_SUCCESS on success
  * @return CFG_RC_ERROR_NULLPTR if cfg or filename are NULL
- * @return CFG_RC_ERROR if the file could not be opened
+ * @return CFG_RC_ERROR if the file could not be opened or read
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the file contents could be allocated
  * @return CFG_RC_ERROR_INCOMPLETE if there was an entry in the file which could not be matched
  *  to a configuration entry. Other entries have still been loaded.
  */
+CfgRet_t config_loadFromFileBuffered(ConfigTable_t* cfg, const char* filename, parseErrorFunc on_error, void* ctx);
+
+/**
+ * Load function using config_loadFromFileBuffered without error reporting.
+ * Can be passed to config_setSaveLoadFunctions to replace the default load function.
+ */
+CfgRet_t config_bufferedLoadFunc(ConfigTable_t* cfg, const char* filename);
+
+/**
+ * Attempts to read configuration entries from a file.
+ * Uses the load function of the io context of the table if one is set.
+ * If a notifier is attached, all changed entries are notified as one batch after loading
+ * @param cfg [INOUT] Configuration table where matching key-value pairs will be stored
+ * @param filename [IN] Name of the file to read for config values
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or filename are NULL
+ * @return CFG_RC_ERROR if the file could not be opened
+ * @return CFG_RC_ERROR_INCOMPLETE if there was an entry in the file which could not be matched
+ *  to a configuration entry or a line was longer than FILE_MAX_LINE_LEN. Other entries have still been loaded.
+ */
 CfgRet_t config_loadFromFile(ConfigTable_t* cfg, const char* filename);
+/**
+ * Returns an upper bound for the number of characters needed by config_formatTable
+ * @param cfg [IN] Configuration table
+ * @return buffer size in bytes or 0 if cfg is NULL
+ */
+uint32_t config_getFormattedSize(const ConfigTable_t* cfg);
+
+/**
+ * Returns an upper bound for the number of characters needed by config_formatEntry
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @return buffer size in bytes or 0 if the entry does not exist or is not saved
+ */
+uint32_t config_getFormattedEntrySize(const ConfigTable_t* cfg, uint32_t idx);
+
+/**
+ * Formats a single configuration entry as "key: value" line including the line ending
+ * @param cfg [IN] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param buf [OUT] Output buffer. The result is not null-terminated
+ * @param buf_size [IN] Size of buf. Use config_getFormattedEntrySize to get a sufficient size
+ * @param len [OUT] Number of characters written
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, buf or len are NULL
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ * @return CFG_RC_ERROR_INVALID if the entry has a type which is not saved
+ * @return CFG_RC_ERROR_TOO_LARGE if buf is too small
+ */
+CfgRet_t config_formatEntry(const ConfigTable_t* cfg, uint32_t idx, char* buf, uint32_t buf_size, uint32_t* len);
+
+/**
+ * Formats all configuration entries as "key: value" lines into a single buffer.
+ * Numbers are formatted without printf. Floats are written with the shortest
+ * representation that parses back to the same value.
+ * @param cfg [IN] Configuration table
+ * @param buf [OUT] Output buffer. The result is not null-terminated
+ * @param buf_size [IN] Size of buf. Use config_getFormattedSize to get a sufficient size
+ * @param len [OUT] Number of characters written
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg, buf or len are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if buf is too small. len contains the number of characters
+ *  of all complete lines written until then
+ * @return CFG_RC_ERROR_INCOMPLETE if any line was skipped because it was longer than the line buffer
+ *  of the default load function. The line buffer is defined by FILE_MAX_LINE_LEN and can be
+ *  overwritten using a compiler flag
+ */
+CfgRet_t config_formatTable(const ConfigTable_t* cfg, char* buf, uint32_t buf_size, uint32_t* len);
+
 /**
  * Attempts to save configuration entries to a file
  *
- * @note This function can be overwritten with a custom implementation
+ * @note This function can be overwritten with a custom implementation, per table with an io context
+ *  or for all other tables with config_setSaveLoadFunctions. The default implementation formats all entries with config_formatTable and
+ *  writes the result with a single call
  * @warning The contents of the target file will be overwritten if it already exists
  * @param cfg [IN] Configuration table
  * @param filename [IN] Name of the file where config entries should be stored
  * @return CFG_RC_SUCCESS on success
  * @return CFG_RC_ERROR_NULLPTR if cfg or filename are NULL
- * @return CFG_RC_ERROR if the file could not be opened
+ * @return CFG_RC_ERROR if the file could not be opened or written
+ * @return CFG_RC_ERROR_TOO_LARGE if the buffer for the file contents could not be allocated
  * @return CFG_RC_ERROR_INCOMPLETE if any config entry could not be written to the
  *  file due to its size being too large for the internal string buffer.
  *  The internal string buffer is defined by FILE_MAX_LINE_LEN and can be
  *  overwritten using a compiler flag
- * @return CFG_RC_ERROR_INVALID if an encoding error has occurred while using
- *  snprintf.
  */
 CfgRet_t config_saveToFile(const ConfigTable_t* cfg, const char* filename);
 
+/**
+ * Saves only the entries which changed since the last save.
+ * Does nothing if no entry is dirty. Otherwise the lines of the dirty entries in the existing
+ * file are overwritten in place, padding values with spaces which are trimmed while parsing.
+ * Dirty entries without a line in the file are appended. Only the modified part of the file is written.
+ * If a new value does not fit into its existing line or the file cannot be opened,
+ * the whole table is saved with config_saveToFile instead.
+ * The dirty state of all saved entries is cleared.
+ * @note Without dirty tracking, this is the same as config_saveToFile.
+ *  In-place updates use stdio and are only done if the table is saved with the default save function.
+ *  With any other save function of the table or set by config_setSaveLoadFunctions,
+ *  the whole table is saved with config_saveToFile
+ * @param cfg [INOUT] Configuration table
+ * @param filename [IN] Name of the file where config entries should be stored
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if cfg or filename are NULL
+ * @return CFG_RC_ERROR if the file could not be read or written
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the file contents could be allocated
+ * @return CFG_RC_ERROR_INCOMPLETE if any appended line would have been longer than FILE_MAX_LINE_LEN.
+ *  These entries stay dirty
+ * @return any error of config_saveToFile if the whole table was saved
+ */
+CfgRet_t config_saveDirty(ConfigTable_t* cfg, const char* filename);
+
 /**
  * Sets a new function for saving and loading configuration data to and from
- * files.
+ * files. The functions are used by all tables without an io context.
+ * @note Not thread-safe. Set the functions before any table is saved or loaded, or use ConfigIo_t instead
  * @param saveFunc [IN] Pointer to the new save function. Pass NULL to reset
  *  to default function
  * @param loadFunc [IN] Pointer to the new load function. Pass NULL to reset
@@ -0,0 +1,234 @@
+#ifndef CONFIG_TABLE_HPP
+#define CONFIG_TABLE_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "config_table.h"
+
+/**
+ * Header-only C++17 layer for building configuration tables at compile time.
+ *
+ * A Schema holds the configuration entries as a constexpr object. Constructing it in a
+ * constant expression fails to compile if two entries share the same key.
+ * Keys known at compile time can be resolved to constant indices with CFG_KEY_IDX,
+ * so accesses compile down to a direct call of the *ByIdx functions without any string handling.
+ *
+ * @code
+ * inline constexpr auto schema = cfgtable::makeSchema(
+ *     CFG_TABLE_ENTRY(cfg.wifi.ssid),
+ *     CFG_TABLE_ENTRY(cfg.baud_rate)
+ * );
+ * auto config_entries = schema.entries;
+ * ConfigTable_t config_table = cfgtable::makeTable(config_entries);
+ *
+ * config_getUint32ByIdx(&config_table, CFG_KEY_IDX(schema, "cfg.baud_rate"), &baud_rate);
+ * @endcode
+ */
+
+/**
+ * Creates a configuration entry for the given variable and uses the
+ * variable expression itself as the key, e.g. "cfg.baud_rate"
+ */
+#define CFG_TABLE_ENTRY(var) (cfgtable::entry(#var, var))
+
+/**
+ * Same as CFG_TABLE_ENTRY but with the given permissions
+ */
+#define CFG_TABLE_ENTRY_PERM(var, perm) (cfgtable::entry(#var, var, perm))
+
+/**
+ * Resolves a key to the index of its entry at compile time.
+ * Fails to compile if the key does not exist in the schema
+ */
+#define CFG_KEY_IDX(schema, key) (std::integral_constant<uint32_t, (schema).indexOf(key)>::value)
+
+/**
+ * Same as CFG_KEY_IDX but additionally fails to compile if the entry does not have the given type
+ */
+#define CFG_KEY_IDX_TYPED(schema, key, type) (std::integral_constant<uint32_t, (schema).indexOf(key, type)>::value)
+
+namespace cfgtable {
+
+namespace detail {
+// These functions are intentionally not constexpr. Reaching them during
+// constant evaluation aborts the compilation with their name in the error message.
+inline void duplicate_key_in_config_schema() {}
+inline void unknown_key_in_config_schema() {}
+inline void type_mismatch_in_config_schema() {}
+
+constexpr bool keyEquals(const char* a, const char* b) {
+    while(*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+// Same ordering as strcmp
+constexpr bool keyLess(const char* a, const char* b) {
+    while(*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+    return static_cast<unsigned char>(*a) < static_cast<unsigned char>(*b);
+}
+
+template <typename T>
+struct TypeOf {
+    static constexpr ConfigType_t value = CONFIG_NONE;
+};
+template <>
+struct TypeOf<uint32_t> {
+    static constexpr ConfigType_t value = CONFIG_UINT32;
+};
+template <>
+struct TypeOf<int32_t> {
+    static constexpr ConfigType_t value = CONFIG_INT32;
+};
+template <>
+struct TypeOf<float> {
+    static constexpr ConfigType_t value = CONFIG_FLOAT;
+};
+template <>
+struct TypeOf<bool> {
+    static constexpr ConfigType_t value = CONFIG_BOOL;
+};
+template <>
+struct TypeOf<uint64_t> {
+    static constexpr ConfigType_t value = CONFIG_UINT64;
+};
+template <>
+struct TypeOf<int64_t> {
+    static constexpr ConfigType_t value = CONFIG_INT64;
+};
+template <>
+struct TypeOf<double> {
+    static constexpr ConfigType_t value = CONFIG_DOUBLE;
+};
+template <std::size_t N>
+struct TypeOf<char[N]> {
+    static constexpr ConfigType_t value = CONFIG_STRING;
+};
+template <std::size_t N>
+struct TypeOf<uint32_t[N]> {
+    static constexpr ConfigType_t value = CONFIG_UINT32_ARRAY;
+};
+template <std::size_t N>
+struct TypeOf<int32_t[N]> {
+    static constexpr ConfigType_t value = CONFIG_INT32_ARRAY;
+};
+template <std::size_t N>
+struct TypeOf<float[N]> {
+    static constexpr ConfigType_t value = CONFIG_FLOAT_ARRAY;
+};
+template <std::size_t N>
+struct TypeOf<uint64_t[N]> {
+    static constexpr ConfigType_t value = CONFIG_UINT64_ARRAY;
+};
+template <std::size_t N>
+struct TypeOf<int64_t[N]> {
+    static constexpr ConfigType_t value = CONFIG_INT64_ARRAY;
+};
+template <std::size_t N>
+struct TypeOf<double[N]> {
+    static constexpr ConfigType_t value = CONFIG_DOUBLE_ARRAY;
+};
+}  // namespace detail
+
+/**
+ * Creates a configuration entry for the given variable.
+ * Type and size of the entry are derived from the type of the variable.
+ * @param key [IN] Configuration key string
+ * @param value [IN] Variable with static storage duration which holds the configuration value
+ * @param perm [IN] Permissions of the entry
+ */
+template <typename T>
+constexpr ConfigEntry_t entry(const char* key, T& value, CfgPermissions_t perm = CFG_PERM_RW) {
+    static_assert(detail::TypeOf<T>::value != CONFIG_NONE, "Unsupported configuration value type");
+    return ConfigEntry_t{key, detail::TypeOf<T>::value, &value, sizeof(T), perm};
+}
+
+/**
+ * Compile time description of a configuration table with N entries
+ */
+template <std::size_t N>
+struct Schema {
+    std::array<ConfigEntry_t, N> entries;
+
+    constexpr explicit Schema(const std::array<ConfigEntry_t, N>& e) : entries(e) {
+        for(std::size_t i = 0; i < N; i++) {
+            for(std::size_t j = i + 1; j < N; j++) {
+                if(detail::keyEquals(entries[i].key, entries[j].key)) detail::duplicate_key_in_config_schema();
+            }
+        }
+    }
+
+    /**
+     * Returns the index of the entry with the given key
+     * @param key [IN] Configuration key string
+     * @param expected_type [IN] Type the entry must have. Pass CONFIG_NONE to skip the check
+     */
+    constexpr uint32_t indexOf(const char* key, ConfigType_t expected_type = CONFIG_NONE) const {
+        for(std::size_t i = 0; i < N; i++) {
+            if(detail::keyEquals(entries[i].key, key)) {
+                if(expected_type != CONFIG_NONE && entries[i].type != expected_type) {
+                    detail::type_mismatch_in_config_schema();
+                }
+                return static_cast<uint32_t>(i);
+            }
+        }
+        detail::unknown_key_in_config_schema();
+        return UINT32_MAX;
+    }
+
+    /**
+     * Returns true if an entry with the given key exists
+     */
+    constexpr bool contains(const char* key) const {
+        for(std::size_t i = 0; i < N; i++) {
+            if(detail::keyEquals(entries[i].key, key)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Returns true if the entries are sorted by key. Such tables can be marked as sorted
+     * without calling config_sortTable at runtime
+     */
+    constexpr bool isSorted() const {
+        for(std::size_t i = 1; i < N; i++) {
+            if(!detail::keyLess(entries[i - 1].key, entries[i].key)) return false;
+        }
+        return true;
+    }
+
+    static constexpr std::size_t size() { return N; }
+};
+
+/**
+ * Builds a schema from a list of configuration entries.
+ * Declare the result constexpr to check for duplicate keys at compile time
+ */
+template <typename... Entries>
+constexpr Schema<sizeof...(Entries)> makeSchema(const Entries&... entries) {
+    static_assert((std::is_same_v<Entries, ConfigEntry_t> && ...), "Schema entries must be of type ConfigEntry_t");
+    return Schema<sizeof...(Entries)>(std::array<ConfigEntry_t, sizeof...(Entries)>{entries...});
+}
+
+/**
+ * Creates a configuration table which refers to the given entries
+ * @param entries [IN] Mutable copy of the entries of a schema
+ */
+template <std::size_t N>
+ConfigTable_t makeTable(std::array<ConfigEntry_t, N>& entries) {
+    ConfigTable_t table{};
+    table.entries = entries.data();
+    table.count = static_cast<uint32_t>(N);
+    return table;
+}
+
+}  // namespace cfgtable
+
+#endif  // CONFIG_TABLE_HPP
@@ -0,0 +1,71 @@
+#ifndef CONFIG_TOKENIZER_H
+#define CONFIG_TOKENIZER_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CFG_TOKENIZER_SIMD
+    // If set to 1 the tokenizer uses SSE2 or AVX2 instructions when the compiler targets them.
+    // Set to 0 to force the portable scalar implementation
+    #define CFG_TOKENIZER_SIMD (1)
+#endif
+
+/**
+ * Key and value span of a single line in the "key: value" text format.
+ * Offsets are relative to the start of the tokenized buffer and spans exclude
+ * surrounding whitespace. Lines without any non-whitespace characters produce no span.
+ */
+typedef struct {
+    uint32_t key_offset;
+    uint32_t key_len;
+    uint32_t value_offset;
+    uint32_t value_len;
+    // Line number starting at 1
+    uint32_t line;
+    // False if the line contains no separator. In that case the key span covers the whole line
+    bool has_separator;
+} ConfigKVSpan_t;
+
+/**
+ * Tokenizer state for splitting a buffer into key and value spans in multiple steps
+ */
+typedef struct {
+    const char* buf;
+    uint32_t len;
+    uint32_t pos;
+    uint32_t line;
+} ConfigTokenizer_t;
+
+/**
+ * Initializes a tokenizer for the given buffer
+ * @param tokenizer [OUT] Tokenizer state
+ * @param buf [IN] Buffer with lines in the "key: value" format. Lines are terminated by '\n'
+ * @param len [IN] Number of characters in buf
+ */
+void config_tokenizerInit(ConfigTokenizer_t* tokenizer, const char* buf, uint32_t len);
+
+/**
+ * Scans the buffer for line endings and separators in one pass and writes one
+ * span per non-empty line until either the buffer is exhausted or max_spans spans were written.
+ * @param tokenizer [INOUT] Tokenizer state
+ * @param spans [OUT] Array of at least max_spans spans
+ * @param max_spans [IN] Maximum number of spans to write
+ * @param span_count [OUT] Number of spans written
+ * @return CFG_RC_SUCCESS if the whole buffer has been tokenized
+ * @return CFG_RC_ERROR_INCOMPLETE if the span array is full and the buffer has remaining lines.
+ *  Call again to continue with the next line
+ * @return CFG_RC_ERROR_NULLPTR if tokenizer, spans or span_count are NULL
+ * @return CFG_RC_ERROR_RANGE if max_spans is 0
+ */
+CfgRet_t config_tokenizerNext(ConfigTokenizer_t* tokenizer, ConfigKVSpan_t* spans, uint32_t max_spans,
+                              uint32_t* span_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_TOKENIZER_H
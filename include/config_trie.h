@@ -0,0 +1,124 @@
+#ifndef CONFIG_TRIE_H
+#define CONFIG_TRIE_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Key trie
+ * ===================================================================
+ * Optional index over the dot-separated segments of the keys, e.g. "cfg", "wifi" and "ssid" for
+ * "cfg.wifi.ssid". Every node stands for one path and refers to the entry with exactly that key, if any.
+ * The children of a node are stored next to each other in segment order and are found by binary search.
+ *
+ * Building the trie also sorts the entry indices by segments, so all entries below a path are adjacent.
+ * Prefix queries therefore return a slice of that order without copying or visiting other entries.
+ *
+ * All storage is provided by the user. The trie refers to the keys of the table and has to be rebuilt if
+ * keys are changed. Changes which invalidate handles, e.g. config_sortTable, are detected and make all
+ * queries fail until the trie is rebuilt.
+ */
+
+typedef struct {
+    // Length of the last segment of the path and of the whole path
+    uint32_t segment_len;
+    uint32_t path_len;
+    // Index of the entry with exactly this path or -1 if there is none
+    int32_t entry;
+    // Children, stored consecutively in segment order
+    uint32_t first_child;
+    uint32_t child_count;
+    // Range of the order array with all entries at or below this path
+    uint32_t first;
+    uint32_t last;
+} ConfigTrieNode_t;
+
+typedef struct {
+    // User-provided storage, see config_trieNodeCount
+    ConfigTrieNode_t* nodes;
+    uint32_t node_capacity;
+    // User-provided storage with one element per entry. Entry indices sorted by key segments after building
+    uint32_t* order;
+
+    // Managed by the config_trie* functions
+    const ConfigTable_t* cfg;
+    uint32_t node_count;
+    uint32_t generation;
+} ConfigTrie_t;
+
+/**
+ * Returns a number of nodes which is sufficient for the trie of the table
+ * @param cfg [IN] Configuration table
+ * @return one node for the root plus one for every segment of every key. 0 if cfg is NULL
+ */
+uint32_t config_trieNodeCount(const ConfigTable_t* cfg);
+
+/**
+ * Builds the trie over the keys of the table
+ * @note If the table contains duplicate keys, only the entry with the lowest index is found by exact lookups,
+ *  prefix queries return all of them
+ * @param trie [INOUT] Trie with user-provided node and order storage
+ * @param cfg [IN] Configuration table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if trie, cfg or the storage are NULL
+ * @return CFG_RC_ERROR_TOO_LARGE if the trie has not enough nodes
+ */
+CfgRet_t config_trieBuild(ConfigTrie_t* trie, const ConfigTable_t* cfg);
+
+/**
+ * Searches for the given key in the trie
+ * @param trie [IN] Trie built for the table
+ * @param key [IN] Configuration key
+ * @return Index of configuration entry matching the key or -1 if no matching key was found or the trie is outdated
+ */
+int32_t config_trieGetIdx(const ConfigTrie_t* trie, const char* key);
+
+/**
+ * Searches for the key made of the given segments, e.g. {"cfg", "wifi", "ssid"} for "cfg.wifi.ssid",
+ * without building the key string
+ * @param trie [IN] Trie built for the table
+ * @param segments [IN] Path segments without separators
+ * @param segment_count [IN] Number of segments
+ * @return Index of configuration entry matching the path or -1 if no matching key was found or the trie is outdated
+ */
+int32_t config_trieGetIdxFromPath(const ConfigTrie_t* trie, const char* const* segments, uint32_t segment_count);
+
+/**
+ * Returns the indices of all entries whose key equals the prefix or continues it with further segments,
+ * e.g. "cfg.wifi" and all "cfg.wifi.*" entries for the prefix "cfg.wifi", but not "cfg.wifi2"
+ * @param trie [IN] Trie built for the table
+ * @param prefix [IN] Key prefix consisting of complete segments
+ * @param indices [OUT] Entry indices sorted by key segments. Points into the order storage of the trie
+ * @param count [OUT] Number of indices
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if any parameter is NULL
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if no key starts with the prefix
+ * @return CFG_RC_ERROR_INVALID if the trie has not been built or is outdated
+ */
+CfgRet_t config_trieGetPrefix(const ConfigTrie_t* trie, const char* prefix, const uint32_t** indices, uint32_t* count);
+
+/**
+ * Same as config_trieGetPrefix with the prefix given as path segments.
+ * Without segments, all entries of the table are returned
+ * @param trie [IN] Trie built for the table
+ * @param segments [IN] Path segments without separators. May be NULL if segment_count is 0
+ * @param segment_count [IN] Number of segments
+ * @param indices [OUT] Entry indices sorted by key segments. Points into the order storage of the trie
+ * @param count [OUT] Number of indices
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if trie, indices or count are NULL or segments is NULL while segment_count is not 0
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if no key starts with the path
+ * @return CFG_RC_ERROR_INVALID if the trie has not been built or is outdated
+ */
+CfgRet_t config_trieGetPrefixFromPath(const ConfigTrie_t* trie, const char* const* segments, uint32_t segment_count,
+                                      const uint32_t** indices, uint32_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_TRIE_H
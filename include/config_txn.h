@@ -0,0 +1,109 @@
+#ifndef CONFIG_TXN_H
+#define CONFIG_TXN_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Multi-key transactions
+ * ===================================================================
+ * Writes are staged in user-provided storage and applied together by config_txnCommit.
+ * All staged writes are validated before the first value is changed, so either all of them
+ * are applied or none. Committing results in one notification batch, one record write to an
+ * attached change log and the dirty bits of all changed entries, so a single save persists them.
+ *
+ * Commits are not atomic for concurrent readers of the table. Publish a snapshot with
+ * config_rcuPublish after committing if readers need a consistent view.
+ */
+
+typedef struct {
+    uint32_t idx;
+    // Position of the staged value in the value buffer
+    uint32_t offset;
+    uint32_t size;
+} ConfigStagedWrite_t;
+
+typedef struct {
+    // User-provided storage for the staged writes
+    ConfigStagedWrite_t* writes;
+    uint32_t write_capacity;
+    // User-provided storage for the staged values
+    uint8_t* buffer;
+    uint32_t buffer_size;
+    // User-provided storage with write_capacity elements for the indices of changed entries.
+    // Only needed to commit while a change log is attached
+    uint32_t* changed;
+
+    // Managed by the config_txn* functions
+    ConfigTable_t* cfg;
+    uint32_t write_count;
+    uint32_t buffer_used;
+    // Table generation at the start of the transaction
+    uint32_t generation;
+    // First error returned while staging
+    CfgRet_t error;
+} ConfigTxn_t;
+
+/**
+ * Starts a transaction. The storage members have to be set before
+ * @param txn [INOUT] Transaction with user-provided storage
+ * @param cfg [IN] Configuration table
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if txn, cfg or any storage pointer are NULL
+ */
+CfgRet_t config_txnBegin(ConfigTxn_t* txn, ConfigTable_t* cfg);
+
+/**
+ * Stages a write by index. Staging an entry again replaces its staged value.
+ * A failed call also makes config_txnCommit fail, so no write of the transaction is applied
+ * @param txn [INOUT] Transaction
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [IN] Value to be written
+ * @param size [IN] Size of the value in bytes
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if txn or value are NULL or the transaction was not started
+ * @return CFG_RC_ERROR_RANGE if the given index was larger than the
+ *  number of entries in the configuration table
+ * @return CFG_RC_ERROR_READ_ONLY if the entry is read-only
+ * @return CFG_RC_ERROR_TOO_LARGE if the value is larger than the entry or the staging storage is full
+ */
+CfgRet_t config_txnSetByIdx(ConfigTxn_t* txn, uint32_t idx, const void* value, uint32_t size);
+
+/**
+ * Stages a write by key, see config_txnSetByIdx
+ * @param txn [INOUT] Transaction
+ * @param key [IN] Configuration key
+ * @param value [IN] Value to be written
+ * @param size [IN] Size of the value in bytes
+ * @return any return value of config_txnSetByIdx
+ * @return CFG_RC_ERROR_UNKNOWN_KEY if the key does not exist
+ */
+CfgRet_t config_txnSetByKey(ConfigTxn_t* txn, const char* key, const void* value, uint32_t size);
+
+/**
+ * Validates and applies all staged writes and ends the transaction
+ * @param txn [INOUT] Transaction
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_NULLPTR if txn is NULL, the transaction was not started or a change log is attached
+ *  but changed is NULL. Nothing has been applied
+ * @return CFG_RC_ERROR_INVALID if the table was sorted since config_txnBegin. Nothing has been applied
+ * @return the first error of staging a write. Nothing has been applied
+ * @return any error of config_logAppendEntries if a change log is attached. All values have still been set
+ */
+CfgRet_t config_txnCommit(ConfigTxn_t* txn);
+
+/**
+ * Discards all staged writes and ends the transaction
+ * @param txn [INOUT] Transaction
+ */
+void config_txnAbort(ConfigTxn_t* txn);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // CONFIG_TXN_H
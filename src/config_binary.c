@@ -0,0 +1,260 @@
+#include "config_binary.h"
+#include "config_internal.h"
+#include "config_stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BINARY_MAGIC ("CFGB")
+#define BINARY_BYTE_ORDER_MARK (0x0102)
+// Offset of the checksum in the header. The checksum covers everything but itself
+#define BINARY_CRC_OFFSET (24)
+// Type and size in front of every key in the schema section
+#define BINARY_SCHEMA_RECORD_SIZE (1 + 4)
+
+static void config_putUint16(uint8_t* buf, uint16_t value) {
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static void config_putUint32(uint8_t* buf, uint32_t value) {
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+}
+
+static uint16_t config_getUint16(const uint8_t* buf) {
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static uint32_t config_getUint32(const uint8_t* buf) {
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+// CRC-32 (IEEE 802.3) with a nibble table to keep the lookup table small
+static uint32_t config_crc32(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    crc = ~crc;
+    for(uint32_t i = 0; i < len; i++) {
+        crc = (crc >> 4) ^ table[(crc ^ buf[i]) & 0x0F];
+        crc = (crc >> 4) ^ table[(crc ^ (buf[i] >> 4)) & 0x0F];
+    }
+    return ~crc;
+}
+
+// Entries without a type are not part of the snapshot
+static bool config_isStoredEntry(const ConfigEntry_t* e) {
+    return e->type != CONFIG_NONE;
+}
+
+static uint32_t config_fnv1a(uint32_t hash, const uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len; i++) {
+        hash ^= buf[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t config_binaryFingerprint(const ConfigTable_t* cfg) {
+    if(cfg == NULL) return 0;
+    uint32_t hash = 2166136261u;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isStoredEntry(e)) continue;
+        // Same bytes as the schema record of the entry
+        uint8_t record[BINARY_SCHEMA_RECORD_SIZE];
+        record[0] = (uint8_t)e->type;
+        config_putUint32(record + 1, e->size);
+        hash = config_fnv1a(hash, record, sizeof(record));
+        hash = config_fnv1a(hash, (const uint8_t*)e->key, strlen(e->key) + 1);
+    }
+    return hash;
+}
+
+// Sizes of the schema and value sections
+static void config_binarySectionSizes(const ConfigTable_t* cfg, uint32_t* entry_count, uint32_t* schema_size,
+                                      uint32_t* values_size) {
+    *entry_count = 0;
+    *schema_size = 0;
+    *values_size = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isStoredEntry(e)) continue;
+        (*entry_count)++;
+        *schema_size += BINARY_SCHEMA_RECORD_SIZE + strlen(e->key) + 1;
+        *values_size += e->size;
+    }
+}
+
+uint32_t config_binaryGetSize(const ConfigTable_t* cfg) {
+    if(cfg == NULL) return 0;
+    uint32_t entry_count, schema_size, values_size;
+    config_binarySectionSizes(cfg, &entry_count, &schema_size, &values_size);
+    return CFG_BINARY_HEADER_SIZE + schema_size + values_size;
+}
+
+CfgRet_t config_binaryFormat(const ConfigTable_t* cfg, uint8_t* buf, uint32_t buf_size, uint32_t* len) {
+    if(cfg == NULL || buf == NULL || len == NULL) return CFG_RC_ERROR_NULLPTR;
+    uint32_t entry_count, schema_size, values_size;
+    config_binarySectionSizes(cfg, &entry_count, &schema_size, &values_size);
+    *len = 0;
+    if(buf_size < CFG_BINARY_HEADER_SIZE + schema_size + values_size) return CFG_RC_ERROR_TOO_LARGE;
+
+    memcpy(buf, BINARY_MAGIC, 4);
+    config_putUint16(buf + 4, CFG_BINARY_VERSION);
+    const uint16_t byte_order_mark = BINARY_BYTE_ORDER_MARK;
+    memcpy(buf + 6, &byte_order_mark, sizeof(byte_order_mark));
+    config_putUint32(buf + 8, config_binaryFingerprint(cfg));
+    config_putUint32(buf + 12, entry_count);
+    config_putUint32(buf + 16, schema_size);
+    config_putUint32(buf + 20, values_size);
+
+    uint8_t* schema = buf + CFG_BINARY_HEADER_SIZE;
+    uint8_t* values = schema + schema_size;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isStoredEntry(e)) continue;
+        const uint32_t key_size = strlen(e->key) + 1;
+        schema[0] = (uint8_t)e->type;
+        config_putUint32(schema + 1, e->size);
+        memcpy(schema + BINARY_SCHEMA_RECORD_SIZE, e->key, key_size);
+        schema += BINARY_SCHEMA_RECORD_SIZE + key_size;
+        config_copyValueByIdx(cfg, i, values, e->size);
+        values += e->size;
+    }
+
+    *len = CFG_BINARY_HEADER_SIZE + schema_size + values_size;
+    uint32_t crc = config_crc32(0, buf, BINARY_CRC_OFFSET);
+    crc = config_crc32(crc, buf + CFG_BINARY_HEADER_SIZE, schema_size + values_size);
+    config_putUint32(buf + BINARY_CRC_OFFSET, crc);
+    return CFG_RC_SUCCESS;
+}
+
+// Writes a stored value into the entry unless it is read-only
+static CfgRet_t config_binaryLoadValue(ConfigTable_t* cfg, uint32_t idx, const uint8_t* value, uint32_t size) {
+    const ConfigEntry_t* e = &(cfg->entries[idx]);
+    if(e->perm == CFG_PERM_RO || e->perm == CFG_PERM_SECRET_RO) return CFG_RC_SUCCESS;
+    // Strings may have been saved from a buffer with a different size
+    if(e->type == CONFIG_STRING && size > e->size) {
+        const uint8_t* end = memchr(value, '\0', size);
+        if(end == NULL || (uint32_t)(end - value) >= e->size) return CFG_RC_ERROR_TOO_LARGE;
+        size = (uint32_t)(end - value) + 1;
+    }
+    return config_setByIdx(cfg, idx, value, size);
+}
+
+// Matches every stored entry to the table by key
+static CfgRet_t config_binaryLoadByKey(ConfigTable_t* cfg, const uint8_t* schema, uint32_t schema_size,
+                                       const uint8_t* values, uint32_t values_size, uint32_t entry_count) {
+    bool parsing_error_occurred = false;
+    const uint8_t* const schema_end = schema + schema_size;
+    uint32_t value_offset = 0;
+    for(uint32_t i = 0; i < entry_count; i++) {
+        if(schema_end - schema < BINARY_SCHEMA_RECORD_SIZE + 1) return CFG_RC_ERROR_FORMAT;
+        const ConfigType_t type = (ConfigType_t)schema[0];
+        const uint32_t size = config_getUint32(schema + 1);
+        const char* key = (const char*)schema + BINARY_SCHEMA_RECORD_SIZE;
+        const char* key_end = memchr(key, '\0', schema_end - (const uint8_t*)key);
+        if(key_end == NULL || size > values_size - value_offset) return CFG_RC_ERROR_FORMAT;
+        schema = (const uint8_t*)key_end + 1;
+
+        const int32_t idx = config_getIdxFromKey(cfg, key);
+        CfgRet_t ret = CFG_RC_ERROR_UNKNOWN_KEY;
+        if(idx >= 0) {
+            const ConfigEntry_t* e = &(cfg->entries[idx]);
+            if(e->type != type || (type != CONFIG_STRING && e->size != size)) ret = CFG_RC_ERROR_TYPE_MISMATCH;
+            else ret = config_binaryLoadValue(cfg, idx, values + value_offset, size);
+        }
+        if(ret != CFG_RC_SUCCESS) parsing_error_occurred = true;
+        value_offset += size;
+    }
+    if(parsing_error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_binaryParse(ConfigTable_t* cfg, const uint8_t* buf, uint32_t len) {
+    if(cfg == NULL || buf == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(len < CFG_BINARY_HEADER_SIZE || memcmp(buf, BINARY_MAGIC, 4) != 0) return CFG_RC_ERROR_FORMAT;
+    if(config_getUint16(buf + 4) != CFG_BINARY_VERSION) return CFG_RC_ERROR_FORMAT;
+    uint16_t byte_order_mark;
+    memcpy(&byte_order_mark, buf + 6, sizeof(byte_order_mark));
+    if(byte_order_mark != BINARY_BYTE_ORDER_MARK) return CFG_RC_ERROR_FORMAT;
+    const uint32_t fingerprint = config_getUint32(buf + 8);
+    const uint32_t entry_count = config_getUint32(buf + 12);
+    const uint32_t schema_size = config_getUint32(buf + 16);
+    const uint32_t values_size = config_getUint32(buf + 20);
+    if(schema_size > len - CFG_BINARY_HEADER_SIZE || values_size != len - CFG_BINARY_HEADER_SIZE - schema_size) {
+        return CFG_RC_ERROR_FORMAT;
+    }
+    uint32_t crc = config_crc32(0, buf, BINARY_CRC_OFFSET);
+    crc = config_crc32(crc, buf + CFG_BINARY_HEADER_SIZE, schema_size + values_size);
+    if(crc != config_getUint32(buf + BINARY_CRC_OFFSET)) return CFG_RC_ERROR_INVALID;
+
+    const uint8_t* schema = buf + CFG_BINARY_HEADER_SIZE;
+    const uint8_t* values = schema + schema_size;
+    if(fingerprint != config_binaryFingerprint(cfg)) {
+        return config_binaryLoadByKey(cfg, schema, schema_size, values, values_size, entry_count);
+    }
+
+    // Same layout, so the values can be copied in table order
+    uint32_t expected_count, expected_schema_size, expected_values_size;
+    config_binarySectionSizes(cfg, &expected_count, &expected_schema_size, &expected_values_size);
+    if(entry_count != expected_count || values_size != expected_values_size) return CFG_RC_ERROR_FORMAT;
+    bool parsing_error_occurred = false;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isStoredEntry(e)) continue;
+        if(config_binaryLoadValue(cfg, i, values, e->size) != CFG_RC_SUCCESS) parsing_error_occurred = true;
+        values += e->size;
+    }
+    if(parsing_error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_binarySaveFunc(const ConfigTable_t* cfg, const char* filename) {
+    if(cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    const uint32_t buf_size = config_binaryGetSize(cfg);
+    uint8_t* buf = malloc(buf_size);
+    if(buf == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    uint32_t len = 0;
+    const CfgRet_t format_ret = config_binaryFormat(cfg, buf, buf_size, &len);
+    if(format_ret != CFG_RC_SUCCESS) {
+        free(buf);
+        return format_ret;
+    }
+
+    FILE* file_ptr = NULL;
+    file_ptr = fopen(filename, "wb");
+    if(file_ptr == NULL) {
+        free(buf);
+        return CFG_RC_ERROR;
+    }
+    const size_t written = fwrite(buf, 1, len, file_ptr);
+    const int close_ret = fclose(file_ptr);
+    free(buf);
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_WRITTEN, written);
+
+    if(written != len || close_ret != 0) return CFG_RC_ERROR;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_binaryLoadFunc(ConfigTable_t* cfg, const char* filename) {
+    if(cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    FILE* file_ptr = NULL;
+    file_ptr = fopen(filename, "rb");
+    if(file_ptr == NULL) return CFG_RC_ERROR;
+    char* buf = NULL;
+    uint32_t len = 0;
+    CfgRet_t ret = config_readFileContents(file_ptr, &buf, &len);
+    fclose(file_ptr);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, len);
+    ret = config_binaryParse(cfg, (const uint8_t*)buf, len);
+    free(buf);
+    return ret;
+}
@@ -0,0 +1,52 @@
+#ifndef CONFIG_INTERNAL_H
+#define CONFIG_INTERNAL_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <stdio.h>
+
+#include "config_table.h"
+
+/**
+ * Functions shared between the modules of the library. Not part of the public interface
+ */
+
+/**
+ * Writes a value like config_setByIdx but does not append it to an attached change log.
+ * Dirty bits and notifications are handled as usual
+ * @param cfg [INOUT] Configuration table
+ * @param idx [IN] Index of the configuration entry in the config table
+ * @param value [IN] Value to be written
+ * @param size [IN] Size of the value in bytes
+ * @param changed [OUT] Set if the write changed the stored value. Only determined if the table has dirty tracking,
+ *  a change log or a notifier, false otherwise
+ * @return any return value of config_setByIdx besides errors of the change log
+ */
+CfgRet_t config_setByIdxUnlogged(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size, bool* changed);
+
+/**
+ * Reads the remaining file from the start with a single read call. The buffer has one additional byte at the end,
+ * e.g. for terminating the last line, and has to be freed by the caller
+ * @param file_ptr [IN] Open file
+ * @param buf [OUT] Allocated buffer with the file contents
+ * @param len [OUT] Number of bytes read
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR if the file could not be read
+ * @return CFG_RC_ERROR_TOO_LARGE if no buffer for the file contents could be allocated
+ */
+CfgRet_t config_readFileContents(FILE* file_ptr, char** buf, uint32_t* len);
+
+/**
+ * Delivers pending notifications before config_sortTable reorders the entries, they refer to the old positions.
+ * If a dispatch is already running, the notifications are kept and config_notifyAfterReorder marks every entry
+ * @param cfg [INOUT] Configuration table
+ */
+void config_notifyBeforeReorder(ConfigTable_t* cfg);
+
+/**
+ * Looks up the entries of CFG_SUBSCRIBE_ENTRY subscriptions again after config_sortTable reordered the entries
+ * @param cfg [INOUT] Configuration table
+ */
+void config_notifyAfterReorder(ConfigTable_t* cfg);
+
+#endif  // CONFIG_INTERNAL_H
@@ -0,0 +1,252 @@
+#include "config_layer.h"
+#include "config_internal.h"
+#include "config_notify.h"
+#include "config_stats.h"
+#include "config_tokenizer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Values in the layer storage start at multiples of this alignment
+#define LAYER_VALUE_ALIGNMENT (8)
+
+#ifndef LAYER_PARSE_SPAN_COUNT
+    // Number of key-value spans tokenized at once by config_layerParseBuffer
+    #define LAYER_PARSE_SPAN_COUNT (64)
+#endif
+
+static uint32_t config_alignLayerValue(uint32_t offset) {
+    return (offset + LAYER_VALUE_ALIGNMENT - 1) & ~(uint32_t)(LAYER_VALUE_ALIGNMENT - 1);
+}
+
+static bool config_layerBit(const uint32_t* bitmap, uint32_t idx) {
+    return (bitmap[idx / 32] & (1u << (idx % 32))) != 0;
+}
+
+static void config_setLayerBit(uint32_t* bitmap, uint32_t idx) {
+    bitmap[idx / 32] |= 1u << (idx % 32);
+}
+
+static void config_clearLayerBit(uint32_t* bitmap, uint32_t idx) {
+    bitmap[idx / 32] &= ~(1u << (idx % 32));
+}
+
+// Offsets and sources are stored per entry index, so the entry order must not have changed since init
+static bool config_layerCurrent(const ConfigLayers_t* layers) {
+    return layers->generation == layers->cfg->generation;
+}
+
+static uint8_t* config_layerValue(const ConfigLayers_t* layers, uint32_t layer, uint32_t idx) {
+    return (uint8_t*)layers->layers[layer].values + layers->offsets[idx];
+}
+
+// Writes the value of the highest layer setting the entry to the table
+static CfgRet_t config_layerApply(ConfigLayers_t* layers, uint32_t idx) {
+    uint32_t layer = layers->layer_count - 1;
+    // Layer 0 sets every entry
+    while(layer > 0 && !config_layerBit(layers->layers[layer].present, idx)) layer--;
+    layers->sources[idx] = (uint8_t)layer;
+    return config_setByIdx(layers->cfg, idx, config_layerValue(layers, layer, idx), layers->cfg->entries[idx].size);
+}
+
+// Updates the effective value after a layer set the entry
+static CfgRet_t config_layerChanged(ConfigLayers_t* layers, uint32_t layer, uint32_t idx) {
+    // Higher layers setting the entry still win
+    if(layer < layers->sources[idx]) return CFG_RC_SUCCESS;
+    return config_layerApply(layers, idx);
+}
+
+// Removes an entry from a layer and falls back to the next lower layer if the layer provided the value
+static CfgRet_t config_layerRemove(ConfigLayers_t* layers, uint32_t layer, uint32_t idx) {
+    config_clearLayerBit(layers->layers[layer].present, idx);
+    if(layers->sources[idx] != layer) return CFG_RC_SUCCESS;
+    return config_layerApply(layers, idx);
+}
+
+uint32_t config_layerValueSize(const ConfigTable_t* cfg) {
+    if(cfg == NULL) return 0;
+    uint32_t size = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) size += config_alignLayerValue(cfg->entries[i].size);
+    return size;
+}
+
+CfgRet_t config_layerInit(ConfigLayers_t* layers, ConfigTable_t* cfg) {
+    if(layers == NULL || cfg == NULL || layers->layers == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(layers->offsets == NULL || layers->sources == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(layers->layer_count == 0) return CFG_RC_ERROR_INVALID;
+    if(layers->layer_count > CFG_LAYER_MAX_COUNT) return CFG_RC_ERROR_TOO_LARGE;
+    for(uint32_t l = 0; l < layers->layer_count; l++) {
+        if(layers->layers[l].values == NULL || layers->layers[l].present == NULL) return CFG_RC_ERROR_NULLPTR;
+    }
+    layers->cfg = cfg;
+    layers->generation = cfg->generation;
+    uint32_t offset = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        layers->offsets[i] = offset;
+        offset += config_alignLayerValue(cfg->entries[i].size);
+    }
+    for(uint32_t l = 0; l < layers->layer_count; l++) {
+        memset(layers->layers[l].present, 0, CFG_DIRTY_WORD_COUNT(cfg->count) * sizeof(uint32_t));
+    }
+    // The current values become the defaults
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        config_copyValueByIdx(cfg, i, config_layerValue(layers, 0, i), cfg->entries[i].size);
+        config_setLayerBit(layers->layers[0].present, i);
+        layers->sources[i] = 0;
+    }
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_layerSet(ConfigLayers_t* layers, uint32_t layer, uint32_t idx, const void* value, uint32_t size) {
+    if(layers == NULL || layers->cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(!config_layerCurrent(layers)) return CFG_RC_ERROR_INVALID;
+    if(layer >= layers->layer_count || idx >= layers->cfg->count) return CFG_RC_ERROR_RANGE;
+    const ConfigEntry_t* entry = &(layers->cfg->entries[idx]);
+    if(entry->perm == CFG_PERM_RO || entry->perm == CFG_PERM_SECRET_RO) return CFG_RC_ERROR_READ_ONLY;
+    if(size > entry->size) return CFG_RC_ERROR_TOO_LARGE;
+    // Stored like config_setByIdx stores values in the table
+    uint8_t* stored = config_layerValue(layers, layer, idx);
+    memcpy(stored, value, size);
+    memset(stored + size, 0, entry->size - size);
+    config_setLayerBit(layers->layers[layer].present, idx);
+    return config_layerChanged(layers, layer, idx);
+}
+
+CfgRet_t config_layerUnset(ConfigLayers_t* layers, uint32_t layer, uint32_t idx) {
+    if(layers == NULL || layers->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(!config_layerCurrent(layers)) return CFG_RC_ERROR_INVALID;
+    if(layer >= layers->layer_count || idx >= layers->cfg->count) return CFG_RC_ERROR_RANGE;
+    if(layer == 0) return CFG_RC_ERROR_INVALID;
+    if(!config_layerBit(layers->layers[layer].present, idx)) return CFG_RC_SUCCESS;
+    return config_layerRemove(layers, layer, idx);
+}
+
+CfgRet_t config_layerClear(ConfigLayers_t* layers, uint32_t layer) {
+    if(layers == NULL || layers->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(!config_layerCurrent(layers)) return CFG_RC_ERROR_INVALID;
+    if(layer >= layers->layer_count) return CFG_RC_ERROR_RANGE;
+    if(layer == 0) return CFG_RC_ERROR_INVALID;
+    CfgRet_t ret = CFG_RC_SUCCESS;
+    config_notifyBeginBatch(layers->cfg);
+    for(uint32_t i = 0; i < layers->cfg->count; i++) {
+        if(!config_layerBit(layers->layers[layer].present, i)) continue;
+        const CfgRet_t remove_ret = config_layerRemove(layers, layer, i);
+        if(ret == CFG_RC_SUCCESS) ret = remove_ret;
+    }
+    config_notifyEndBatch(layers->cfg);
+    return ret;
+}
+
+// Parses a single line into the storage of the layer
+static CfgRet_t config_layerParseEntry(ConfigLayers_t* layers, uint32_t layer, char* buf, const ConfigKVSpan_t* span) {
+    if(!span->has_separator) return CFG_RC_ERROR_FORMAT;
+    ConfigTable_t* cfg = layers->cfg;
+    // The key is followed by the separator or whitespace, so it can be terminated for the lookup
+    char* key = buf + span->key_offset;
+    const char end = key[span->key_len];
+    key[span->key_len] = '\0';
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    key[span->key_len] = end;
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+
+    // Table with only this entry, whose value is stored in the layer
+    ConfigEntry_t entry = cfg->entries[idx];
+    entry.value = config_layerValue(layers, layer, idx);
+#if CFG_THREAD_SAFE
+    entry.seq = 0;
+#endif
+    ConfigTable_t view = {.entries = &entry, .count = 1};
+    const CfgRet_t ret = config_parseKV(&view, key, span->key_len, buf + span->value_offset, span->value_len);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    config_setLayerBit(layers->layers[layer].present, idx);
+    return config_layerChanged(layers, layer, idx);
+}
+
+static CfgRet_t config_layerParse(ConfigLayers_t* layers, uint32_t layer, char* buf, uint32_t len,
+                                  parseErrorFunc on_error, void* ctx) {
+    bool parsing_error_occurred = false;
+    ConfigTokenizer_t tokenizer;
+    config_tokenizerInit(&tokenizer, buf, len);
+    ConfigKVSpan_t spans[LAYER_PARSE_SPAN_COUNT];
+    uint32_t span_count = 0;
+    CfgRet_t tokenizer_ret;
+    do {
+        tokenizer_ret = config_tokenizerNext(&tokenizer, spans, LAYER_PARSE_SPAN_COUNT, &span_count);
+        for(uint32_t i = 0; i < span_count; i++) {
+            const CfgRet_t ret = config_layerParseEntry(layers, layer, buf, &spans[i]);
+            if(CFG_RC_SUCCESS != ret) {
+                parsing_error_occurred = true;
+                if(on_error != NULL) on_error(ctx, spans[i].line, ret);
+            }
+        }
+    } while(tokenizer_ret == CFG_RC_ERROR_INCOMPLETE);
+    if(parsing_error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_layerParseBuffer(ConfigLayers_t* layers, uint32_t layer, char* buf, uint32_t len,
+                                 parseErrorFunc on_error, void* ctx) {
+    if(layers == NULL || layers->cfg == NULL || buf == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(!config_layerCurrent(layers)) return CFG_RC_ERROR_INVALID;
+    if(layer >= layers->layer_count) return CFG_RC_ERROR_RANGE;
+    config_notifyBeginBatch(layers->cfg);
+    const CfgRet_t ret = config_layerParse(layers, layer, buf, len, on_error, ctx);
+    config_notifyEndBatch(layers->cfg);
+    return ret;
+}
+
+CfgRet_t config_layerLoadFromFile(ConfigLayers_t* layers, uint32_t layer, const char* filename) {
+    if(layers == NULL || layers->cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(!config_layerCurrent(layers)) return CFG_RC_ERROR_INVALID;
+    if(layer >= layers->layer_count) return CFG_RC_ERROR_RANGE;
+    if(layer == 0) return CFG_RC_ERROR_INVALID;
+    ConfigTable_t* cfg = layers->cfg;
+    const uint32_t word_count = CFG_DIRTY_WORD_COUNT(cfg->count);
+    uint32_t* previous = malloc((word_count > 0 ? word_count : 1) * sizeof(uint32_t));
+    if(previous == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    FILE* file_ptr = fopen(filename, "rb");
+    if(file_ptr == NULL) {
+        free(previous);
+        return CFG_RC_ERROR;
+    }
+    char* buf = NULL;
+    uint32_t len = 0;
+    CfgRet_t ret = config_readFileContents(file_ptr, &buf, &len);
+    fclose(file_ptr);
+    if(ret != CFG_RC_SUCCESS) {
+        free(previous);
+        return ret;
+    }
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, len);
+
+    // Entries of the file replace their old values directly. Only entries missing in the file
+    // fall back to lower layers afterwards, so no entry changes twice
+    uint32_t* present = layers->layers[layer].present;
+    memcpy(previous, present, word_count * sizeof(uint32_t));
+    memset(present, 0, word_count * sizeof(uint32_t));
+    config_notifyBeginBatch(cfg);
+    ret = config_layerParse(layers, layer, buf, len, NULL, NULL);
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        if(!config_layerBit(previous, i) || config_layerBit(present, i)) continue;
+        const CfgRet_t remove_ret = config_layerRemove(layers, layer, i);
+        if(ret == CFG_RC_SUCCESS) ret = remove_ret;
+    }
+    config_notifyEndBatch(cfg);
+    free(buf);
+    free(previous);
+    return ret;
+}
+
+int32_t config_layerGetSource(const ConfigLayers_t* layers, uint32_t idx) {
+    if(layers == NULL || layers->cfg == NULL || !config_layerCurrent(layers) || idx >= layers->cfg->count) return -1;
+    return layers->sources[idx];
+}
+
+bool config_layerIsSet(const ConfigLayers_t* layers, uint32_t layer, uint32_t idx) {
+    if(layers == NULL || layers->cfg == NULL || !config_layerCurrent(layers) || layer >= layers->layer_count ||
+       idx >= layers->cfg->count) {
+        return false;
+    }
+    return config_layerBit(layers->layers[layer].present, idx);
+}
@@ -0,0 +1,307 @@
+#include "config_log.h"
+#include "config_internal.h"
+#include "config_stats.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CFG_LOG_FSYNC
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Parses a file in the text format. Missing files are treated as empty, files which exist but cannot
+// be read are errors. If torn is not NULL, an incomplete last line is dropped and reported through it
+static CfgRet_t config_logParseFile(ConfigTable_t* cfg, const char* filename, bool* torn) {
+    if(torn != NULL) *torn = false;
+    FILE* file_ptr = fopen(filename, "rb");
+    if(file_ptr == NULL) return errno == ENOENT ? CFG_RC_SUCCESS : CFG_RC_ERROR;
+    // One additional byte for the null-terminator written by config_parseBuffer
+    char* buf = NULL;
+    uint32_t file_size = 0;
+    CfgRet_t ret = config_readFileContents(file_ptr, &buf, &file_size);
+    fclose(file_ptr);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, file_size);
+    uint32_t len = file_size;
+    if(torn != NULL) {
+        // Records are only complete with their line ending
+        while(len > 0 && buf[len - 1] != '\n') len--;
+        *torn = len != file_size;
+    }
+    ret = config_parseBuffer(cfg, buf, len, NULL, NULL);
+    free(buf);
+    return ret;
+}
+
+// Returns a heap allocated copy of filename with the suffix appended or NULL
+static char* config_logFilename(const char* filename, const char* suffix) {
+    const size_t name_len = strlen(filename);
+    const size_t suffix_size = strlen(suffix) + 1;
+    char* result = malloc(name_len + suffix_size);
+    if(result == NULL) return NULL;
+    memcpy(result, filename, name_len);
+    memcpy(result + name_len, suffix, suffix_size);
+    return result;
+}
+
+// Flushes a written file to the storage device
+static bool config_logSyncFile(FILE* file_ptr) {
+    if(fflush(file_ptr) != 0) return false;
+#if CFG_LOG_FSYNC
+    return fsync(fileno(file_ptr)) == 0;
+#else
+    return true;
+#endif
+}
+
+// Flushes the directory entries of the directory containing filename, so a rename survives a power loss
+static bool config_logSyncDirectory(const char* filename) {
+#if CFG_LOG_FSYNC
+    const char* slash = strrchr(filename, '/');
+    const size_t dir_len = slash == NULL ? 0 : (slash == filename ? 1 : (size_t)(slash - filename));
+    char* dir = malloc(dir_len + 2);
+    if(dir == NULL) return false;
+    if(dir_len == 0) {
+        dir[0] = '.';
+        dir[1] = '\0';
+    } else {
+        memcpy(dir, filename, dir_len);
+        dir[dir_len] = '\0';
+    }
+    const int fd = open(dir, O_RDONLY);
+    free(dir);
+    if(fd < 0) return false;
+    const bool synced = fsync(fd) == 0;
+    close(fd);
+    return synced;
+#else
+    (void)filename;
+    return true;
+#endif
+}
+
+// Writes every entry to "<snapshot_filename>.tmp", flushes it to the storage device and renames it over the snapshot
+static CfgRet_t config_logWriteSnapshot(const ConfigTable_t* cfg, const ConfigLog_t* log) {
+    const uint64_t start = CFG_STATS_START(cfg);
+    const uint32_t buf_size = config_getFormattedSize(cfg);
+    char* buf = malloc(buf_size > 0 ? buf_size : 1);
+    char* tmp_filename = config_logFilename(log->snapshot_filename, ".tmp");
+    if(buf == NULL || tmp_filename == NULL) {
+        free(buf);
+        free(tmp_filename);
+        return CFG_RC_ERROR_TOO_LARGE;
+    }
+    // Unlike config_formatTable, long lines are not skipped. The snapshot is parsed without line length limit
+    uint32_t len = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        if(config_getFormattedEntrySize(cfg, i) == 0) continue;
+        uint32_t line_len = 0;
+        config_formatEntry(cfg, i, buf + len, buf_size - len, &line_len);
+        len += line_len;
+    }
+
+    CfgRet_t ret = CFG_RC_ERROR;
+    FILE* file_ptr = fopen(tmp_filename, "wb");
+    if(file_ptr != NULL) {
+        const size_t written = fwrite(buf, 1, len, file_ptr);
+        CFG_STATS_ADD(cfg, CFG_STAT_BYTES_WRITTEN, written);
+        const bool synced = written == len && config_logSyncFile(file_ptr);
+        if(fclose(file_ptr) == 0 && synced && rename(tmp_filename, log->snapshot_filename) == 0 &&
+           config_logSyncDirectory(log->snapshot_filename)) {
+            ret = CFG_RC_SUCCESS;
+        }
+    }
+    // Nothing is left behind if the snapshot could not be replaced
+    if(ret != CFG_RC_SUCCESS) remove(tmp_filename);
+    free(tmp_filename);
+    free(buf);
+    CFG_STATS_RECORD(cfg, CFG_STAT_SAVE, start);
+    return ret;
+}
+
+// Removes the previous log file once the snapshot contains its records
+static CfgRet_t config_logRemovePrevious(ConfigLog_t* log) {
+    char* old_filename = config_logFilename(log->log_filename, ".old");
+    if(old_filename == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    const bool removed = remove(old_filename) == 0 || errno == ENOENT;
+    free(old_filename);
+    if(!removed) return CFG_RC_ERROR;
+    __atomic_store_n(&log->compaction_pending, false, __ATOMIC_RELEASE);
+    return CFG_RC_SUCCESS;
+}
+
+// Continues the log in a new file and keeps the current one as "<log_filename>.old" until a snapshot
+// contains its records. Only renames and opens files, so it is cheap enough for the setters
+static CfgRet_t config_logRotate(ConfigLog_t* log) {
+    char* old_filename = config_logFilename(log->log_filename, ".old");
+    if(old_filename == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    if(log->file != NULL) fclose(log->file);
+    const bool renamed = rename(log->log_filename, old_filename) == 0;
+    free(old_filename);
+    // Without the rename, records are appended to the current file again
+    log->file = fopen(log->log_filename, "ab");
+    if(log->file == NULL || !renamed) return CFG_RC_ERROR;
+    log->size = 0;
+    log->next_compaction = log->compaction_threshold;
+    __atomic_store_n(&log->compaction_pending, true, __ATOMIC_RELEASE);
+    return CFG_RC_SUCCESS;
+}
+
+// Called by the setters once the log has reached the size for the next compaction
+static CfgRet_t config_logStartCompaction(ConfigTable_t* cfg) {
+    ConfigLog_t* log = cfg->log;
+    // A failed compaction is only attempted again once the log has grown by another threshold
+    const uint32_t remaining = UINT32_MAX - log->size;
+    log->next_compaction = log->size + (log->compaction_threshold < remaining ? log->compaction_threshold : remaining);
+    if(log->request_compaction == NULL) return config_logCompact(cfg);
+    // The background task may still be busy with the previous file, which then also covers this one
+    if(!__atomic_load_n(&log->compaction_pending, __ATOMIC_ACQUIRE)) {
+        const CfgRet_t ret = config_logRotate(log);
+        if(ret != CFG_RC_SUCCESS) return ret;
+    }
+    log->request_compaction(log->request_ctx);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_logOpen(ConfigTable_t* cfg, ConfigLog_t* log, const char* snapshot_filename, const char* log_filename,
+                        uint32_t compaction_threshold) {
+    if(cfg == NULL || log == NULL || snapshot_filename == NULL || log_filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    log->snapshot_filename = snapshot_filename;
+    log->log_filename = log_filename;
+    log->compaction_threshold = compaction_threshold;
+    log->request_compaction = NULL;
+    log->request_ctx = NULL;
+    log->file = NULL;
+    log->size = 0;
+    log->next_compaction = compaction_threshold;
+    log->compaction_pending = false;
+
+    // Loading must not append the loaded values to an attached log, which is closed instead
+    if(cfg->log != NULL) config_logClose(cfg);
+    CfgRet_t ret = config_logParseFile(cfg, snapshot_filename, NULL);
+    if(ret != CFG_RC_SUCCESS && ret != CFG_RC_ERROR_INCOMPLETE) return ret;
+
+    // A previous log file is left behind if the process stopped during a background compaction.
+    // Its records are older than the ones of the current log
+    char* old_filename = config_logFilename(log_filename, ".old");
+    if(old_filename == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    FILE* old_file = fopen(old_filename, "rb");
+    if(old_file != NULL) {
+        fclose(old_file);
+        log->compaction_pending = true;
+    }
+    bool torn = false;
+    CfgRet_t replay_ret = config_logParseFile(cfg, old_filename, &torn);
+    free(old_filename);
+    if(replay_ret == CFG_RC_ERROR_INCOMPLETE) ret = CFG_RC_ERROR_INCOMPLETE;
+    else if(replay_ret != CFG_RC_SUCCESS) return replay_ret;
+
+    replay_ret = config_logParseFile(cfg, log_filename, &torn);
+    if(replay_ret == CFG_RC_ERROR_INCOMPLETE) ret = CFG_RC_ERROR_INCOMPLETE;
+    else if(replay_ret != CFG_RC_SUCCESS) return replay_ret;
+
+    log->file = fopen(log_filename, "ab");
+    if(log->file == NULL) return CFG_RC_ERROR;
+    if(fseek(log->file, 0, SEEK_END) != 0) {
+        fclose(log->file);
+        log->file = NULL;
+        return CFG_RC_ERROR;
+    }
+    const long log_size = ftell(log->file);
+    log->size = log_size < 0 ? 0 : (uint32_t)log_size;
+    cfg->log = log;
+
+    // Appending after an incomplete record would corrupt the next record as well
+    if(torn || config_logNeedsCompaction(log)) {
+        const CfgRet_t compact_ret = config_logCompact(cfg);
+        if(compact_ret != CFG_RC_SUCCESS) return compact_ret;
+    }
+    return ret;
+}
+
+CfgRet_t config_logAppend(ConfigTable_t* cfg, uint32_t idx) {
+    return config_logAppendEntries(cfg, &idx, 1);
+}
+
+CfgRet_t config_logAppendEntries(ConfigTable_t* cfg, const uint32_t* indices, uint32_t count) {
+    if(cfg == NULL || cfg->log == NULL || indices == NULL) return CFG_RC_ERROR_NULLPTR;
+    ConfigLog_t* log = cfg->log;
+    uint32_t size = 0;
+    for(uint32_t i = 0; i < count; i++) {
+        if(indices[i] >= cfg->count) return CFG_RC_ERROR_RANGE;
+        // Entries which are not saved are not logged either
+        size += config_getFormattedEntrySize(cfg, indices[i]);
+    }
+    if(log->file == NULL) return CFG_RC_ERROR;
+    if(size == 0) return CFG_RC_SUCCESS;
+
+    // Only long strings or many entries need a heap allocated buffer
+    char line_buf[FILE_MAX_LINE_LEN];
+    char* buf = size <= sizeof(line_buf) ? line_buf : malloc(size);
+    if(buf == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    uint32_t len = 0;
+    CfgRet_t ret = CFG_RC_SUCCESS;
+    for(uint32_t i = 0; i < count && ret == CFG_RC_SUCCESS; i++) {
+        if(config_getFormattedEntrySize(cfg, indices[i]) == 0) continue;
+        uint32_t line_len = 0;
+        ret = config_formatEntry(cfg, indices[i], buf + len, size - len, &line_len);
+        len += line_len;
+    }
+    if(ret == CFG_RC_SUCCESS) {
+        // All records are written at once
+        const size_t written = fwrite(buf, 1, len, log->file);
+        if(written != len || fflush(log->file) != 0) ret = CFG_RC_ERROR;
+        log->size += (uint32_t)written;
+        CFG_STATS_ADD(cfg, CFG_STAT_BYTES_WRITTEN, written);
+    }
+    if(buf != line_buf) free(buf);
+    if(ret != CFG_RC_SUCCESS) return ret;
+
+    if(log->size >= log->next_compaction) return config_logStartCompaction(cfg);
+    return CFG_RC_SUCCESS;
+}
+
+bool config_logNeedsCompaction(const ConfigLog_t* log) {
+    if(log == NULL) return false;
+    return log->size >= log->next_compaction || __atomic_load_n(&log->compaction_pending, __ATOMIC_ACQUIRE);
+}
+
+CfgRet_t config_logCompact(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->log == NULL) return CFG_RC_ERROR_NULLPTR;
+    ConfigLog_t* log = cfg->log;
+    CfgRet_t ret = config_logWriteSnapshot(cfg, log);
+    if(ret == CFG_RC_SUCCESS) ret = config_logRemovePrevious(log);
+    if(ret != CFG_RC_SUCCESS) return ret;
+
+    // The snapshot contains all logged changes and is on the storage device now. Replaying the old log
+    // on top of it would yield the same values, so a failure below does not lose any data
+    if(log->file != NULL) fclose(log->file);
+    log->file = fopen(log->log_filename, "wb");
+    if(log->file == NULL) return CFG_RC_ERROR;
+    log->size = 0;
+    log->next_compaction = log->compaction_threshold;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_logCompactPrevious(const ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->log == NULL) return CFG_RC_ERROR_NULLPTR;
+    ConfigLog_t* log = cfg->log;
+    if(!__atomic_load_n(&log->compaction_pending, __ATOMIC_ACQUIRE)) return CFG_RC_SUCCESS;
+    // Every value is at least as recent as the records of the previous file. Newer values are
+    // also contained in the current log, which is replayed after the snapshot
+    const CfgRet_t ret = config_logWriteSnapshot(cfg, log);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    return config_logRemovePrevious(log);
+}
+
+CfgRet_t config_logClose(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->log == NULL) return CFG_RC_ERROR_NULLPTR;
+    ConfigLog_t* log = cfg->log;
+    cfg->log = NULL;
+    if(log->file == NULL) return CFG_RC_SUCCESS;
+    const int close_ret = fclose(log->file);
+    log->file = NULL;
+    return close_ret == 0 ? CFG_RC_SUCCESS : CFG_RC_ERROR;
+}
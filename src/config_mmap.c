@@ -0,0 +1,297 @@
+#include "config_mmap.h"
+#include "config_binary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CFG_MMAP_SUPPORTED
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define MMAP_MAGIC ("CFGM")
+    #define MMAP_BYTE_ORDER_MARK (0x0102)
+    // Type, size and value offset in front of every key in the schema section
+    #define MMAP_SCHEMA_RECORD_SIZE (1 + 4 + 4)
+
+static uint32_t config_alignValue(uint32_t offset) {
+    return (offset + CFG_MMAP_ALIGNMENT - 1) & ~(uint32_t)(CFG_MMAP_ALIGNMENT - 1);
+}
+
+// Entries without a type keep their storage
+static bool config_isMappedEntry(const ConfigEntry_t* e) {
+    return e->type != CONFIG_NONE;
+}
+
+// Computes the header of the layout for the current table definition
+static void config_mmapLayout(const ConfigTable_t* cfg, ConfigMmapHeader_t* header) {
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, MMAP_MAGIC, sizeof(header->magic));
+    header->version = CFG_MMAP_VERSION;
+    header->byte_order_mark = MMAP_BYTE_ORDER_MARK;
+    header->fingerprint = config_binaryFingerprint(cfg);
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isMappedEntry(e)) continue;
+        header->entry_count++;
+        header->schema_size += MMAP_SCHEMA_RECORD_SIZE + strlen(e->key) + 1;
+        header->values_size += config_alignValue(e->size);
+    }
+    header->values_offset = config_alignValue(sizeof(ConfigMmapHeader_t) + header->schema_size);
+}
+
+// Checks that the header describes a file of the given size
+static bool config_isValidHeader(const ConfigMmapHeader_t* header, uint32_t file_size) {
+    if(memcmp(header->magic, MMAP_MAGIC, sizeof(header->magic)) != 0) return false;
+    if(header->version != CFG_MMAP_VERSION || header->byte_order_mark != MMAP_BYTE_ORDER_MARK) return false;
+    if(header->schema_size > file_size - sizeof(ConfigMmapHeader_t)) return false;
+    if(header->values_offset < sizeof(ConfigMmapHeader_t) + header->schema_size) return false;
+    return header->values_offset <= file_size && header->values_size <= file_size - header->values_offset;
+}
+
+// Copies the values of a file with a different layout into the current storage of the table
+static CfgRet_t config_mmapMigrate(ConfigTable_t* cfg, const uint8_t* base, const ConfigMmapHeader_t* header) {
+    bool parsing_error_occurred = false;
+    const uint8_t* schema = base + sizeof(ConfigMmapHeader_t);
+    const uint8_t* const schema_end = schema + header->schema_size;
+    const uint8_t* const values = base + header->values_offset;
+    for(uint32_t i = 0; i < header->entry_count; i++) {
+        if(schema_end - schema < MMAP_SCHEMA_RECORD_SIZE + 1) return CFG_RC_ERROR_INCOMPLETE;
+        const ConfigType_t type = (ConfigType_t)schema[0];
+        uint32_t size, offset;
+        memcpy(&size, schema + 1, sizeof(size));
+        memcpy(&offset, schema + 5, sizeof(offset));
+        const char* key = (const char*)schema + MMAP_SCHEMA_RECORD_SIZE;
+        const char* key_end = memchr(key, '\0', schema_end - (const uint8_t*)key);
+        if(key_end == NULL || offset > header->values_size || size > header->values_size - offset) {
+            return CFG_RC_ERROR_INCOMPLETE;
+        }
+        schema = (const uint8_t*)key_end + 1;
+
+        const int32_t idx = config_getIdxFromKey(cfg, key);
+        if(idx < 0 || cfg->entries[idx].type != type) {
+            parsing_error_occurred = true;
+            continue;
+        }
+        const ConfigEntry_t* e = &(cfg->entries[idx]);
+        if(e->perm == CFG_PERM_RO || e->perm == CFG_PERM_SECRET_RO) continue;
+        const uint8_t* value = values + offset;
+        if(type == CONFIG_STRING && size > e->size) {
+            const uint8_t* end = memchr(value, '\0', size);
+            if(end == NULL || (uint32_t)(end - value) >= e->size) {
+                parsing_error_occurred = true;
+                continue;
+            }
+            size = (uint32_t)(end - value) + 1;
+        } else if(type != CONFIG_STRING && size != e->size) {
+            parsing_error_occurred = true;
+            continue;
+        }
+        if(config_setByIdx(cfg, idx, value, size) != CFG_RC_SUCCESS) parsing_error_occurred = true;
+    }
+    if(parsing_error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+// Writes header, schema and the current values of the table into a new mapping
+static void config_mmapInitialize(const ConfigTable_t* cfg, uint8_t* base, const ConfigMmapHeader_t* header) {
+    memcpy(base, header, sizeof(*header));
+    uint8_t* schema = base + sizeof(ConfigMmapHeader_t);
+    uint32_t offset = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isMappedEntry(e)) continue;
+        const uint32_t key_size = strlen(e->key) + 1;
+        schema[0] = (uint8_t)e->type;
+        memcpy(schema + 1, &e->size, sizeof(e->size));
+        memcpy(schema + 5, &offset, sizeof(offset));
+        memcpy(schema + MMAP_SCHEMA_RECORD_SIZE, e->key, key_size);
+        schema += MMAP_SCHEMA_RECORD_SIZE + key_size;
+        memcpy(base + header->values_offset + offset, e->value, e->size);
+        offset += config_alignValue(e->size);
+    }
+}
+
+// Resizes the file to the layout of the table and writes the current values into a new mapping
+static CfgRet_t config_mmapCreate(const ConfigTable_t* cfg, int fd, const ConfigMmapHeader_t* layout,
+                                  uint32_t file_size, uint8_t** base) {
+    if(ftruncate(fd, 0) != 0 || ftruncate(fd, file_size) != 0) return CFG_RC_ERROR;
+    uint8_t* created = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(created == MAP_FAILED) return CFG_RC_ERROR;
+    config_mmapInitialize(cfg, created, layout);
+    *base = created;
+    return CFG_RC_SUCCESS;
+}
+
+// Writes the new layout to a temporary file and renames it over the old file once it is on the storage device.
+// On success, fd refers to the new file
+static CfgRet_t config_mmapReplace(const ConfigTable_t* cfg, const char* filename, int* fd,
+                                   const ConfigMmapHeader_t* layout, uint32_t file_size, uint8_t** base) {
+    const size_t filename_len = strlen(filename);
+    char* tmp_filename = malloc(filename_len + sizeof(".tmp"));
+    if(tmp_filename == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    memcpy(tmp_filename, filename, filename_len);
+    memcpy(tmp_filename + filename_len, ".tmp", sizeof(".tmp"));
+    const int tmp_fd = open(tmp_filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(tmp_fd < 0) {
+        free(tmp_filename);
+        return CFG_RC_ERROR;
+    }
+    uint8_t* created = NULL;
+    CfgRet_t ret = config_mmapCreate(cfg, tmp_fd, layout, file_size, &created);
+    if(ret == CFG_RC_SUCCESS && (msync(created, file_size, MS_SYNC) != 0 || fsync(tmp_fd) != 0 ||
+                                 rename(tmp_filename, filename) != 0)) {
+        ret = CFG_RC_ERROR;
+    }
+    if(ret != CFG_RC_SUCCESS) {
+        if(created != NULL) munmap(created, file_size);
+        close(tmp_fd);
+        unlink(tmp_filename);
+        free(tmp_filename);
+        return ret;
+    }
+    free(tmp_filename);
+    close(*fd);
+    *fd = tmp_fd;
+    *base = created;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_mmapOpen(ConfigTable_t* cfg, ConfigMmap_t* map, const char* filename) {
+    if(cfg == NULL || map == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    ConfigMmapHeader_t layout;
+    config_mmapLayout(cfg, &layout);
+    const uint32_t file_size = layout.values_offset + layout.values_size;
+
+    ConfigMmapValue_t* values = malloc((layout.entry_count > 0 ? layout.entry_count : 1) * sizeof(ConfigMmapValue_t));
+    if(values == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    int fd = open(filename, O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) != 0 || (uint64_t)st.st_size >= UINT32_MAX) {
+        if(fd >= 0) close(fd);
+        free(values);
+        return CFG_RC_ERROR;
+    }
+
+    CfgRet_t ret = CFG_RC_SUCCESS;
+    CfgRet_t create_ret;
+    uint8_t* base = NULL;
+    const uint32_t old_size = (uint32_t)st.st_size;
+    if(old_size > 0) {
+        uint8_t* old_base = NULL;
+        if(old_size >= sizeof(ConfigMmapHeader_t)) {
+            old_base = mmap(NULL, old_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(old_base == MAP_FAILED) old_base = NULL;
+        }
+        ConfigMmapHeader_t header;
+        if(old_base != NULL) memcpy(&header, old_base, sizeof(header));
+        if(old_base == NULL || !config_isValidHeader(&header, old_size)) {
+            if(old_base != NULL) munmap(old_base, old_size);
+            close(fd);
+            free(values);
+            return CFG_RC_ERROR_FORMAT;
+        }
+        if(memcmp(&header, &layout, sizeof(header)) == 0 && old_size == file_size) {
+            // Same table definition, the file can be used as it is
+            base = old_base;
+            create_ret = CFG_RC_SUCCESS;
+        } else {
+            ret = config_mmapMigrate(cfg, old_base, &header);
+            munmap(old_base, old_size);
+            // The old file is only replaced once the migrated one is complete
+            create_ret = config_mmapReplace(cfg, filename, &fd, &layout, file_size, &base);
+        }
+    } else {
+        // Nothing to lose, the new file is written in place
+        create_ret = config_mmapCreate(cfg, fd, &layout, file_size, &base);
+    }
+    if(create_ret != CFG_RC_SUCCESS) {
+        close(fd);
+        free(values);
+        return create_ret;
+    }
+
+    // Move the values into the mapping
+    uint32_t offset = 0;
+    uint32_t value_count = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isMappedEntry(e)) continue;
+        uint8_t* value = base + layout.values_offset + offset;
+        // Read-only values come from the table definition, not from the file
+        if(e->perm == CFG_PERM_RO || e->perm == CFG_PERM_SECRET_RO) memcpy(value, e->value, e->size);
+        values[value_count].original = e->value;
+        values[value_count].mapped = value;
+        value_count++;
+        e->value = value;
+        offset += config_alignValue(e->size);
+    }
+    map->cfg = cfg;
+    map->base = base;
+    map->size = file_size;
+    map->fd = fd;
+    map->values = values;
+    map->value_count = value_count;
+    return ret;
+}
+
+CfgRet_t config_mmapFlush(ConfigMmap_t* map) {
+    if(map == NULL || map->base == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(msync(map->base, map->size, MS_SYNC) != 0) return CFG_RC_ERROR;
+    return CFG_RC_SUCCESS;
+}
+
+// Binary search for the mapped value, the values are ordered by their address in the mapping
+static const ConfigMmapValue_t* config_mmapFindValue(const ConfigMmap_t* map, const void* mapped) {
+    uint32_t low = 0;
+    uint32_t high = map->value_count;
+    while(low < high) {
+        const uint32_t mid = low + (high - low) / 2;
+        if((uintptr_t)map->values[mid].mapped < (uintptr_t)mapped) low = mid + 1;
+        else high = mid;
+    }
+    if(low < map->value_count && map->values[low].mapped == mapped) return &(map->values[low]);
+    return NULL;
+}
+
+CfgRet_t config_mmapClose(ConfigMmap_t* map) {
+    if(map == NULL || map->base == NULL) return CFG_RC_ERROR_NULLPTR;
+    CfgRet_t ret = config_mmapFlush(map);
+    ConfigTable_t* cfg = map->cfg;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        ConfigEntry_t* e = &(cfg->entries[i]);
+        const ConfigMmapValue_t* value = config_mmapFindValue(map, e->value);
+        if(value == NULL) continue;
+        memcpy(value->original, e->value, e->size);
+        e->value = value->original;
+    }
+    if(munmap(map->base, map->size) != 0) ret = CFG_RC_ERROR;
+    if(close(map->fd) != 0) ret = CFG_RC_ERROR;
+    free(map->values);
+    memset(map, 0, sizeof(*map));
+    map->fd = -1;
+    return ret;
+}
+
+#else
+
+CfgRet_t config_mmapOpen(ConfigTable_t* cfg, ConfigMmap_t* map, const char* filename) {
+    if(cfg == NULL || map == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_mmapFlush(ConfigMmap_t* map) {
+    if(map == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_mmapClose(ConfigMmap_t* map) {
+    if(map == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include "config_notify.h"
+#include "config_internal.h"
+
+#include <string.h>
+
+#if CFG_THREAD_SAFE
+// Returns true if the bit was not set before
+static bool config_setPendingBit(uint32_t* bitmap, uint32_t idx) {
+    const uint32_t mask = 1u << (idx % 32);
+    return (__atomic_fetch_or(&bitmap[idx / 32], mask, __ATOMIC_RELAXED) & mask) == 0;
+}
+
+static uint32_t config_takePendingWord(uint32_t* bitmap, uint32_t word) {
+    return __atomic_exchange_n(&bitmap[word], 0, __ATOMIC_ACQUIRE);
+}
+
+static uint32_t config_peekPendingWord(const uint32_t* bitmap, uint32_t word) {
+    return __atomic_load_n(&bitmap[word], __ATOMIC_RELAXED);
+}
+#else
+static bool config_setPendingBit(uint32_t* bitmap, uint32_t idx) {
+    const uint32_t mask = 1u << (idx % 32);
+    const bool was_set = bitmap[idx / 32] & mask;
+    bitmap[idx / 32] |= mask;
+    return !was_set;
+}
+
+static uint32_t config_takePendingWord(uint32_t* bitmap, uint32_t word) {
+    const uint32_t bits = bitmap[word];
+    bitmap[word] = 0;
+    return bits;
+}
+
+static uint32_t config_peekPendingWord(const uint32_t* bitmap, uint32_t word) {
+    return bitmap[word];
+}
+#endif
+
+CfgRet_t config_notifyAttach(ConfigTable_t* cfg, ConfigNotifier_t* notifier) {
+    if(cfg == NULL || notifier == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(notifier->pending == NULL || notifier->changed == NULL || notifier->matched == NULL) {
+        return CFG_RC_ERROR_NULLPTR;
+    }
+    if(notifier->subscriptions == NULL && notifier->subscription_capacity > 0) return CFG_RC_ERROR_NULLPTR;
+    memset(notifier->pending, 0, CFG_DIRTY_WORD_COUNT(cfg->count) * sizeof(uint32_t));
+    notifier->subscription_count = 0;
+    notifier->batch_depth = 0;
+    notifier->dispatching = false;
+    cfg->notifier = notifier;
+    return CFG_RC_SUCCESS;
+}
+
+static CfgRet_t config_addSubscription(ConfigTable_t* cfg, const ConfigSubscription_t* subscription) {
+    ConfigNotifier_t* notifier = cfg->notifier;
+    if(notifier->subscription_count >= notifier->subscription_capacity) return CFG_RC_ERROR_TOO_LARGE;
+    notifier->subscriptions[notifier->subscription_count++] = *subscription;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_subscribeEntry(ConfigTable_t* cfg, const char* key, configChangeFunc callback, void* ctx) {
+    if(cfg == NULL || cfg->notifier == NULL || key == NULL || callback == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+    const ConfigSubscription_t subscription = {
+        .kind = CFG_SUBSCRIBE_ENTRY,
+        .idx = (uint32_t)idx,
+        .key = cfg->entries[idx].key,
+        .callback = callback,
+        .ctx = ctx};
+    return config_addSubscription(cfg, &subscription);
+}
+
+CfgRet_t config_subscribePrefix(ConfigTable_t* cfg, const char* prefix, configChangeFunc callback, void* ctx) {
+    if(cfg == NULL || cfg->notifier == NULL || prefix == NULL || callback == NULL) return CFG_RC_ERROR_NULLPTR;
+    const ConfigSubscription_t subscription = {.kind = CFG_SUBSCRIBE_PREFIX,
+                                               .prefix = prefix,
+                                               .prefix_len = strlen(prefix),
+                                               .callback = callback,
+                                               .ctx = ctx};
+    return config_addSubscription(cfg, &subscription);
+}
+
+CfgRet_t config_subscribeTable(ConfigTable_t* cfg, configChangeFunc callback, void* ctx) {
+    if(cfg == NULL || cfg->notifier == NULL || callback == NULL) return CFG_RC_ERROR_NULLPTR;
+    const ConfigSubscription_t subscription = {.kind = CFG_SUBSCRIBE_TABLE, .callback = callback, .ctx = ctx};
+    return config_addSubscription(cfg, &subscription);
+}
+
+// Removes subscriptions marked by config_unsubscribe
+static void config_compactSubscriptions(ConfigNotifier_t* notifier) {
+    uint32_t kept = 0;
+    for(uint32_t i = 0; i < notifier->subscription_count; i++) {
+        if(notifier->subscriptions[i].callback == NULL) continue;
+        notifier->subscriptions[kept++] = notifier->subscriptions[i];
+    }
+    notifier->subscription_count = kept;
+}
+
+uint32_t config_unsubscribe(ConfigTable_t* cfg, configChangeFunc callback, void* ctx) {
+    if(cfg == NULL || cfg->notifier == NULL || callback == NULL) return 0;
+    ConfigNotifier_t* notifier = cfg->notifier;
+    uint32_t removed = 0;
+    for(uint32_t i = 0; i < notifier->subscription_count; i++) {
+        ConfigSubscription_t* s = &notifier->subscriptions[i];
+        if(s->callback != callback || s->ctx != ctx) continue;
+        s->callback = NULL;
+        removed++;
+    }
+    // A running dispatch loop still iterates the subscriptions, it compacts them once it is done
+    if(!notifier->dispatching) config_compactSubscriptions(notifier);
+    return removed;
+}
+
+// Delivers pending notifications right away or wakes the dispatching thread
+static void config_notifyFlush(ConfigTable_t* cfg) {
+    ConfigNotifier_t* notifier = cfg->notifier;
+    if(notifier->inline_dispatch) {
+        // Changes made by callbacks are delivered by the running dispatch loop
+        if(notifier->dispatching) return;
+        while(config_notifyHasPending(cfg)) config_notifyDispatch(cfg);
+    } else if(notifier->wake != NULL) {
+        notifier->wake(notifier->wake_ctx);
+    }
+}
+
+void config_notifyChanged(ConfigTable_t* cfg, uint32_t idx) {
+    if(cfg == NULL || cfg->notifier == NULL || idx >= cfg->count) return;
+    ConfigNotifier_t* notifier = cfg->notifier;
+    if(config_setPendingBit(notifier->pending, idx) && notifier->batch_depth == 0) config_notifyFlush(cfg);
+}
+
+void config_notifyBeginBatch(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->notifier == NULL) return;
+    cfg->notifier->batch_depth++;
+}
+
+void config_notifyEndBatch(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->notifier == NULL || cfg->notifier->batch_depth == 0) return;
+    if(--cfg->notifier->batch_depth == 0 && config_notifyHasPending(cfg)) config_notifyFlush(cfg);
+}
+
+bool config_notifyHasPending(const ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->notifier == NULL) return false;
+    for(uint32_t i = 0; i < CFG_DIRTY_WORD_COUNT(cfg->count); i++) {
+        if(config_peekPendingWord(cfg->notifier->pending, i) != 0) return true;
+    }
+    return false;
+}
+
+static bool config_isSubscribed(const ConfigTable_t* cfg, const ConfigSubscription_t* s, uint32_t idx) {
+    switch(s->kind) {
+        case CFG_SUBSCRIBE_ENTRY:
+            return s->idx == idx;
+        case CFG_SUBSCRIBE_PREFIX:
+            return strncmp(cfg->entries[idx].key, s->prefix, s->prefix_len) == 0;
+        case CFG_SUBSCRIBE_TABLE:
+        default:
+            return true;
+    }
+}
+
+uint32_t config_notifyDispatch(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->notifier == NULL) return 0;
+    ConfigNotifier_t* notifier = cfg->notifier;
+    // Take all pending bits at once, changes made from now on belong to the next batch
+    uint32_t changed_count = 0;
+    for(uint32_t i = 0; i < CFG_DIRTY_WORD_COUNT(cfg->count); i++) {
+        uint32_t word = config_takePendingWord(notifier->pending, i);
+        for(uint32_t bit = 0; word != 0; bit++, word >>= 1) {
+            if(word & 1u) notifier->changed[changed_count++] = i * 32 + bit;
+        }
+    }
+    if(changed_count == 0) return 0;
+
+    notifier->dispatching = true;
+    for(uint32_t s = 0; s < notifier->subscription_count; s++) {
+        const ConfigSubscription_t subscription = notifier->subscriptions[s];
+        // Unsubscribed by a callback of this batch
+        if(subscription.callback == NULL) continue;
+        const uint32_t* matched = notifier->changed;
+        uint32_t matched_count = changed_count;
+        if(subscription.kind != CFG_SUBSCRIBE_TABLE) {
+            matched = notifier->matched;
+            matched_count = 0;
+            for(uint32_t i = 0; i < changed_count; i++) {
+                if(config_isSubscribed(cfg, &subscription, notifier->changed[i])) {
+                    notifier->matched[matched_count++] = notifier->changed[i];
+                }
+            }
+        }
+        if(matched_count > 0) subscription.callback(subscription.ctx, cfg, matched, matched_count);
+    }
+    notifier->dispatching = false;
+    config_compactSubscriptions(notifier);
+    return changed_count;
+}
+
+void config_notifyBeforeReorder(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->notifier == NULL || cfg->notifier->dispatching) return;
+    while(config_notifyHasPending(cfg)) config_notifyDispatch(cfg);
+}
+
+void config_notifyAfterReorder(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->notifier == NULL) return;
+    ConfigNotifier_t* notifier = cfg->notifier;
+    // Only left over if sorted from a callback. Like dirty bits, every entry is marked as it is unknown where they moved
+    if(config_notifyHasPending(cfg)) {
+        for(uint32_t i = 0; i < cfg->count; i++) config_setPendingBit(notifier->pending, i);
+    }
+    for(uint32_t i = 0; i < notifier->subscription_count; i++) {
+        ConfigSubscription_t* s = &notifier->subscriptions[i];
+        if(s->kind != CFG_SUBSCRIBE_ENTRY) continue;
+        // The key string moved together with its entry
+        for(uint32_t e = 0; e < cfg->count; e++) {
+            if(cfg->entries[e].key != s->key) continue;
+            s->idx = e;
+            break;
+        }
+    }
+}
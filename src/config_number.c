@@ -0,0 +1,837 @@
+#include "config_number.h"
+
+#include <float.h>
+#include <string.h>
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+uint32_t config_formatUint64(char* buf, uint64_t value) {
+    char tmp[CFG_UINT64_MAX_LEN];
+    char* p = tmp + sizeof(tmp);
+    // Two digits per division
+    while(value >= 100) {
+        const uint32_t pair = (uint32_t)(value % 100) * 2;
+        value /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if(value >= 10) {
+        const uint32_t pair = (uint32_t)value * 2;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    } else {
+        *--p = (char)('0' + value);
+    }
+    const uint32_t len = (uint32_t)(tmp + sizeof(tmp) - p);
+    memcpy(buf, p, len);
+    return len;
+}
+
+uint32_t config_formatUint32(char* buf, uint32_t value) {
+    return config_formatUint64(buf, value);
+}
+
+uint32_t config_formatInt64(char* buf, int64_t value) {
+    if(value >= 0) return config_formatUint64(buf, (uint64_t)value);
+    buf[0] = '-';
+    // Negate in unsigned arithmetic to handle INT64_MIN
+    return 1 + config_formatUint64(buf + 1, 0 - (uint64_t)value);
+}
+
+uint32_t config_formatInt32(char* buf, int32_t value) {
+    return config_formatInt64(buf, value);
+}
+
+/**
+ * Shortest round-trip floating point formatting
+ * ===================================================================
+ * Every finite binary floating point value v = m * 2^e2 has a finite decimal expansion.
+ * The expansions of v and of the midpoints to its neighbours are computed exactly with a
+ * small big integer. The shortest decimal which lies between the midpoints parses back to v.
+ * Only the leading PREFIX_DIGITS digits are kept together with a flag for any non-zero digits
+ * after them, which is enough for exact comparisons against candidates of up to 17 digits.
+ */
+
+#define PREFIX_DIGITS (24)
+// Number of 32 bit limbs needed for the exact expansion of a float midpoint, 5^151 * 2^26 < 2^384
+#define FLOAT_LIMBS (13)
+// Number of 32 bit limbs needed for the exact expansion of a double midpoint, 5^1076 * 2^55 < 2^2560
+#define DOUBLE_LIMBS (80)
+
+typedef struct {
+    uint8_t digits[PREFIX_DIGITS];
+    uint32_t count;
+    // Set if there are non-zero digits after the stored ones
+    bool sticky;
+    // The value is 0.digits * 10^exp10
+    int32_t exp10;
+} Decimal_t;
+
+typedef struct {
+    uint32_t* limbs;
+    uint32_t count;
+} BigInt_t;
+
+static void bigint_mulSmall(BigInt_t* n, uint32_t factor) {
+    uint64_t carry = 0;
+    for(uint32_t i = 0; i < n->count; i++) {
+        const uint64_t prod = (uint64_t)n->limbs[i] * factor + carry;
+        n->limbs[i] = (uint32_t)prod;
+        carry = prod >> 32;
+    }
+    if(carry != 0) n->limbs[n->count++] = (uint32_t)carry;
+}
+
+static void bigint_shiftLeft(BigInt_t* n, uint32_t bits) {
+    const uint32_t limb_shift = bits / 32;
+    const uint32_t bit_shift = bits % 32;
+    if(bit_shift != 0) {
+        uint32_t carry = 0;
+        for(uint32_t i = 0; i < n->count; i++) {
+            const uint32_t limb = n->limbs[i];
+            n->limbs[i] = (limb << bit_shift) | carry;
+            carry = limb >> (32 - bit_shift);
+        }
+        if(carry != 0) n->limbs[n->count++] = carry;
+    }
+    if(limb_shift != 0) {
+        memmove(n->limbs + limb_shift, n->limbs, n->count * sizeof(uint32_t));
+        memset(n->limbs, 0, limb_shift * sizeof(uint32_t));
+        n->count += limb_shift;
+    }
+}
+
+// Divides n in place and returns the remainder
+static uint32_t bigint_divSmall(BigInt_t* n, uint32_t divisor) {
+    uint64_t rem = 0;
+    for(uint32_t i = n->count; i-- > 0;) {
+        const uint64_t cur = (rem << 32) | n->limbs[i];
+        n->limbs[i] = (uint32_t)(cur / divisor);
+        rem = cur % divisor;
+    }
+    while(n->count > 0 && n->limbs[n->count - 1] == 0) n->count--;
+    return (uint32_t)rem;
+}
+
+// Removes trailing zero digits
+static void decimal_normalize(Decimal_t* d) {
+    while(d->count > 1 && d->digits[d->count - 1] == 0) d->count--;
+}
+
+/**
+ * Computes the leading decimal digits of m * 2^e2 exactly.
+ * @param limbs [IN] Scratch space large enough for the expansion
+ */
+static void decimal_fromBinary(uint64_t m, int32_t e2, uint32_t* limbs, Decimal_t* out) {
+    BigInt_t n = {limbs, 0};
+    limbs[0] = (uint32_t)m;
+    limbs[1] = (uint32_t)(m >> 32);
+    n.count = limbs[1] != 0 ? 2 : 1;
+    int32_t exp10_shift = 0;
+    if(e2 >= 0) {
+        bigint_shiftLeft(&n, (uint32_t)e2);
+    } else {
+        // m / 2^k = m * 5^k / 10^k
+        uint32_t k = (uint32_t)(-e2);
+        exp10_shift = e2;
+        while(k >= 13) {
+            bigint_mulSmall(&n, 1220703125u);  // 5^13
+            k -= 13;
+        }
+        uint32_t pow5 = 1;
+        while(k-- > 0) pow5 *= 5;
+        bigint_mulSmall(&n, pow5);
+    }
+    // Split into chunks of 9 digits starting with the least significant ones.
+    // Only the most significant chunks are kept, the others only contribute to the sticky flag
+    uint32_t chunks[4] = {0};
+    uint32_t chunk_count = 0;
+    bool sticky = false;
+    while(n.count > 0) {
+        if(chunk_count >= 4 && chunks[chunk_count % 4] != 0) sticky = true;
+        chunks[chunk_count % 4] = bigint_divSmall(&n, 1000000000u);
+        chunk_count++;
+    }
+    // Digits of the most significant chunk without leading zeros
+    const uint32_t top = chunks[(chunk_count - 1) % 4];
+    uint8_t top_digits[9];
+    uint32_t top_count = 0;
+    for(uint32_t v = top; v != 0; v /= 10) top_digits[top_count++] = (uint8_t)(v % 10);
+    out->count = 0;
+    while(top_count > 0) out->digits[out->count++] = top_digits[--top_count];
+    out->exp10 = (int32_t)((chunk_count - 1) * 9 + out->count) + exp10_shift;
+    // Remaining chunks from most to least significant
+    const uint32_t kept = chunk_count < 4 ? chunk_count : 4;
+    for(uint32_t c = 1; c < kept; c++) {
+        uint32_t chunk = chunks[(chunk_count - 1 - c) % 4];
+        uint32_t divisor = 100000000u;
+        for(uint32_t i = 0; i < 9; i++) {
+            const uint8_t digit = (uint8_t)(chunk / divisor);
+            chunk %= divisor;
+            divisor /= 10;
+            if(out->count < PREFIX_DIGITS) out->digits[out->count++] = digit;
+            else if(digit != 0) sticky = true;
+        }
+    }
+    out->sticky = sticky;
+    decimal_normalize(out);
+}
+
+static int decimal_compare(const Decimal_t* a, const Decimal_t* b) {
+    if(a->exp10 != b->exp10) return a->exp10 < b->exp10 ? -1 : 1;
+    const uint32_t n = a->count > b->count ? a->count : b->count;
+    for(uint32_t i = 0; i < n; i++) {
+        const uint8_t da = i < a->count ? a->digits[i] : 0;
+        const uint8_t db = i < b->count ? b->digits[i] : 0;
+        if(da != db) return da < db ? -1 : 1;
+    }
+    if(a->sticky != b->sticky) return a->sticky ? 1 : -1;
+    return 0;
+}
+
+// Returns true if the candidate parses back to the value with the given rounding interval
+static bool decimal_inInterval(const Decimal_t* c, const Decimal_t* low, const Decimal_t* high, bool inclusive) {
+    const int cmp_low = decimal_compare(low, c);
+    const int cmp_high = decimal_compare(c, high);
+    if(inclusive) return cmp_low <= 0 && cmp_high <= 0;
+    return cmp_low < 0 && cmp_high < 0;
+}
+
+// Finds the shortest decimal within the rounding interval. The result is written to value
+static void decimal_shortest(Decimal_t* value, const Decimal_t* low, const Decimal_t* high, bool inclusive,
+                             uint32_t max_digits) {
+    for(uint32_t p = 1; p <= max_digits; p++) {
+        // The value itself is exact with p digits
+        if(value->count <= p && !value->sticky) return;
+        Decimal_t floor_candidate = *value;
+        floor_candidate.count = p;
+        floor_candidate.sticky = false;
+        Decimal_t ceil_candidate = floor_candidate;
+        int32_t i = (int32_t)p - 1;
+        while(i >= 0 && ceil_candidate.digits[i] == 9) ceil_candidate.digits[i--] = 0;
+        if(i < 0) {
+            ceil_candidate.digits[0] = 1;
+            ceil_candidate.count = 1;
+            ceil_candidate.exp10++;
+        } else {
+            ceil_candidate.digits[i]++;
+        }
+        // Determine which candidate is the correctly rounded one
+        const uint8_t next_digit = p < value->count ? value->digits[p] : 0;
+        bool rest_non_zero = value->sticky;
+        for(uint32_t j = p + 1; j < value->count && !rest_non_zero; j++) rest_non_zero = value->digits[j] != 0;
+        bool round_up = next_digit > 5 || (next_digit == 5 && rest_non_zero);
+        if(next_digit == 5 && !rest_non_zero) round_up = (floor_candidate.digits[p - 1] % 2) != 0;
+        decimal_normalize(&floor_candidate);
+        decimal_normalize(&ceil_candidate);
+        const Decimal_t* first = round_up ? &ceil_candidate : &floor_candidate;
+        const Decimal_t* second = round_up ? &floor_candidate : &ceil_candidate;
+        if(decimal_inInterval(first, low, high, inclusive)) {
+            *value = *first;
+            return;
+        }
+        if(decimal_inInterval(second, low, high, inclusive)) {
+            *value = *second;
+            return;
+        }
+    }
+}
+
+// Writes the decimal in plain or scientific notation
+static uint32_t decimal_write(char* buf, const Decimal_t* d) {
+    char* p = buf;
+    const int32_t e = d->exp10;
+    if(e >= -4 && e <= 0) {
+        *p++ = '0';
+        *p++ = '.';
+        for(int32_t i = 0; i < -e; i++) *p++ = '0';
+        for(uint32_t i = 0; i < d->count; i++) *p++ = (char)('0' + d->digits[i]);
+    } else if(e > 0 && e <= 9) {
+        for(int32_t i = 0; i < e; i++) *p++ = (char)('0' + ((uint32_t)i < d->count ? d->digits[i] : 0));
+        if(d->count > (uint32_t)e) {
+            *p++ = '.';
+            for(uint32_t i = (uint32_t)e; i < d->count; i++) *p++ = (char)('0' + d->digits[i]);
+        }
+    } else {
+        *p++ = (char)('0' + d->digits[0]);
+        if(d->count > 1) {
+            *p++ = '.';
+            for(uint32_t i = 1; i < d->count; i++) *p++ = (char)('0' + d->digits[i]);
+        }
+        *p++ = 'e';
+        p += config_formatInt32(p, e - 1);
+    }
+    return (uint32_t)(p - buf);
+}
+
+/**
+ * Formats a binary floating point value given by its raw bits
+ * @param limbs [IN] Scratch space for the big integer arithmetic
+ */
+static uint32_t config_formatBinaryFloat(char* buf, uint64_t bits, uint32_t mantissa_bits, uint32_t exponent_bits,
+                                         uint32_t max_digits, uint32_t* limbs) {
+    char* p = buf;
+    const bool negative = (bits >> (mantissa_bits + exponent_bits)) & 1;
+    const uint32_t exponent_max = (1u << exponent_bits) - 1;
+    const int32_t bias = (int32_t)(exponent_max >> 1);
+    const uint32_t biased_exp = (uint32_t)(bits >> mantissa_bits) & exponent_max;
+    const uint64_t fraction = bits & ((1ull << mantissa_bits) - 1);
+    if(biased_exp == exponent_max) {
+        if(fraction != 0) {
+            memcpy(p, "nan", 3);
+            return 3;
+        }
+        if(negative) *p++ = '-';
+        memcpy(p, "inf", 3);
+        return (uint32_t)(p - buf) + 3;
+    }
+    if(negative) *p++ = '-';
+    if(biased_exp == 0 && fraction == 0) {
+        *p++ = '0';
+        return (uint32_t)(p - buf);
+    }
+    uint64_t m;
+    int32_t e2;
+    if(biased_exp == 0) {
+        m = fraction;
+        e2 = 1 - bias - (int32_t)mantissa_bits;
+    } else {
+        m = fraction | (1ull << mantissa_bits);
+        e2 = (int32_t)biased_exp - bias - (int32_t)mantissa_bits;
+    }
+    Decimal_t value;
+    Decimal_t low;
+    Decimal_t high;
+    decimal_fromBinary(m, e2, limbs, &value);
+    decimal_fromBinary(2 * m + 1, e2 - 1, limbs, &high);
+    // The gap to the lower neighbour is only half as large at powers of two
+    if(fraction == 0 && biased_exp > 1) decimal_fromBinary(4 * m - 1, e2 - 2, limbs, &low);
+    else decimal_fromBinary(2 * m - 1, e2 - 1, limbs, &low);
+    // Midpoints round to the neighbour with the even mantissa
+    decimal_shortest(&value, &low, &high, (m % 2) == 0, max_digits);
+    return (uint32_t)(p - buf) + decimal_write(p, &value);
+}
+
+uint32_t config_formatFloat(char* buf, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t limbs[FLOAT_LIMBS];
+    return config_formatBinaryFloat(buf, bits, 23, 8, 9, limbs);
+}
+
+uint32_t config_formatDouble(char* buf, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t limbs[DOUBLE_LIMBS];
+    return config_formatBinaryFloat(buf, bits, 52, 11, 17, limbs);
+}
+
+/**
+ * Locale-independent number parsing
+ * ===================================================================
+ * Integers are accumulated in 64 bits and checked against the destination type afterwards.
+ * Floating point numbers with few digits and small exponents are converted exactly with a
+ * single multiplication or division. All others use the simple decimal conversion: the decimal
+ * digits are shifted by powers of two until binary exponent and mantissa can be read off,
+ * which is correctly rounded for every input.
+ */
+
+// Digits kept for the exact conversion, enough for every double. Later digits only set the truncated flag
+#define PARSE_DIGITS (800)
+// Largest shift at once, keeps the intermediate values of the shifts within 64 bits
+#define PARSE_MAX_SHIFT (60)
+// Upper bound for the number of digits added by a left shift of PARSE_MAX_SHIFT bits
+#define PARSE_SHIFT_DIGITS (19)
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    #define PARSE_FAST_PATH (1)
+#else
+    // Intermediate results with extended precision would be rounded twice
+    #define PARSE_FAST_PATH (0)
+#endif
+
+typedef enum { PARSE_FINITE, PARSE_INF, PARSE_NAN } ParseKind_t;
+
+typedef struct {
+    uint8_t digits[PARSE_DIGITS + PARSE_SHIFT_DIGITS];
+    // Number of digits without trailing zeros
+    uint32_t count;
+    // The value is 0.digits * 10^exp10
+    int32_t exp10;
+    // Set if non-zero digits after the stored ones were dropped
+    bool truncated;
+    bool negative;
+    ParseKind_t kind;
+} ParseDecimal_t;
+
+static const double parse_pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+// Shifts which keep the decimal exponent moving towards 0, indexed by the decimal exponent
+static const uint8_t parse_pow2_steps[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+#define PARSE_POW2_STEP_MAX (27)
+
+static uint32_t config_digitValue(char c) {
+    if(c >= '0' && c <= '9') return (uint32_t)(c - '0');
+    if(c >= 'a' && c <= 'f') return (uint32_t)(c - 'a' + 10);
+    if(c >= 'A' && c <= 'F') return (uint32_t)(c - 'A' + 10);
+    return 16;
+}
+
+// Checks the end of a parsed number. Without consumed the number has to span all characters
+static CfgRet_t config_checkEnd(uint32_t end, uint32_t len, uint32_t* consumed) {
+    if(consumed != NULL) *consumed = end;
+    else if(end != len) return CFG_RC_ERROR_FORMAT;
+    return CFG_RC_SUCCESS;
+}
+
+// Parses sign, base prefix and digits of an integer. Sets overflow if the magnitude exceeds 64 bits
+static CfgRet_t config_scanInteger(const char* str, uint32_t len, uint64_t* magnitude, bool* negative, bool* overflow,
+                                   uint32_t* consumed) {
+    uint32_t i = 0;
+    *negative = false;
+    if(i < len && (str[i] == '+' || str[i] == '-')) {
+        *negative = str[i] == '-';
+        i++;
+    }
+    uint32_t base = 10;
+    if(i + 1 < len && str[i] == '0' && (str[i + 1] == 'x' || str[i + 1] == 'X')) {
+        base = 16;
+        i += 2;
+    } else if(i + 1 < len && str[i] == '0' && (str[i + 1] == 'b' || str[i + 1] == 'B')) {
+        base = 2;
+        i += 2;
+    }
+    const uint32_t digits_start = i;
+    // n * base + digit overflows if n is above limit or equal to it and digit above last_digit
+    const uint64_t limit = UINT64_MAX / base;
+    const uint32_t last_digit = (uint32_t)(UINT64_MAX % base);
+    uint64_t n = 0;
+    *overflow = false;
+    for(; i < len; i++) {
+        // Decimal digits are checked with a single comparison
+        const uint32_t digit = base == 10 ? (uint32_t)(unsigned char)str[i] - '0' : config_digitValue(str[i]);
+        if(digit >= base) break;
+        if(n > limit || (n == limit && digit > last_digit)) *overflow = true;
+        else n = n * base + digit;
+    }
+    if(i == digits_start) return CFG_RC_ERROR_FORMAT;
+    *magnitude = n;
+    return config_checkEnd(i, len, consumed);
+}
+
+static CfgRet_t config_parseUnsigned(const char* str, uint32_t len, uint64_t max, uint64_t* value, uint32_t* consumed) {
+    uint64_t magnitude;
+    bool negative;
+    bool overflow;
+    const CfgRet_t ret = config_scanInteger(str, len, &magnitude, &negative, &overflow, consumed);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    if(overflow || magnitude > max || (negative && magnitude != 0)) return CFG_RC_ERROR_RANGE;
+    *value = magnitude;
+    return CFG_RC_SUCCESS;
+}
+
+static CfgRet_t config_parseSigned(const char* str, uint32_t len, uint64_t max, int64_t* value, uint32_t* consumed) {
+    uint64_t magnitude;
+    bool negative;
+    bool overflow;
+    const CfgRet_t ret = config_scanInteger(str, len, &magnitude, &negative, &overflow, consumed);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    // Two's complement has one more negative value
+    if(overflow || magnitude > max + (negative ? 1 : 0)) return CFG_RC_ERROR_RANGE;
+    if(negative && magnitude != 0) *value = -(int64_t)(magnitude - 1) - 1;
+    else *value = (int64_t)magnitude;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_parseUint32(const char* str, uint32_t len, uint32_t* value, uint32_t* consumed) {
+    if(str == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    uint64_t tmp;
+    const CfgRet_t ret = config_parseUnsigned(str, len, UINT32_MAX, &tmp, consumed);
+    if(ret == CFG_RC_SUCCESS) *value = (uint32_t)tmp;
+    return ret;
+}
+
+CfgRet_t config_parseInt32(const char* str, uint32_t len, int32_t* value, uint32_t* consumed) {
+    if(str == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    int64_t tmp;
+    const CfgRet_t ret = config_parseSigned(str, len, INT32_MAX, &tmp, consumed);
+    if(ret == CFG_RC_SUCCESS) *value = (int32_t)tmp;
+    return ret;
+}
+
+CfgRet_t config_parseUint64(const char* str, uint32_t len, uint64_t* value, uint32_t* consumed) {
+    if(str == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    return config_parseUnsigned(str, len, UINT64_MAX, value, consumed);
+}
+
+CfgRet_t config_parseInt64(const char* str, uint32_t len, int64_t* value, uint32_t* consumed) {
+    if(str == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    return config_parseSigned(str, len, INT64_MAX, value, consumed);
+}
+
+// Returns true if str starts with the lower case word, ignoring the case of str
+static bool config_matchWord(const char* str, uint32_t len, const char* word) {
+    uint32_t i = 0;
+    for(; word[i] != '\0'; i++) {
+        if(i >= len || (str[i] | 0x20) != word[i]) return false;
+    }
+    return true;
+}
+
+static void decimal_trim(ParseDecimal_t* d) {
+    while(d->count > 0 && d->digits[d->count - 1] == 0) d->count--;
+    if(d->count == 0) d->exp10 = 0;
+}
+
+// Parses the text of a floating point number into its decimal digits
+static CfgRet_t config_scanFloat(const char* str, uint32_t len, ParseDecimal_t* d, uint32_t* consumed) {
+    uint32_t i = 0;
+    d->negative = false;
+    d->truncated = false;
+    d->count = 0;
+    d->exp10 = 0;
+    d->kind = PARSE_FINITE;
+    if(i < len && (str[i] == '+' || str[i] == '-')) {
+        d->negative = str[i] == '-';
+        i++;
+    }
+    if(config_matchWord(str + i, len - i, "inf")) {
+        d->kind = PARSE_INF;
+        return config_checkEnd(i + 3, len, consumed);
+    }
+    if(config_matchWord(str + i, len - i, "nan")) {
+        d->kind = PARSE_NAN;
+        return config_checkEnd(i + 3, len, consumed);
+    }
+    // Significant digits including the dropped ones
+    uint32_t total = 0;
+    bool saw_digits = false;
+    bool saw_point = false;
+    for(; i < len; i++) {
+        const char c = str[i];
+        if(c == '.') {
+            if(saw_point) break;
+            saw_point = true;
+            d->exp10 = (int32_t)total;
+            continue;
+        }
+        if(c < '0' || c > '9') break;
+        saw_digits = true;
+        // Leading zeros only move the decimal point
+        if(c == '0' && total == 0) {
+            d->exp10--;
+            continue;
+        }
+        if(total < PARSE_DIGITS) d->digits[total] = (uint8_t)(c - '0');
+        else if(c != '0') d->truncated = true;
+        total++;
+    }
+    if(!saw_digits) return CFG_RC_ERROR_FORMAT;
+    if(!saw_point) d->exp10 = (int32_t)total;
+    d->count = total < PARSE_DIGITS ? total : PARSE_DIGITS;
+    if(i < len && (str[i] == 'e' || str[i] == 'E')) {
+        i++;
+        bool exp_negative = false;
+        if(i < len && (str[i] == '+' || str[i] == '-')) {
+            exp_negative = str[i] == '-';
+            i++;
+        }
+        if(i >= len || str[i] < '0' || str[i] > '9') return CFG_RC_ERROR_FORMAT;
+        int32_t exp = 0;
+        for(; i < len && str[i] >= '0' && str[i] <= '9'; i++) {
+            // Larger exponents over- or underflow anyway
+            if(exp < 100000) exp = exp * 10 + (str[i] - '0');
+        }
+        d->exp10 += exp_negative ? -exp : exp;
+    }
+    decimal_trim(d);
+    return config_checkEnd(i, len, consumed);
+}
+
+// Divides the decimal by 2^k, k <= PARSE_MAX_SHIFT
+static void decimal_shiftRight(ParseDecimal_t* d, uint32_t k) {
+    uint32_t r = 0;
+    uint32_t w = 0;
+    uint64_t n = 0;
+    // Pick up enough leading digits to cover the first shift
+    for(; (n >> k) == 0; r++) {
+        if(r >= d->count) {
+            if(n == 0) {
+                d->count = 0;
+                return;
+            }
+            while((n >> k) == 0) {
+                n *= 10;
+                r++;
+            }
+            break;
+        }
+        n = n * 10 + d->digits[r];
+    }
+    d->exp10 -= (int32_t)r - 1;
+    const uint64_t mask = (1ull << k) - 1;
+    for(; r < d->count; r++) {
+        const uint8_t c = d->digits[r];
+        d->digits[w++] = (uint8_t)(n >> k);
+        n = (n & mask) * 10 + c;
+    }
+    while(n > 0) {
+        const uint8_t digit = (uint8_t)(n >> k);
+        n = (n & mask) * 10;
+        if(w < PARSE_DIGITS) d->digits[w++] = digit;
+        else if(digit > 0) d->truncated = true;
+    }
+    d->count = w;
+    decimal_trim(d);
+}
+
+// Multiplies the decimal by 2^k, k <= PARSE_MAX_SHIFT
+static void decimal_shiftLeft(ParseDecimal_t* d, uint32_t k) {
+    // The digits are written from the end, starting behind the largest possible number of new digits
+    const uint32_t end = d->count + (k * 1233 >> 12) + 1;
+    uint32_t w = end;
+    uint64_t n = 0;
+    for(uint32_t r = d->count; r-- > 0;) {
+        n += (uint64_t)d->digits[r] << k;
+        const uint64_t quo = n / 10;
+        d->digits[--w] = (uint8_t)(n - quo * 10);
+        n = quo;
+    }
+    while(n > 0) {
+        const uint64_t quo = n / 10;
+        d->digits[--w] = (uint8_t)(n - quo * 10);
+        n = quo;
+    }
+    const uint32_t produced = end - w;
+    memmove(d->digits, d->digits + w, produced);
+    d->exp10 += (int32_t)(produced - d->count);
+    d->count = produced;
+    if(d->count > PARSE_DIGITS) {
+        for(uint32_t i = PARSE_DIGITS; i < d->count; i++) {
+            if(d->digits[i] != 0) d->truncated = true;
+        }
+        d->count = PARSE_DIGITS;
+    }
+    decimal_trim(d);
+}
+
+// Multiplies the decimal by 2^k
+static void decimal_shift(ParseDecimal_t* d, int32_t k) {
+    if(d->count == 0) return;
+    for(; k > PARSE_MAX_SHIFT; k -= PARSE_MAX_SHIFT) decimal_shiftLeft(d, PARSE_MAX_SHIFT);
+    for(; k < -PARSE_MAX_SHIFT; k += PARSE_MAX_SHIFT) decimal_shiftRight(d, PARSE_MAX_SHIFT);
+    if(k > 0) decimal_shiftLeft(d, (uint32_t)k);
+    else if(k < 0) decimal_shiftRight(d, (uint32_t)-k);
+}
+
+// Returns true if the integer part ending before digit pos has to be rounded up
+static bool decimal_roundsUp(const ParseDecimal_t* d, int32_t pos) {
+    if(pos < 0 || (uint32_t)pos >= d->count) return false;
+    // Exactly halfway rounds to even, dropped digits make it larger than halfway
+    if(d->digits[pos] == 5 && (uint32_t)pos + 1 == d->count) {
+        if(d->truncated) return true;
+        return pos > 0 && (d->digits[pos - 1] % 2) != 0;
+    }
+    return d->digits[pos] >= 5;
+}
+
+// Integer part of the decimal, rounded to nearest
+static uint64_t decimal_roundedInteger(const ParseDecimal_t* d) {
+    if(d->exp10 > 20) return UINT64_MAX;
+    uint64_t n = 0;
+    int32_t i = 0;
+    for(; i < d->exp10 && (uint32_t)i < d->count; i++) n = n * 10 + d->digits[i];
+    for(; i < d->exp10; i++) n *= 10;
+    if(decimal_roundsUp(d, d->exp10)) n++;
+    return n;
+}
+
+/**
+ * Converts the decimal to the raw bits of a binary floating point number. The decimal is modified
+ * @return CFG_RC_SUCCESS on success
+ * @return CFG_RC_ERROR_RANGE if the magnitude is too large for the format
+ */
+static CfgRet_t decimal_toBinary(ParseDecimal_t* d, uint32_t mantissa_bits, uint32_t exponent_bits, uint64_t* bits) {
+    const int32_t exponent_max = (int32_t)(1u << exponent_bits) - 1;
+    const int32_t bias = -(exponent_max >> 1);
+    const uint64_t sign = d->negative ? 1ull << (mantissa_bits + exponent_bits) : 0;
+    if(d->kind == PARSE_NAN) {
+        *bits = ((uint64_t)exponent_max << mantissa_bits) | (1ull << (mantissa_bits - 1));
+        return CFG_RC_SUCCESS;
+    }
+    bool overflow = d->kind == PARSE_INF || d->exp10 > 310;
+    int32_t exp = bias;
+    uint64_t mantissa = 0;
+    // Zero and magnitudes below half of the smallest subnormal keep the zero mantissa
+    if(!overflow && d->count > 0 && d->exp10 >= -330) {
+        // Scale into [0.5, 1)
+        exp = 0;
+        while(d->exp10 > 0) {
+            const int32_t n = d->exp10 < 9 ? parse_pow2_steps[d->exp10] : PARSE_POW2_STEP_MAX;
+            decimal_shift(d, -n);
+            exp += n;
+        }
+        while(d->exp10 < 0 || (d->exp10 == 0 && d->digits[0] < 5)) {
+            const int32_t n = -d->exp10 < 9 ? parse_pow2_steps[-d->exp10] : PARSE_POW2_STEP_MAX;
+            decimal_shift(d, n);
+            exp -= n;
+        }
+        // The mantissa range is [1, 2)
+        exp--;
+        // Exponents below the smallest normal one make the mantissa subnormal
+        if(exp < bias + 1) {
+            decimal_shift(d, -(bias + 1 - exp));
+            exp = bias + 1;
+        }
+        overflow = exp - bias >= exponent_max;
+        if(!overflow) {
+            decimal_shift(d, (int32_t)mantissa_bits + 1);
+            mantissa = decimal_roundedInteger(d);
+            // Rounding up may carry into a new bit
+            if(mantissa == (2ull << mantissa_bits)) {
+                mantissa >>= 1;
+                exp++;
+                overflow = exp - bias >= exponent_max;
+            }
+            if((mantissa & (1ull << mantissa_bits)) == 0) exp = bias;
+        }
+    }
+    if(overflow) {
+        mantissa = 0;
+        exp = exponent_max + bias;
+    }
+    *bits = sign | ((uint64_t)(exp - bias) << mantissa_bits) | (mantissa & ((1ull << mantissa_bits) - 1));
+    // An explicit "inf" is a valid value, only finite numbers can be out of range
+    if(overflow && d->kind == PARSE_FINITE) return CFG_RC_ERROR_RANGE;
+    return CFG_RC_SUCCESS;
+}
+
+// Returns true if the decimal is an integer mantissa of at most 19 digits times 10^exp10
+static bool decimal_toSmall(const ParseDecimal_t* d, uint64_t* mantissa, int32_t* exp10) {
+    if(d->kind != PARSE_FINITE || d->truncated || d->count > 19) return false;
+    uint64_t m = 0;
+    for(uint32_t i = 0; i < d->count; i++) m = m * 10 + d->digits[i];
+    *mantissa = m;
+    *exp10 = d->exp10 - (int32_t)d->count;
+    return true;
+}
+
+// Converts decimals with mantissas up to 2^53 and exponents up to 22. Both are exact doubles,
+// so the single multiplication or division rounds correctly. Returns false for all other decimals
+static bool config_fastDouble(const ParseDecimal_t* d, double* value) {
+    uint64_t mantissa;
+    int32_t exp10;
+    if(!PARSE_FAST_PATH || !decimal_toSmall(d, &mantissa, &exp10)) return false;
+    if(mantissa > (1ull << 53) || exp10 < -22 || exp10 > 22) return false;
+    const double m = (double)mantissa;
+    const double result = exp10 < 0 ? m / parse_pow10[-exp10] : m * parse_pow10[exp10];
+    *value = d->negative ? -result : result;
+    return true;
+}
+
+static uint64_t config_doubleBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+CfgRet_t config_parseFloat(const char* str, uint32_t len, float* value, uint32_t* consumed) {
+    if(str == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    ParseDecimal_t d;
+    CfgRet_t ret = config_scanFloat(str, len, &d, consumed);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    double result;
+    // The double result is rounded once and lies well within the normal float range. Rounding it to float
+    // is only wrong if it hit a midpoint between two floats exactly, a one followed by 28 zero bits
+    if(config_fastDouble(&d, &result) && (config_doubleBits(result) & 0x1fffffffu) != 0x10000000u) {
+        *value = (float)result;
+        return CFG_RC_SUCCESS;
+    }
+    uint64_t bits;
+    ret = decimal_toBinary(&d, 23, 8, &bits);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    const uint32_t bits32 = (uint32_t)bits;
+    memcpy(value, &bits32, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_parseDouble(const char* str, uint32_t len, double* value, uint32_t* consumed) {
+    if(str == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    ParseDecimal_t d;
+    CfgRet_t ret = config_scanFloat(str, len, &d, consumed);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    if(config_fastDouble(&d, value)) return CFG_RC_SUCCESS;
+    uint64_t bits;
+    ret = decimal_toBinary(&d, 52, 11, &bits);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    memcpy(value, &bits, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+
+/**
+ * Numeric entry types
+ * ===================================================================
+ */
+
+ConfigType_t config_arrayElementType(ConfigType_t type) {
+    switch(type) {
+        case CONFIG_UINT32_ARRAY:
+            return CONFIG_UINT32;
+        case CONFIG_INT32_ARRAY:
+            return CONFIG_INT32;
+        case CONFIG_FLOAT_ARRAY:
+            return CONFIG_FLOAT;
+        case CONFIG_UINT64_ARRAY:
+            return CONFIG_UINT64;
+        case CONFIG_INT64_ARRAY:
+            return CONFIG_INT64;
+        case CONFIG_DOUBLE_ARRAY:
+            return CONFIG_DOUBLE;
+        default:
+            return CONFIG_NONE;
+    }
+}
+
+uint32_t config_numberSize(ConfigType_t type) {
+    switch(type) {
+        case CONFIG_UINT32:
+        case CONFIG_INT32:
+        case CONFIG_FLOAT:
+            return 4;
+        case CONFIG_UINT64:
+        case CONFIG_INT64:
+        case CONFIG_DOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+CfgRet_t config_parseNumber(ConfigType_t type, const char* str, uint32_t len, void* value, uint32_t* consumed) {
+    switch(type) {
+        default:
+            return CFG_RC_ERROR_INVALID;
+        case CONFIG_UINT32:
+            return config_parseUint32(str, len, value, consumed);
+        case CONFIG_INT32:
+            return config_parseInt32(str, len, value, consumed);
+        case CONFIG_FLOAT:
+            return config_parseFloat(str, len, value, consumed);
+        case CONFIG_UINT64:
+            return config_parseUint64(str, len, value, consumed);
+        case CONFIG_INT64:
+            return config_parseInt64(str, len, value, consumed);
+        case CONFIG_DOUBLE:
+            return config_parseDouble(str, len, value, consumed);
+    }
+}
@@ -0,0 +1,68 @@
+#include "config_parallel.h"
+
+#if CFG_PARALLEL_SUPPORTED
+    #include <pthread.h>
+#endif
+
+typedef struct {
+    ConfigParallelJob_t* jobs;
+    uint32_t job_count;
+    // Index of the next job which has not been taken by any thread
+    uint32_t next;
+    bool save;
+} ConfigParallelQueue_t;
+
+static void config_parallelRunJob(const ConfigParallelQueue_t* queue, ConfigParallelJob_t* job) {
+    if(queue->save) job->result = config_saveToFile(job->cfg, job->filename);
+    else job->result = config_loadFromFile(job->cfg, job->filename);
+}
+
+#if CFG_PARALLEL_SUPPORTED
+// Takes jobs until none are left
+static void* config_parallelWorker(void* arg) {
+    ConfigParallelQueue_t* queue = arg;
+    while(true) {
+        const uint32_t i = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED);
+        if(i >= queue->job_count) break;
+        config_parallelRunJob(queue, &(queue->jobs[i]));
+    }
+    return NULL;
+}
+
+static void config_parallelRun(ConfigParallelQueue_t* queue, uint32_t thread_count) {
+    if(thread_count > CFG_PARALLEL_MAX_THREADS) thread_count = CFG_PARALLEL_MAX_THREADS;
+    if(thread_count > queue->job_count) thread_count = queue->job_count;
+    pthread_t threads[CFG_PARALLEL_MAX_THREADS];
+    uint32_t started = 0;
+    // The calling thread is one of the workers. If a thread cannot be created, the others take its jobs
+    for(uint32_t i = 1; i < thread_count; i++) {
+        if(pthread_create(&threads[started], NULL, config_parallelWorker, queue) == 0) started++;
+    }
+    config_parallelWorker(queue);
+    for(uint32_t i = 0; i < started; i++) pthread_join(threads[i], NULL);
+}
+#else
+static void config_parallelRun(ConfigParallelQueue_t* queue, uint32_t thread_count) {
+    (void)thread_count;
+    for(uint32_t i = 0; i < queue->job_count; i++) config_parallelRunJob(queue, &(queue->jobs[i]));
+}
+#endif
+
+static CfgRet_t config_parallelRunJobs(ConfigParallelJob_t* jobs, uint32_t job_count, uint32_t thread_count,
+                                       bool save) {
+    if(jobs == NULL && job_count > 0) return CFG_RC_ERROR_NULLPTR;
+    ConfigParallelQueue_t queue = {jobs, job_count, 0, save};
+    config_parallelRun(&queue, thread_count);
+    for(uint32_t i = 0; i < job_count; i++) {
+        if(jobs[i].result != CFG_RC_SUCCESS) return CFG_RC_ERROR_INCOMPLETE;
+    }
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_parallelLoad(ConfigParallelJob_t* jobs, uint32_t job_count, uint32_t thread_count) {
+    return config_parallelRunJobs(jobs, job_count, thread_count, false);
+}
+
+CfgRet_t config_parallelSave(ConfigParallelJob_t* jobs, uint32_t job_count, uint32_t thread_count) {
+    return config_parallelRunJobs(jobs, job_count, thread_count, true);
+}
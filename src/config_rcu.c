@@ -0,0 +1,158 @@
+#include "config_rcu.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if CFG_RCU_SUPPORTED
+
+static uint32_t config_alignSnapshotValue(uint32_t offset) {
+    return (offset + CFG_RCU_ALIGNMENT - 1) & ~(uint32_t)(CFG_RCU_ALIGNMENT - 1);
+}
+
+// Allocates a snapshot and its values in one block and copies the current values of the table
+static ConfigSnapshot_t* config_rcuCreateSnapshot(const ConfigRcu_t* rcu) {
+    const uint32_t header_size = config_alignSnapshotValue(sizeof(ConfigSnapshot_t));
+    ConfigSnapshot_t* snapshot = malloc(header_size + rcu->values_size);
+    if(snapshot == NULL) return NULL;
+    snapshot->cfg = rcu->cfg;
+    snapshot->generation = rcu->generation;
+    snapshot->offsets = rcu->offsets;
+    snapshot->values = (uint8_t*)snapshot + header_size;
+    snapshot->retired_epoch = 0;
+    snapshot->next_retired = NULL;
+    for(uint32_t i = 0; i < rcu->cfg->count; i++) {
+        const uint32_t size = rcu->cfg->entries[i].size;
+        config_copyValueByIdx(rcu->cfg, i, snapshot->values + rcu->offsets[i], size);
+    }
+    return snapshot;
+}
+
+CfgRet_t config_rcuInit(ConfigRcu_t* rcu, ConfigTable_t* cfg, ConfigRcuReader_t* readers, uint32_t reader_count) {
+    if(rcu == NULL || cfg == NULL || readers == NULL) return CFG_RC_ERROR_NULLPTR;
+    memset(rcu, 0, sizeof(*rcu));
+    memset(readers, 0, reader_count * sizeof(ConfigRcuReader_t));
+    rcu->offsets = malloc((cfg->count > 0 ? cfg->count : 1) * sizeof(uint32_t));
+    if(rcu->offsets == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        rcu->offsets[i] = rcu->values_size;
+        rcu->values_size += config_alignSnapshotValue(cfg->entries[i].size);
+    }
+    rcu->cfg = cfg;
+    rcu->generation = cfg->generation;
+    rcu->readers = readers;
+    rcu->reader_count = reader_count;
+    // Epoch 0 marks readers outside of their read-side section
+    rcu->epoch = 1;
+    rcu->current = config_rcuCreateSnapshot(rcu);
+    if(rcu->current == NULL) {
+        free(rcu->offsets);
+        memset(rcu, 0, sizeof(*rcu));
+        return CFG_RC_ERROR_TOO_LARGE;
+    }
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_rcuPublish(ConfigRcu_t* rcu) {
+    if(rcu == NULL || rcu->current == NULL) return CFG_RC_ERROR_NULLPTR;
+    // The offsets were computed for the entry order at initialization
+    if(rcu->generation != rcu->cfg->generation) return CFG_RC_ERROR_INVALID;
+    ConfigSnapshot_t* snapshot = config_rcuCreateSnapshot(rcu);
+    if(snapshot == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    ConfigSnapshot_t* old = rcu->current;
+    __atomic_store_n(&rcu->current, snapshot, __ATOMIC_SEQ_CST);
+    // Readers entering with a later epoch are guaranteed to see the new snapshot
+    old->retired_epoch = __atomic_fetch_add(&rcu->epoch, 1, __ATOMIC_SEQ_CST);
+    old->next_retired = rcu->retired;
+    rcu->retired = old;
+    config_rcuReclaim(rcu);
+    return CFG_RC_SUCCESS;
+}
+
+const ConfigSnapshot_t* config_rcuReadLock(ConfigRcu_t* rcu, uint32_t reader) {
+    if(rcu == NULL || reader >= rcu->reader_count) return NULL;
+    const uint64_t epoch = __atomic_load_n(&rcu->epoch, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&rcu->readers[reader].epoch, epoch, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&rcu->current, __ATOMIC_SEQ_CST);
+}
+
+void config_rcuReadUnlock(ConfigRcu_t* rcu, uint32_t reader) {
+    if(rcu == NULL || reader >= rcu->reader_count) return;
+    __atomic_store_n(&rcu->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+uint32_t config_rcuReclaim(ConfigRcu_t* rcu) {
+    if(rcu == NULL) return 0;
+    // A snapshot retired in epoch E can only be referenced by readers which entered in epoch E or earlier
+    uint64_t oldest_reader = UINT64_MAX;
+    for(uint32_t i = 0; i < rcu->reader_count; i++) {
+        const uint64_t epoch = __atomic_load_n(&rcu->readers[i].epoch, __ATOMIC_SEQ_CST);
+        if(epoch != 0 && epoch < oldest_reader) oldest_reader = epoch;
+    }
+    uint32_t pending = 0;
+    ConfigSnapshot_t** link = &rcu->retired;
+    while(*link != NULL) {
+        ConfigSnapshot_t* snapshot = *link;
+        if(snapshot->retired_epoch < oldest_reader) {
+            *link = snapshot->next_retired;
+            free(snapshot);
+        } else {
+            pending++;
+            link = &snapshot->next_retired;
+        }
+    }
+    return pending;
+}
+
+void config_rcuDestroy(ConfigRcu_t* rcu) {
+    if(rcu == NULL) return;
+    while(rcu->retired != NULL) {
+        ConfigSnapshot_t* next = rcu->retired->next_retired;
+        free(rcu->retired);
+        rcu->retired = next;
+    }
+    free(rcu->current);
+    free(rcu->offsets);
+    memset(rcu, 0, sizeof(*rcu));
+}
+
+#else
+
+CfgRet_t config_rcuInit(ConfigRcu_t* rcu, ConfigTable_t* cfg, ConfigRcuReader_t* readers, uint32_t reader_count) {
+    if(rcu == NULL || cfg == NULL || readers == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_rcuPublish(ConfigRcu_t* rcu) {
+    if(rcu == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+const ConfigSnapshot_t* config_rcuReadLock(ConfigRcu_t* rcu, uint32_t reader) {
+    return NULL;
+}
+
+void config_rcuReadUnlock(ConfigRcu_t* rcu, uint32_t reader) {
+}
+
+uint32_t config_rcuReclaim(ConfigRcu_t* rcu) {
+    return 0;
+}
+
+void config_rcuDestroy(ConfigRcu_t* rcu) {
+}
+
+#endif
+
+const void* config_snapshotGetValue(const ConfigSnapshot_t* snapshot, uint32_t idx) {
+    if(snapshot == NULL || idx >= snapshot->cfg->count) return NULL;
+    return snapshot->values + snapshot->offsets[idx];
+}
+
+const void* config_snapshotGetValueByKey(const ConfigSnapshot_t* snapshot, const char* key) {
+    if(snapshot == NULL || key == NULL) return NULL;
+    // Indices of a sorted table do not match the entry order of the snapshot anymore
+    if(snapshot->generation != snapshot->cfg->generation) return NULL;
+    const int32_t idx = config_getIdxFromKey(snapshot->cfg, key);
+    if(idx < 0) return NULL;
+    return config_snapshotGetValue(snapshot, idx);
+}
@@ -0,0 +1,206 @@
+#include "config_saver.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if CFG_SAVER_SUPPORTED
+    #include <errno.h>
+    #include <time.h>
+
+    // Values in the private copy start at multiples of this alignment
+    #define SAVER_VALUE_ALIGNMENT (8)
+
+static uint32_t config_alignShadowValue(uint32_t offset) {
+    return (offset + SAVER_VALUE_ALIGNMENT - 1) & ~(uint32_t)(SAVER_VALUE_ALIGNMENT - 1);
+}
+
+static uint64_t config_monotonicMicros(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+// Copies the current values of the table into the private copy
+static CfgRet_t config_saverCopyValues(ConfigSaver_t* saver) {
+    if(saver->lock != NULL) saver->lock(saver->lock_ctx);
+    CfgRet_t ret = CFG_RC_SUCCESS;
+    // The keys and sizes of the private copy belong to the entry order at start
+    if(saver->cfg->generation != saver->generation) ret = CFG_RC_ERROR_INVALID;
+    for(uint32_t i = 0; i < saver->cfg->count && ret == CFG_RC_SUCCESS; i++) {
+        ret = config_copyValueByIdx(saver->cfg, i, saver->shadow_entries[i].value, saver->shadow_entries[i].size);
+    }
+    if(saver->unlock != NULL) saver->unlock(saver->lock_ctx);
+    return ret;
+}
+
+static void* config_saverThread(void* arg) {
+    ConfigSaver_t* saver = arg;
+    pthread_mutex_lock(&saver->mutex);
+    while(true) {
+        while(saver->requested == saver->saved && !saver->stop) pthread_cond_wait(&saver->cond, &saver->mutex);
+        if(saver->requested == saver->saved) break;
+
+        // Debounce window starting with the first unsaved request
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += saver->debounce_ms / 1000;
+        deadline.tv_nsec += (long)(saver->debounce_ms % 1000) * 1000000L;
+        if(deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while(!saver->flush && !saver->stop) {
+            if(pthread_cond_timedwait(&saver->cond, &saver->mutex, &deadline) == ETIMEDOUT) break;
+        }
+        const uint32_t requested = saver->requested;
+        pthread_mutex_unlock(&saver->mutex);
+
+        const uint64_t start = config_monotonicMicros();
+        CfgRet_t ret = config_saverCopyValues(saver);
+        if(ret == CFG_RC_SUCCESS) ret = config_saveToFile(&saver->shadow, saver->filename);
+        const uint64_t latency = config_monotonicMicros() - start;
+
+        pthread_mutex_lock(&saver->mutex);
+        saver->saved = requested;
+        if(saver->saved == saver->requested) saver->flush = false;
+        saver->stats.last_error = ret;
+        saver->stats.last_latency_us = latency > UINT32_MAX ? UINT32_MAX : (uint32_t)latency;
+        saver->stats.save_count++;
+        pthread_cond_broadcast(&saver->cond);
+    }
+    pthread_mutex_unlock(&saver->mutex);
+    return NULL;
+}
+
+CfgRet_t config_saverStart(ConfigSaver_t* saver, ConfigTable_t* cfg, const char* filename, uint32_t debounce_ms) {
+    if(saver == NULL || cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    const uint32_t count = cfg->count > 0 ? cfg->count : 1;
+    uint32_t values_size = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) values_size += config_alignShadowValue(cfg->entries[i].size);
+    ConfigEntry_t* shadow_entries = malloc(count * sizeof(ConfigEntry_t));
+    uint8_t* shadow_values = malloc(values_size > 0 ? values_size : 1);
+    if(shadow_entries == NULL || shadow_values == NULL) {
+        free(shadow_entries);
+        free(shadow_values);
+        return CFG_RC_ERROR_TOO_LARGE;
+    }
+    uint32_t offset = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        shadow_entries[i] = cfg->entries[i];
+        shadow_entries[i].value = shadow_values + offset;
+#if CFG_THREAD_SAFE
+        // Only the saving thread accesses the private copy
+        shadow_entries[i].seq = 0;
+#endif
+        offset += config_alignShadowValue(cfg->entries[i].size);
+    }
+
+    saver->cfg = cfg;
+    saver->filename = filename;
+    saver->debounce_ms = debounce_ms;
+    memset(&saver->shadow, 0, sizeof(saver->shadow));
+    saver->shadow.entries = shadow_entries;
+    saver->shadow.count = cfg->count;
+    saver->shadow.io = cfg->io;
+    saver->shadow_entries = shadow_entries;
+    saver->shadow_values = shadow_values;
+    saver->generation = cfg->generation;
+    saver->requested = 0;
+    saver->saved = 0;
+    saver->flush = false;
+    saver->stop = false;
+    memset(&saver->stats, 0, sizeof(saver->stats));
+    saver->stats.last_error = CFG_RC_SUCCESS;
+    pthread_mutex_init(&saver->mutex, NULL);
+    pthread_cond_init(&saver->cond, NULL);
+    if(pthread_create(&saver->thread, NULL, config_saverThread, saver) != 0) {
+        pthread_cond_destroy(&saver->cond);
+        pthread_mutex_destroy(&saver->mutex);
+        free(shadow_entries);
+        free(shadow_values);
+        saver->cfg = NULL;
+        return CFG_RC_ERROR;
+    }
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_saverRequest(ConfigSaver_t* saver) {
+    if(saver == NULL || saver->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    pthread_mutex_lock(&saver->mutex);
+    saver->requested++;
+    saver->stats.request_count++;
+    pthread_cond_broadcast(&saver->cond);
+    pthread_mutex_unlock(&saver->mutex);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_saverFlush(ConfigSaver_t* saver) {
+    if(saver == NULL || saver->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    pthread_mutex_lock(&saver->mutex);
+    const uint32_t target = saver->requested;
+    if(saver->saved != target) {
+        saver->flush = true;
+        pthread_cond_broadcast(&saver->cond);
+        // The thread may save more than the target at once. The difference handles wrapping counters
+        while((int32_t)(target - saver->saved) > 0) pthread_cond_wait(&saver->cond, &saver->mutex);
+    }
+    const CfgRet_t ret = saver->stats.last_error;
+    pthread_mutex_unlock(&saver->mutex);
+    return ret;
+}
+
+CfgRet_t config_saverGetStats(ConfigSaver_t* saver, ConfigSaverStats_t* stats) {
+    if(saver == NULL || stats == NULL || saver->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    pthread_mutex_lock(&saver->mutex);
+    *stats = saver->stats;
+    pthread_mutex_unlock(&saver->mutex);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_saverStop(ConfigSaver_t* saver) {
+    if(saver == NULL || saver->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    pthread_mutex_lock(&saver->mutex);
+    saver->stop = true;
+    pthread_cond_broadcast(&saver->cond);
+    pthread_mutex_unlock(&saver->mutex);
+    pthread_join(saver->thread, NULL);
+
+    const CfgRet_t ret = saver->stats.last_error;
+    pthread_cond_destroy(&saver->cond);
+    pthread_mutex_destroy(&saver->mutex);
+    free(saver->shadow_entries);
+    free(saver->shadow_values);
+    saver->shadow_entries = NULL;
+    saver->shadow_values = NULL;
+    saver->cfg = NULL;
+    return ret;
+}
+
+#else
+
+CfgRet_t config_saverStart(ConfigSaver_t* saver, ConfigTable_t* cfg, const char* filename, uint32_t debounce_ms) {
+    if(saver == NULL || cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_saverRequest(ConfigSaver_t* saver) {
+    if(saver == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_saverFlush(ConfigSaver_t* saver) {
+    if(saver == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_saverGetStats(ConfigSaver_t* saver, ConfigSaverStats_t* stats) {
+    if(saver == NULL || stats == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_saverStop(ConfigSaver_t* saver) {
+    if(saver == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+#endif
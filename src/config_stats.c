@@ -0,0 +1,135 @@
+#include "config_stats.h"
+
+#include <stddef.h>
+
+
+uint64_t config_histogramPercentile(const ConfigHistogram_t* histogram, uint32_t percent) {
+    if(histogram == NULL || histogram->count == 0) return 0;
+    if(percent > 100) percent = 100;
+    // Rank of the requested measurement, rounded up so that 100 percent is the last one
+    const uint64_t rank = (histogram->count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for(uint32_t i = 0; i < CFG_STATS_BUCKET_COUNT; i++) {
+        seen += histogram->buckets[i];
+        if(seen >= rank && seen > 0) {
+            // The last bucket has no upper bound
+            if(i == CFG_STATS_BUCKET_COUNT - 1) break;
+            const uint64_t upper = ((uint64_t)1 << i) - 1;
+            return upper < histogram->max_us ? upper : histogram->max_us;
+        }
+    }
+    return histogram->max_us;
+}
+
+#if CFG_STATS
+    #if defined(__unix__) || defined(__APPLE__)
+        #include <time.h>
+        #define STATS_HAS_DEFAULT_CLOCK (1)
+    #else
+        #define STATS_HAS_DEFAULT_CLOCK (0)
+    #endif
+
+// Reads the clock of the statistics. Returns false if no clock is available
+static bool config_statsNow(const ConfigStats_t* stats, uint64_t* now) {
+    if(stats->clock != NULL) {
+        *now = stats->clock();
+        return true;
+    }
+    #if STATS_HAS_DEFAULT_CLOCK
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    *now = (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+// Histogram bucket of a duration, see CFG_STATS_BUCKET_COUNT
+static uint32_t config_statsBucket(uint64_t duration_us) {
+    if(duration_us == 0) return 0;
+    const uint32_t bucket = 64 - (uint32_t)__builtin_clzll(duration_us);
+    return bucket < CFG_STATS_BUCKET_COUNT ? bucket : CFG_STATS_BUCKET_COUNT - 1;
+}
+
+static void config_statsClear(ConfigStats_t* stats) {
+    for(uint32_t i = 0; i < CFG_STAT_COUNTER_COUNT; i++) __atomic_store_n(&stats->counters[i], 0, __ATOMIC_RELAXED);
+    for(uint32_t i = 0; i < CFG_STAT_HISTOGRAM_COUNT; i++) {
+        ConfigHistogram_t* h = &(stats->histograms[i]);
+        for(uint32_t b = 0; b < CFG_STATS_BUCKET_COUNT; b++) __atomic_store_n(&h->buckets[b], 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&h->count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&h->total_us, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&h->max_us, 0, __ATOMIC_RELAXED);
+    }
+}
+
+uint64_t config_statsStart(const ConfigTable_t* cfg) {
+    uint64_t now = 0;
+    config_statsNow(cfg->stats, &now);
+    return now;
+}
+
+void config_statsRecord(const ConfigTable_t* cfg, ConfigStatHistogram_t histogram, uint64_t start) {
+    uint64_t now;
+    if(!config_statsNow(cfg->stats, &now)) return;
+    const uint64_t duration = now > start ? now - start : 0;
+    ConfigHistogram_t* h = &(cfg->stats->histograms[histogram]);
+    __atomic_fetch_add(&h->buckets[config_statsBucket(duration)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->total_us, duration, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&h->max_us, __ATOMIC_RELAXED);
+    while(duration > max &&
+          !__atomic_compare_exchange_n(&h->max_us, &max, duration, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+CfgRet_t config_statsAttach(ConfigTable_t* cfg, ConfigStats_t* stats) {
+    if(cfg == NULL || stats == NULL) return CFG_RC_ERROR_NULLPTR;
+    config_statsClear(stats);
+    cfg->stats = stats;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_statsRead(const ConfigTable_t* cfg, ConfigStats_t* stats) {
+    if(cfg == NULL || stats == NULL || cfg->stats == NULL) return CFG_RC_ERROR_NULLPTR;
+    stats->clock = cfg->stats->clock;
+    for(uint32_t i = 0; i < CFG_STAT_COUNTER_COUNT; i++) {
+        stats->counters[i] = __atomic_load_n(&cfg->stats->counters[i], __ATOMIC_RELAXED);
+    }
+    for(uint32_t i = 0; i < CFG_STAT_HISTOGRAM_COUNT; i++) {
+        const ConfigHistogram_t* src = &(cfg->stats->histograms[i]);
+        ConfigHistogram_t* dst = &(stats->histograms[i]);
+        for(uint32_t b = 0; b < CFG_STATS_BUCKET_COUNT; b++) {
+            dst->buckets[b] = __atomic_load_n(&src->buckets[b], __ATOMIC_RELAXED);
+        }
+        dst->count = __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+        dst->total_us = __atomic_load_n(&src->total_us, __ATOMIC_RELAXED);
+        dst->max_us = __atomic_load_n(&src->max_us, __ATOMIC_RELAXED);
+    }
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_statsReset(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->stats == NULL) return CFG_RC_ERROR_NULLPTR;
+    config_statsClear(cfg->stats);
+    return CFG_RC_SUCCESS;
+}
+
+#else
+
+CfgRet_t config_statsAttach(ConfigTable_t* cfg, ConfigStats_t* stats) {
+    if(cfg == NULL || stats == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_statsRead(const ConfigTable_t* cfg, ConfigStats_t* stats) {
+    if(cfg == NULL || stats == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+CfgRet_t config_statsReset(ConfigTable_t* cfg) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    return CFG_RC_ERROR_INVALID;
+}
+
+#endif
@@ -0,0 +1,300 @@
+#include "config_stream.h"
+#include "config_notify.h"
+#include "config_number.h"
+#include "config_stats.h"
+
+#include <ctype.h>
+#include <string.h>
+
+// Number of buffer bytes needed for the value of an entry. Numbers and booleans are parsed on the stack
+static uint32_t config_streamValueSize(const ConfigEntry_t* e) {
+    // A string may be enclosed in delimiters, which are only removed once the line is complete
+    if(e->type == CONFIG_STRING) return e->size + 1;
+    if(config_arrayElementType(e->type) != CONFIG_NONE) return e->size;
+    return 0;
+}
+
+// Resets the parser state for the next line
+static void config_streamResetLine(ConfigStream_t* stream) {
+    stream->state = CFG_STREAM_STATE_KEY;
+    stream->line_error = CFG_RC_SUCCESS;
+    stream->key_len = 0;
+    stream->number_len = 0;
+    stream->value_len = 0;
+    stream->trimmed_len = 0;
+    stream->has_value = false;
+    stream->number_done = false;
+    stream->expect_element = true;
+}
+
+// Ignores the rest of the line. The error is reported once the line is complete
+static void config_streamFail(ConfigStream_t* stream, CfgRet_t error) {
+    stream->line_error = error;
+    stream->state = CFG_STREAM_STATE_SKIP;
+}
+
+// Resolves the key once the separator has been found
+static void config_streamStartValue(ConfigStream_t* stream) {
+    while(stream->key_len > 0 && stream->key_len <= CFG_STREAM_KEY_LEN &&
+          isspace((unsigned char)stream->key[stream->key_len - 1])) {
+        stream->key_len--;
+    }
+    if(stream->key_len > CFG_STREAM_KEY_LEN) {
+        config_streamFail(stream, CFG_RC_ERROR_UNKNOWN_KEY);
+        return;
+    }
+    stream->key[stream->key_len] = '\0';
+    const int32_t idx = config_getIdxFromKey(stream->cfg, stream->key);
+    if(idx < 0) {
+        config_streamFail(stream, CFG_RC_ERROR_UNKNOWN_KEY);
+        return;
+    }
+    const ConfigEntry_t* entry = &(stream->cfg->entries[idx]);
+    if(entry->type == CONFIG_NONE || entry->type > CONFIG_DOUBLE_ARRAY) {
+        config_streamFail(stream, CFG_RC_ERROR_INVALID);
+        return;
+    }
+    if(config_streamValueSize(entry) > stream->buffer_size) {
+        config_streamFail(stream, CFG_RC_ERROR_TOO_LARGE);
+        return;
+    }
+    stream->idx = (uint32_t)idx;
+    stream->state = CFG_STREAM_STATE_VALUE;
+}
+
+static void config_streamKeyChar(ConfigStream_t* stream, char c) {
+    const bool space = isspace((unsigned char)c);
+    if(c == KV_SEP_CHAR) {
+        config_streamStartValue(stream);
+    } else if(stream->key_len < CFG_STREAM_KEY_LEN) {
+        // Leading whitespace is skipped, trailing whitespace is removed at the separator
+        if(stream->key_len > 0 || !space) stream->key[stream->key_len++] = c;
+    } else if(!space) {
+        // Too long for any key, whitespace may still be trailing
+        stream->key_len = CFG_STREAM_KEY_LEN + 1;
+    }
+}
+
+// Parses the collected number into the next array element
+static bool config_streamArrayElement(ConfigStream_t* stream, ConfigType_t element_type) {
+    const uint32_t element_size = config_numberSize(element_type);
+    uint64_t element;
+    const CfgRet_t ret = config_parseNumber(element_type, stream->number, stream->number_len, &element, NULL);
+    if(ret != CFG_RC_SUCCESS) {
+        config_streamFail(stream, ret);
+        return false;
+    }
+    memcpy(stream->buffer + stream->value_len * element_size, &element, element_size);
+    stream->value_len++;
+    stream->number_len = 0;
+    return true;
+}
+
+static void config_streamArrayChar(ConfigStream_t* stream, const ConfigEntry_t* entry, char c, bool space) {
+    const ConfigType_t element_type = config_arrayElementType(entry->type);
+    if(c == ',' || space) {
+        if(stream->number_len > 0) {
+            if(!config_streamArrayElement(stream, element_type)) return;
+        } else if(c == ',' && stream->expect_element) {
+            // Element before the comma is missing
+            config_streamFail(stream, CFG_RC_ERROR_FORMAT);
+            return;
+        }
+        if(c == ',') stream->expect_element = true;
+    } else if(stream->number_len > 0) {
+        if(stream->number_len == CFG_STREAM_NUMBER_LEN) {
+            config_streamFail(stream, CFG_RC_ERROR_TOO_LARGE);
+            return;
+        }
+        stream->number[stream->number_len++] = c;
+    } else if(!stream->expect_element) {
+        // Elements have to be separated by a comma
+        config_streamFail(stream, CFG_RC_ERROR_FORMAT);
+    } else if(stream->value_len >= entry->size / config_numberSize(element_type)) {
+        config_streamFail(stream, CFG_RC_ERROR_TOO_LARGE);
+    } else {
+        stream->number[stream->number_len++] = c;
+        stream->expect_element = false;
+    }
+}
+
+static void config_streamValueChar(ConfigStream_t* stream, char c) {
+    const ConfigEntry_t* entry = &(stream->cfg->entries[stream->idx]);
+    const bool space = isspace((unsigned char)c);
+    // Leading whitespace is skipped
+    if(!stream->has_value) {
+        if(space) return;
+        stream->has_value = true;
+    }
+    switch(entry->type) {
+        default:
+            config_streamArrayChar(stream, entry, c, space);
+            break;
+        case CONFIG_STRING:
+            if(stream->value_len < entry->size + 1) {
+                stream->buffer[stream->value_len++] = (uint8_t)c;
+                if(!space) stream->trimmed_len = stream->value_len;
+            } else if(!space) {
+                config_streamFail(stream, CFG_RC_ERROR_TOO_LARGE);
+            }
+            break;
+        case CONFIG_BOOL:
+            // Only the first character is relevant
+            if(c == 'T' || c == 't' || c == '1') stream->value_len = 1;
+            else if(c == 'F' || c == 'f' || c == '0') stream->value_len = 0;
+            else config_streamFail(stream, CFG_RC_ERROR);
+            stream->state = CFG_STREAM_STATE_SKIP;
+            break;
+        case CONFIG_UINT32:
+        case CONFIG_INT32:
+        case CONFIG_FLOAT:
+        case CONFIG_UINT64:
+        case CONFIG_INT64:
+        case CONFIG_DOUBLE:
+            if(space) {
+                stream->number_done = true;
+            } else if(stream->number_done) {
+                // Only trailing whitespace may follow the number
+                config_streamFail(stream, CFG_RC_ERROR_FORMAT);
+            } else if(stream->number_len == CFG_STREAM_NUMBER_LEN) {
+                config_streamFail(stream, CFG_RC_ERROR_TOO_LARGE);
+            } else {
+                stream->number[stream->number_len++] = c;
+            }
+            break;
+    }
+}
+
+// Writes the value of a completed line into its entry
+static CfgRet_t config_streamApply(ConfigStream_t* stream) {
+    ConfigTable_t* cfg = stream->cfg;
+    const ConfigEntry_t* entry = &(cfg->entries[stream->idx]);
+    switch(entry->type) {
+        default: {
+                const ConfigType_t element_type = config_arrayElementType(entry->type);
+                if(stream->number_len > 0 && !config_streamArrayElement(stream, element_type)) {
+                    return stream->line_error;
+                }
+                // A trailing comma is missing its element
+                if(stream->expect_element && stream->value_len > 0) return CFG_RC_ERROR_FORMAT;
+                return config_setByIdx(cfg, stream->idx, stream->buffer,
+                                       stream->value_len * config_numberSize(element_type));
+            }
+        case CONFIG_STRING: {
+                const uint8_t* value = stream->buffer;
+                uint32_t len = stream->trimmed_len;
+                if(len >= 2 && value[0] == '"' && value[len - 1] == '"') {
+                    value++;
+                    len -= 2;
+                }
+                // The remaining memory is zero filled, but at least one byte is needed for the null-terminator
+                if(len >= entry->size) return CFG_RC_ERROR_TOO_LARGE;
+                return config_setByIdx(cfg, stream->idx, value, len);
+            }
+        case CONFIG_BOOL: {
+                if(!stream->has_value) return CFG_RC_ERROR;
+                const bool value = stream->value_len != 0;
+                return config_setByIdx(cfg, stream->idx, &value, sizeof(value));
+            }
+        case CONFIG_UINT32:
+        case CONFIG_INT32:
+        case CONFIG_FLOAT:
+        case CONFIG_UINT64:
+        case CONFIG_INT64:
+        case CONFIG_DOUBLE: {
+                uint64_t value;
+                const CfgRet_t ret = config_parseNumber(entry->type, stream->number, stream->number_len, &value, NULL);
+                if(ret != CFG_RC_SUCCESS) return ret;
+                return config_setByIdx(cfg, stream->idx, &value, config_numberSize(entry->type));
+            }
+    }
+}
+
+// Applies or reports the current line and starts the next one
+static void config_streamEndLine(ConfigStream_t* stream) {
+    CfgRet_t ret = stream->line_error;
+    if(ret == CFG_RC_SUCCESS) {
+        if(stream->state != CFG_STREAM_STATE_KEY) ret = config_streamApply(stream);
+        // Lines with only whitespace are ignored, other lines need a separator
+        else if(stream->key_len > 0) ret = CFG_RC_ERROR_FORMAT;
+    }
+    if(ret != CFG_RC_SUCCESS) {
+        stream->error_count++;
+        CFG_STATS_ADD(stream->cfg, CFG_STAT_PARSE_ERRORS, 1);
+        if(stream->on_error != NULL) stream->on_error(stream->error_ctx, stream->line, ret);
+    }
+    stream->line++;
+    config_streamResetLine(stream);
+}
+
+uint32_t config_streamBufferSize(const ConfigTable_t* cfg) {
+    if(cfg == NULL) return 0;
+    uint32_t size = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const uint32_t value_size = config_streamValueSize(&(cfg->entries[i]));
+        if(value_size > size) size = value_size;
+    }
+    return size;
+}
+
+CfgRet_t config_streamBegin(ConfigStream_t* stream, ConfigTable_t* cfg) {
+    if(stream == NULL || cfg == NULL || stream->buffer == NULL) return CFG_RC_ERROR_NULLPTR;
+    // Every key of the table has to fit into the key storage, otherwise it could never be set
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const char* key = cfg->entries[i].key;
+        if(key == NULL) continue;
+        uint32_t key_len = 0;
+        while(key_len <= CFG_STREAM_KEY_LEN && key[key_len] != '\0') key_len++;
+        if(key_len > CFG_STREAM_KEY_LEN) {
+            stream->cfg = NULL;
+            return CFG_RC_ERROR_TOO_LARGE;
+        }
+    }
+    stream->cfg = cfg;
+    stream->line = 1;
+    stream->error_count = 0;
+    config_streamResetLine(stream);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_streamFeed(ConfigStream_t* stream, const char* data, uint32_t len) {
+    if(stream == NULL || data == NULL || stream->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const uint32_t error_count = stream->error_count;
+    CFG_STATS_ADD(stream->cfg, CFG_STAT_BYTES_READ, len);
+    // All entries changed by this chunk are notified together
+    config_notifyBeginBatch(stream->cfg);
+    for(uint32_t i = 0; i < len; i++) {
+        const char c = data[i];
+        if(c == '\n') {
+            config_streamEndLine(stream);
+            continue;
+        }
+        switch(stream->state) {
+            case CFG_STREAM_STATE_KEY:
+                config_streamKeyChar(stream, c);
+                break;
+            case CFG_STREAM_STATE_VALUE:
+                config_streamValueChar(stream, c);
+                break;
+            case CFG_STREAM_STATE_SKIP: {
+                    // Continue at the line ending
+                    const char* end = memchr(data + i, '\n', len - i);
+                    i = (end != NULL ? (uint32_t)(end - data) : len) - 1;
+                    break;
+                }
+        }
+    }
+    config_notifyEndBatch(stream->cfg);
+    if(stream->error_count != error_count) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_streamEnd(ConfigStream_t* stream) {
+    if(stream == NULL || stream->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    config_notifyBeginBatch(stream->cfg);
+    config_streamEndLine(stream);
+    config_notifyEndBatch(stream->cfg);
+    stream->cfg = NULL;
+    if(stream->error_count > 0) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
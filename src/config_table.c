@@ -1,30 +1,170 @@
 #include "config_table.h"
+#include "config_internal.h"
+#include "config_log.h"
+#include "config_notify.h"
+#include "config_number.h"
+#include "config_stats.h"
+#include "config_tokenizer.h"
 
 #include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
-#include <errno.h>
 #include <stdio.h>
 
-#define KV_SEP_CHAR ':'
 // If set to 1 will remove string delimiters (") from strings values parsed in parseKVStr
 #define REMOVE_STRING_DELIMITERS (1)
 
 CfgRet_t config_defaultLoadFunc(ConfigTable_t* cfg, const char* filename);
 CfgRet_t config_defaultSaveFunc(const ConfigTable_t* cfg, const char* filename);
 
-loadFromFileFunc loadFromFileFunction = config_defaultLoadFunc;
-saveToFileFunc saveToFileFunction = config_defaultSaveFunc;
+static loadFromFileFunc loadFromFileFunction = config_defaultLoadFunc;
+static saveToFileFunc saveToFileFunction = config_defaultSaveFunc;
 
-int32_t config_getIdxFromKey(const ConfigTable_t* cfg, const char* key) {
-    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
-    for(int32_t i = 0; i < cfg->count; i++) {
-        const ConfigEntry_t entry = cfg->entries[i];
-        if(strcmp(key, entry.key) == 0) return i;
+// Load function of the io context of the table or the process-wide one
+static loadFromFileFunc config_getLoadFunction(const ConfigTable_t* cfg) {
+    if(cfg->io == NULL) return loadFromFileFunction;
+    return cfg->io->load != NULL ? cfg->io->load : config_defaultLoadFunc;
+}
+
+// Save function of the io context of the table or the process-wide one
+static saveToFileFunc config_getSaveFunction(const ConfigTable_t* cfg) {
+    if(cfg->io == NULL) return saveToFileFunction;
+    return cfg->io->save != NULL ? cfg->io->save : config_defaultSaveFunc;
+}
+
+// FNV-1a hash over the first len characters of key
+static uint32_t config_hashKey(const char* key, uint32_t len) {
+    uint32_t hash = 2166136261u;
+    for(uint32_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Maps a hash onto the slot range without a division
+static uint32_t config_hashToSlot(uint32_t hash, uint32_t slot_count) {
+    return (uint32_t)(((uint64_t)hash * slot_count) >> 32);
+}
+
+// Returns true if the entry key is exactly the first len characters of key
+static bool config_keyEquals(const char* entry_key, const char* key, uint32_t len) {
+    return strncmp(entry_key, key, len) == 0 && entry_key[len] == '\0';
+}
+
+// Looks up a key which does not need to be null-terminated
+static int32_t config_searchKey(const ConfigTable_t* cfg, const char* key, uint32_t len) {
+    const ConfigIndex_t* index = cfg->index;
+    if(index != NULL) {
+        const uint32_t hash = config_hashKey(key, len);
+        uint32_t slot = config_hashToSlot(hash, index->slot_count);
+        // Linear probing until an empty slot is hit
+        while(index->slots[slot].entry != 0) {
+            const ConfigIndexSlot_t* s = &(index->slots[slot]);
+            if(s->hash == hash && config_keyEquals(cfg->entries[s->entry - 1].key, key, len)) return s->entry - 1;
+            if(++slot == index->slot_count) slot = 0;
+        }
+        return -1;
+    }
+    if(cfg->sorted) {
+        uint32_t low = 0;
+        uint32_t high = cfg->count;
+        while(low < high) {
+            const uint32_t mid = low + (high - low) / 2;
+            const char* entry_key = cfg->entries[mid].key;
+            int32_t cmp = strncmp(entry_key, key, len);
+            // Entry keys which continue after the compared characters are larger
+            if(cmp == 0 && entry_key[len] != '\0') cmp = 1;
+            if(cmp == 0) return mid;
+            if(cmp < 0) low = mid + 1;
+            else high = mid;
+        }
+        return -1;
+    }
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        if(config_keyEquals(cfg->entries[i].key, key, len)) return i;
     }
     return -1;
 }
 
+// Looks up a key and counts the lookup
+static int32_t config_findKey(const ConfigTable_t* cfg, const char* key, uint32_t len) {
+    const int32_t idx = config_searchKey(cfg, key, len);
+    CFG_STATS_ADD(cfg, CFG_STAT_LOOKUPS, 1);
+    if(idx < 0) CFG_STATS_ADD(cfg, CFG_STAT_LOOKUP_MISSES, 1);
+    return idx;
+}
+
+// Counts a rejected access and returns CFG_RC_ERROR_TYPE_MISMATCH
+static CfgRet_t config_typeMismatch(const ConfigTable_t* cfg) {
+    CFG_STATS_ADD(cfg, CFG_STAT_TYPE_MISMATCHES, 1);
+    return CFG_RC_ERROR_TYPE_MISMATCH;
+}
+
+CfgRet_t config_buildIndex(ConfigTable_t* cfg, ConfigIndex_t* index) {
+    if(cfg == NULL || index == NULL || index->slots == NULL) return CFG_RC_ERROR_NULLPTR;
+    // At least one slot has to stay empty to terminate probe sequences
+    if(index->slot_count <= cfg->count) return CFG_RC_ERROR_TOO_LARGE;
+    memset(index->slots, 0, index->slot_count * sizeof(ConfigIndexSlot_t));
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const char* key = cfg->entries[i].key;
+        const uint32_t len = strlen(key);
+        const uint32_t hash = config_hashKey(key, len);
+        uint32_t slot = config_hashToSlot(hash, index->slot_count);
+        bool duplicate = false;
+        while(index->slots[slot].entry != 0) {
+            const ConfigIndexSlot_t* s = &(index->slots[slot]);
+            if(s->hash == hash && config_keyEquals(cfg->entries[s->entry - 1].key, key, len)) {
+                // Keep the first entry to match the behaviour of the linear search
+                duplicate = true;
+                break;
+            }
+            if(++slot == index->slot_count) slot = 0;
+        }
+        if(duplicate) continue;
+        index->slots[slot].hash = hash;
+        index->slots[slot].entry = i + 1;
+    }
+    cfg->index = index;
+    return CFG_RC_SUCCESS;
+}
+
+static int config_compareEntries(const void* a, const void* b) {
+    return strcmp(((const ConfigEntry_t*)a)->key, ((const ConfigEntry_t*)b)->key);
+}
+
+CfgRet_t config_sortTable(ConfigTable_t* cfg) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    cfg->sorted = false;
+    // Tables sorted at build time only need to be verified
+    bool in_order = true;
+    for(uint32_t i = 1; i < cfg->count && in_order; i++) {
+        if(config_compareEntries(&cfg->entries[i - 1], &cfg->entries[i]) > 0) in_order = false;
+    }
+    if(!in_order) {
+        config_notifyBeforeReorder(cfg);
+        qsort(cfg->entries, cfg->count, sizeof(ConfigEntry_t), config_compareEntries);
+        config_invalidateHandles(cfg);
+        if(cfg->index != NULL) config_buildIndex(cfg, cfg->index);
+        // Dirty bits refer to the old positions
+        if(cfg->dirty != NULL) {
+            for(uint32_t i = 0; i < cfg->count; i++) config_markDirty(cfg, i);
+        }
+        config_notifyAfterReorder(cfg);
+    }
+    // Duplicates are adjacent after sorting
+    for(uint32_t i = 1; i < cfg->count; i++) {
+        if(config_compareEntries(&cfg->entries[i - 1], &cfg->entries[i]) == 0) return CFG_RC_ERROR_DUPLICATE_KEY;
+    }
+    cfg->sorted = true;
+    return CFG_RC_SUCCESS;
+}
+
+int32_t config_getIdxFromKey(const ConfigTable_t* cfg, const char* key) {
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    return config_findKey(cfg, key, strlen(key));
+}
+
 CfgRet_t config_getByKey(const ConfigTable_t* cfg, const char* key, ConfigEntry_t* const entry) {
     if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
     const int32_t idx = config_getIdxFromKey(cfg, key);
@@ -47,32 +187,199 @@ CfgRet_t config_setByKey(ConfigTable_t* cfg, const char* key, const void* value,
 
     return config_setByIdx(cfg, idx, value, size);
 }
-CfgRet_t config_setByIdx(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size) {
-    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
-    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+
+/**
+ * Per-entry seqlocks, writers increment the sequence number of an entry before and after
+ * modifying its value. Readers copy the value and retry if the sequence number was odd or has changed.
+ * Without CFG_THREAD_SAFE all of these compile to plain accesses.
+ */
+
+#if CFG_THREAD_SAFE
+    #if !defined(__GNUC__) && !defined(__clang__)
+        #error "CFG_THREAD_SAFE requires the atomic builtins of GCC or Clang"
+    #endif
+
+// Returns the even sequence number of the entry, waiting for a running write to finish
+static uint32_t config_seqReadBegin(const ConfigEntry_t* e) {
+    uint32_t seq;
+    while((seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE)) & 1u) {
+    }
+    return seq;
+}
+
+// Returns true if the entry has been written since config_seqReadBegin returned seq
+static bool config_seqReadRetry(const ConfigEntry_t* e, uint32_t seq) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&e->seq, __ATOMIC_RELAXED) != seq;
+}
+
+static void config_seqWriteBegin(ConfigEntry_t* e) {
+    uint32_t seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+    // An odd sequence number marks a running write, which also excludes other writers
+    while((seq & 1u) || !__atomic_compare_exchange_n(&e->seq, &seq, seq + 1, true, __ATOMIC_ACQUIRE,
+                                                     __ATOMIC_RELAXED)) {
+        seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void config_seqWriteEnd(ConfigEntry_t* e) {
+    __atomic_store_n(&e->seq, __atomic_load_n(&e->seq, __ATOMIC_RELAXED) + 1, __ATOMIC_RELEASE);
+}
+
+static void config_setDirtyBit(uint32_t* bitmap, uint32_t idx) {
+    __atomic_fetch_or(&bitmap[idx / 32], 1u << (idx % 32), __ATOMIC_RELAXED);
+}
+
+static void config_clearDirtyBit(uint32_t* bitmap, uint32_t idx) {
+    __atomic_fetch_and(&bitmap[idx / 32], ~(1u << (idx % 32)), __ATOMIC_RELAXED);
+}
+#else
+static uint32_t config_seqReadBegin(const ConfigEntry_t* e) {
+    (void)e;
+    return 0;
+}
+
+static bool config_seqReadRetry(const ConfigEntry_t* e, uint32_t seq) {
+    (void)e;
+    (void)seq;
+    return false;
+}
+
+static void config_seqWriteBegin(ConfigEntry_t* e) {
+    (void)e;
+}
+
+static void config_seqWriteEnd(ConfigEntry_t* e) {
+    (void)e;
+}
+
+static void config_setDirtyBit(uint32_t* bitmap, uint32_t idx) {
+    bitmap[idx / 32] |= 1u << (idx % 32);
+}
+
+static void config_clearDirtyBit(uint32_t* bitmap, uint32_t idx) {
+    bitmap[idx / 32] &= ~(1u << (idx % 32));
+}
+#endif
+
+// Copies size bytes of the entry value, retrying while a write is in progress
+static void config_readValue(const ConfigEntry_t* e, void* value, uint32_t size) {
+    uint32_t seq;
+    do {
+        seq = config_seqReadBegin(e);
+        memcpy(value, e->value, size);
+    } while(config_seqReadRetry(e, seq));
+}
+
+// Length of a stored string, limited by the size of its entry
+static uint32_t config_storedStringLen(const ConfigEntry_t* e) {
+    const char* end = memchr(e->value, '\0', e->size);
+    return end == NULL ? e->size : (uint32_t)(end - (const char*)e->value);
+}
+
+// Copies the stored string including a null-terminator, retrying while a write is in progress
+static CfgRet_t config_readString(const ConfigEntry_t* e, char* str, uint32_t str_size) {
+    CfgRet_t ret;
+    uint32_t seq;
+    do {
+        seq = config_seqReadBegin(e);
+        const uint32_t len = config_storedStringLen(e);
+        if(len + 1 > str_size) {
+            ret = CFG_RC_ERROR_TOO_LARGE;
+        } else {
+            memcpy(str, e->value, len);
+            str[len] = '\0';
+            ret = CFG_RC_SUCCESS;
+        }
+    } while(config_seqReadRetry(e, seq));
+    return ret;
+}
+
+static bool config_getDirtyBit(const uint32_t* bitmap, uint32_t idx) {
+    return (bitmap[idx / 32] >> (idx % 32)) & 1u;
+}
+
+// Returns true if writing value would leave the stored value of the entry unchanged
+static bool config_isStoredValue(const ConfigEntry_t* entry, const void* value, uint32_t size) {
+    if(memcmp(entry->value, value, size) != 0) return false;
+    for(uint32_t i = size; i < entry->size; i++) {
+        if(((const uint8_t*)entry->value)[i] != 0) return false;
+    }
+    return true;
+}
+
+// Stores a value in an entry and marks it dirty and changed. The caller has to validate cfg, idx and value
+static CfgRet_t config_storeEntry(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size, bool* changed) {
+    *changed = false;
     ConfigEntry_t* entry = &(cfg->entries[idx]);
-    if(entry->perm == CFG_PERM_RO || entry->perm == CFG_PERM_SECRET_RO) return CFG_RC_ERROR_READ_ONLY;
+    if(entry->perm == CFG_PERM_RO || entry->perm == CFG_PERM_SECRET_RO) {
+        CFG_STATS_ADD(cfg, CFG_STAT_READ_ONLY_REJECTIONS, 1);
+        return CFG_RC_ERROR_READ_ONLY;
+    }
     if(size > entry->size) return CFG_RC_ERROR_TOO_LARGE;
+    CFG_STATS_ADD(cfg, CFG_STAT_SETS, 1);
+    config_seqWriteBegin(entry);
+    // Writes which do not change the stored value neither mark the entry dirty nor are logged
+    *changed = (cfg->dirty != NULL || cfg->log != NULL || cfg->notifier != NULL) &&
+               !config_isStoredValue(entry, value, size);
     memcpy(entry->value, value, size);
     // Fill remaining memory space with 0 to clear out possible leftover data
-    memset(entry->value + size, 0, entry->size - size);
+    memset((uint8_t*)entry->value + size, 0, entry->size - size);
+    config_seqWriteEnd(entry);
+    if(!*changed) return CFG_RC_SUCCESS;
+    if(cfg->dirty != NULL) config_setDirtyBit(cfg->dirty, idx);
+    if(cfg->notifier != NULL) config_notifyChanged(cfg, idx);
+    return CFG_RC_SUCCESS;
+}
+
+// Writes a value into an entry. The caller has to validate cfg, idx and value
+static CfgRet_t config_writeEntry(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size) {
+    bool changed;
+    const CfgRet_t ret = config_storeEntry(cfg, idx, value, size, &changed);
+    if(ret == CFG_RC_SUCCESS && changed && cfg->log != NULL) return config_logAppend(cfg, idx);
+    return ret;
+}
+
+CfgRet_t config_setByIdx(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    return config_writeEntry(cfg, idx, value, size);
+}
+
+CfgRet_t config_setByIdxUnlogged(ConfigTable_t* cfg, uint32_t idx, const void* value, uint32_t size, bool* changed) {
+    if(cfg == NULL || value == NULL || changed == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    return config_storeEntry(cfg, idx, value, size, changed);
+}
+
+CfgRet_t config_copyValueByIdx(const ConfigTable_t* cfg, uint32_t idx, void* value, uint32_t size) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    const ConfigEntry_t* entry = &(cfg->entries[idx]);
+    if(size < entry->size) return CFG_RC_ERROR_TOO_LARGE;
+    config_readValue(entry, value, entry->size);
     return CFG_RC_SUCCESS;
 }
 
+// Number of array elements stored in an entry
+static uint32_t config_arrayLength(const ConfigEntry_t* e) {
+    const uint32_t element_size = config_numberSize(config_arrayElementType(e->type));
+    if(element_size == 0) return 0;
+    return e->size / element_size;
+}
+
 /**
  * Type specific getter and setter functions
  * ===================================================================
  */
 
 CfgRet_t config_getUint32ByKey(const ConfigTable_t* cfg, const char* key, uint32_t* value) {
-    ConfigEntry_t entry;
-    CfgRet_t ret = config_getByKey(cfg, key, &entry);
-    if(CFG_RC_SUCCESS != ret) return ret;
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
 
-    // Check for possible type mismatch
-    if(entry.type != CONFIG_UINT32) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((uint32_t*)entry.value);
-    return CFG_RC_SUCCESS;
+    return config_getUint32ByIdx(cfg, idx, value);
 }
 CfgRet_t config_getUint32ByIdx(const ConfigTable_t* cfg, uint32_t idx, uint32_t* value) {
     ConfigEntry_t entry;
@@ -80,20 +387,17 @@ CfgRet_t config_getUint32ByIdx(const ConfigTable_t* cfg, uint32_t idx, uint32_t*
     if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_UINT32) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((uint32_t*)entry.value);
+    if(entry.type != CONFIG_UINT32) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
 
 CfgRet_t config_getInt32ByKey(const ConfigTable_t* cfg, const char* key, int32_t* value) {
-    ConfigEntry_t entry;
-    CfgRet_t ret = config_getByKey(cfg, key, &entry);
-    if(CFG_RC_SUCCESS != ret) return ret;
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
 
-    // Check for possible type mismatch
-    if(entry.type != CONFIG_INT32) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((int32_t*)entry.value);
-    return CFG_RC_SUCCESS;
+    return config_getInt32ByIdx(cfg, idx, value);
 }
 CfgRet_t config_getInt32ByIdx(const ConfigTable_t* cfg, uint32_t idx, int32_t* value) {
     ConfigEntry_t entry;
@@ -101,20 +405,17 @@ CfgRet_t config_getInt32ByIdx(const ConfigTable_t* cfg, uint32_t idx, int32_t* v
     if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_INT32) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((int32_t*)entry.value);
+    if(entry.type != CONFIG_INT32) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
 
 CfgRet_t config_getFloatByKey(const ConfigTable_t* cfg, const char* key, float* value) {
-    ConfigEntry_t entry;
-    CfgRet_t ret = config_getByKey(cfg, key, &entry);
-    if(CFG_RC_SUCCESS != ret) return ret;
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
 
-    // Check for possible type mismatch
-    if(entry.type != CONFIG_FLOAT) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((float*)entry.value);
-    return CFG_RC_SUCCESS;
+    return config_getFloatByIdx(cfg, idx, value);
 }
 CfgRet_t config_getFloatByIdx(const ConfigTable_t* cfg, uint32_t idx, float* value) {
     ConfigEntry_t entry;
@@ -122,164 +423,505 @@ CfgRet_t config_getFloatByIdx(const ConfigTable_t* cfg, uint32_t idx, float* val
     if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_FLOAT) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((float*)entry.value);
+    if(entry.type != CONFIG_FLOAT) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
 
 CfgRet_t config_getStringByKey(const ConfigTable_t* cfg, const char* key, char* str, uint32_t str_size) {
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+
+    return config_getStringByIdx(cfg, idx, str, str_size);
+}
+CfgRet_t config_getStringByIdx(const ConfigTable_t* cfg, uint32_t idx, char* str, uint32_t str_size) {
     ConfigEntry_t entry;
-    CfgRet_t ret = config_getByKey(cfg, key, &entry);
+    CfgRet_t ret = config_getByIdx(cfg, idx, &entry);
     if(CFG_RC_SUCCESS != ret) return ret;
 
+    // Check for possible type mismatch
+    if(entry.type != CONFIG_STRING) return config_typeMismatch(cfg);
+    // Size check and copy in one step, so a concurrent write cannot change the size in between
+    return config_readString(&(cfg->entries[idx]), str, str_size);
+}
+
+CfgRet_t config_getBoolByKey(const ConfigTable_t* cfg, const char* key, bool* value) {
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+
+    return config_getBoolByIdx(cfg, idx, value);
+}
+CfgRet_t config_getBoolByIdx(const ConfigTable_t* cfg, uint32_t idx, bool* value) {
+    ConfigEntry_t entry;
+    CfgRet_t ret = config_getByIdx(cfg, idx, &entry);
+    if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_STRING) return CFG_RC_ERROR_TYPE_MISMATCH;
-    // Size check
-    uint32_t stored_str_size = strlen(entry.value) + 1;
-    if(stored_str_size > str_size) return CFG_RC_ERROR_TOO_LARGE;
-    // Copy string
-    strncpy(str, (char*)entry.value, str_size);
+    if(entry.type != CONFIG_BOOL) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
-CfgRet_t config_getStringByIdx(const ConfigTable_t* cfg, uint32_t idx, char* str, uint32_t str_size) {
+
+CfgRet_t config_getUint64ByKey(const ConfigTable_t* cfg, const char* key, uint64_t* value) {
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+
+    return config_getUint64ByIdx(cfg, idx, value);
+}
+CfgRet_t config_getUint64ByIdx(const ConfigTable_t* cfg, uint32_t idx, uint64_t* value) {
     ConfigEntry_t entry;
     CfgRet_t ret = config_getByIdx(cfg, idx, &entry);
     if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_STRING) return CFG_RC_ERROR_TYPE_MISMATCH;
-    // size check
-    uint32_t stored_str_size = strlen(entry.value) + 1;
-    if(stored_str_size > str_size) return CFG_RC_ERROR_TOO_LARGE;
-    // copy string
-    strncpy(str, (char*)entry.value, str_size);
+    if(entry.type != CONFIG_UINT64) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
 
-CfgRet_t config_getBoolByKey(const ConfigTable_t* cfg, const char* key, bool* value) {
+CfgRet_t config_getInt64ByKey(const ConfigTable_t* cfg, const char* key, int64_t* value) {
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+
+    return config_getInt64ByIdx(cfg, idx, value);
+}
+CfgRet_t config_getInt64ByIdx(const ConfigTable_t* cfg, uint32_t idx, int64_t* value) {
     ConfigEntry_t entry;
-    CfgRet_t ret = config_getByKey(cfg, key, &entry);
+    CfgRet_t ret = config_getByIdx(cfg, idx, &entry);
     if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_BOOL) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((bool*)entry.value);
+    if(entry.type != CONFIG_INT64) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
-CfgRet_t config_getBoolByIdx(const ConfigTable_t* cfg, uint32_t idx, bool* value) {
+
+CfgRet_t config_getDoubleByKey(const ConfigTable_t* cfg, const char* key, double* value) {
+    if(cfg == NULL || key == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+
+    return config_getDoubleByIdx(cfg, idx, value);
+}
+CfgRet_t config_getDoubleByIdx(const ConfigTable_t* cfg, uint32_t idx, double* value) {
     ConfigEntry_t entry;
     CfgRet_t ret = config_getByIdx(cfg, idx, &entry);
     if(CFG_RC_SUCCESS != ret) return ret;
 
     // Check for possible type mismatch
-    if(entry.type != CONFIG_BOOL) return CFG_RC_ERROR_TYPE_MISMATCH;
-    *value = *((bool*)entry.value);
+    if(entry.type != CONFIG_DOUBLE) return config_typeMismatch(cfg);
+    config_readValue(&(cfg->entries[idx]), value, sizeof(*value));
     return CFG_RC_SUCCESS;
 }
 
+uint32_t config_getArrayLength(const ConfigTable_t* cfg, uint32_t idx) {
+    if(cfg == NULL || idx >= cfg->count) return 0;
+    return config_arrayLength(&(cfg->entries[idx]));
+}
+
 /**
- * Storage and parsing
+ * Handle based getter and setter functions
  * ===================================================================
  */
 
-CfgRet_t config_parseKVStr(ConfigTable_t* cfg, char* str, uint32_t len) {
+CfgRet_t config_getHandle(const ConfigTable_t* cfg, const char* key, ConfigType_t type, ConfigHandle_t* handle) {
+    if(cfg == NULL || key == NULL || handle == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(cfg, key);
+    if(idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+    if(cfg->entries[idx].type != type) return config_typeMismatch(cfg);
+    handle->idx = idx;
+    handle->type = type;
+    handle->generation = cfg->generation;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_getHandleByIdx(const ConfigTable_t* cfg, uint32_t idx, ConfigType_t type, ConfigHandle_t* handle) {
+    if(cfg == NULL || handle == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    if(cfg->entries[idx].type != type) return config_typeMismatch(cfg);
+    handle->idx = idx;
+    handle->type = type;
+    handle->generation = cfg->generation;
+    return CFG_RC_SUCCESS;
+}
+
+void config_invalidateHandles(ConfigTable_t* cfg) {
+    if(cfg == NULL) return;
+    cfg->generation++;
+}
+
+// Validates a handle against the table and the type expected by the accessor
+static CfgRet_t config_checkHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, ConfigType_t type) {
+    if(handle.generation != cfg->generation || handle.idx >= cfg->count) return CFG_RC_ERROR_INVALID;
+    if(handle.type != type) return config_typeMismatch(cfg);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_getUint32ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, uint32_t* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_UINT32);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getInt32ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, int32_t* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_INT32);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getFloatByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, float* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_FLOAT);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getBoolByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, bool* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_BOOL);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getUint64ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, uint64_t* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_UINT64);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getInt64ByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, int64_t* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_INT64);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getDoubleByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, double* value) {
+    if(cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_DOUBLE);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    config_readValue(&(cfg->entries[handle.idx]), value, sizeof(*value));
+    return CFG_RC_SUCCESS;
+}
+CfgRet_t config_getStringByHandle(const ConfigTable_t* cfg, ConfigHandle_t handle, char* str, uint32_t str_size) {
     if(cfg == NULL || str == NULL) return CFG_RC_ERROR_NULLPTR;
-    // First step, try to parse a key.
-    // Find the index of the key-value separator
-    char* value_str = strchr(str, KV_SEP_CHAR);
-    if(value_str == NULL) return CFG_RC_ERROR_FORMAT; // separator char not found
-    uint32_t sep_idx = (uint32_t)(value_str-str);
-    // advance by one to omit the separator char from value string
-    value_str++;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_STRING);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_readString(&(cfg->entries[handle.idx]), str, str_size);
+}
 
-    // trim leading whitespace
-    char* key_str = str;
-    while(isspace(key_str[0])) key_str++;
+CfgRet_t config_setUint32ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, uint32_t value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_UINT32);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setInt32ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, int32_t value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_INT32);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setFloatByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, float value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_FLOAT);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setBoolByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, bool value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_BOOL);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setUint64ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, uint64_t value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_UINT64);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setInt64ByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, int64_t value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_INT64);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setDoubleByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, double value) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_DOUBLE);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, &value, sizeof(value));
+}
+CfgRet_t config_setStringByHandle(ConfigTable_t* cfg, ConfigHandle_t handle, const char* str) {
+    if(cfg == NULL || str == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_checkHandle(cfg, handle, CONFIG_STRING);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    return config_writeEntry(cfg, handle.idx, str, strlen(str) + 1);
+}
 
-    // Next look for a matching key
-    // If no entry is found, cfg_entry_idx will stay at the value of cfg->count,
-    // else it will be smaller
-    uint32_t cfg_entry_idx = cfg->count;
-    for(uint32_t i = 0; i < cfg->count; i++) {
-        const char* cfg_key = cfg->entries[i].key;
-        if(strncmp(cfg_key, key_str, sep_idx) == 0) {
-            cfg_entry_idx = i;
+/**
+ * Batch access
+ * ===================================================================
+ */
+
+// Validates the handle of an item against the table and the type of its entry
+static CfgRet_t config_checkBatchItem(const ConfigTable_t* cfg, const ConfigBatchItem_t* item) {
+    const CfgRet_t ret = config_checkHandle(cfg, item->handle, item->handle.type);
+    if(CFG_RC_SUCCESS != ret) return ret;
+    if(cfg->entries[item->handle.idx].type != item->handle.type) return config_typeMismatch(cfg);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_getBatch(const ConfigTable_t* cfg, ConfigBatchItem_t* items, uint32_t count) {
+    if(cfg == NULL || items == NULL) return CFG_RC_ERROR_NULLPTR;
+    bool error_occurred = false;
+    for(uint32_t i = 0; i < count; i++) {
+        ConfigBatchItem_t* item = &items[i];
+        CfgRet_t ret = CFG_RC_ERROR_NULLPTR;
+        if(item->value != NULL) ret = config_checkBatchItem(cfg, item);
+        if(ret == CFG_RC_SUCCESS) {
+            const ConfigEntry_t* entry = &(cfg->entries[item->handle.idx]);
+            if(entry->type == CONFIG_STRING) {
+                ret = config_readString(entry, item->value, item->size);
+            } else if(item->size < entry->size) {
+                ret = CFG_RC_ERROR_TOO_LARGE;
+            } else {
+                config_readValue(entry, item->value, entry->size);
+            }
+        }
+        item->result = ret;
+        if(ret != CFG_RC_SUCCESS) error_occurred = true;
+    }
+    if(error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_setBatch(ConfigTable_t* cfg, ConfigBatchItem_t* items, uint32_t count) {
+    if(cfg == NULL || items == NULL) return CFG_RC_ERROR_NULLPTR;
+    bool error_occurred = false;
+    config_notifyBeginBatch(cfg);
+    for(uint32_t i = 0; i < count; i++) {
+        ConfigBatchItem_t* item = &items[i];
+        CfgRet_t ret = CFG_RC_ERROR_NULLPTR;
+        if(item->value != NULL) ret = config_checkBatchItem(cfg, item);
+        if(ret == CFG_RC_SUCCESS) ret = config_writeEntry(cfg, item->handle.idx, item->value, item->size);
+        item->result = ret;
+        if(ret != CFG_RC_SUCCESS) error_occurred = true;
+    }
+    config_notifyEndBatch(cfg);
+    if(error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
+}
+
+/**
+ * Dirty tracking
+ * ===================================================================
+ */
+
+CfgRet_t config_enableDirtyTracking(ConfigTable_t* cfg, uint32_t* bitmap, uint32_t word_count) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(bitmap == NULL) {
+        cfg->dirty = NULL;
+        return CFG_RC_SUCCESS;
+    }
+    if(word_count < CFG_DIRTY_WORD_COUNT(cfg->count)) return CFG_RC_ERROR_TOO_LARGE;
+    memset(bitmap, 0, CFG_DIRTY_WORD_COUNT(cfg->count) * sizeof(uint32_t));
+    cfg->dirty = bitmap;
+    return CFG_RC_SUCCESS;
+}
+
+bool config_isDirty(const ConfigTable_t* cfg, uint32_t idx) {
+    if(cfg == NULL || cfg->dirty == NULL || idx >= cfg->count) return false;
+    return config_getDirtyBit(cfg->dirty, idx);
+}
+
+uint32_t config_getDirtyCount(const ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->dirty == NULL) return 0;
+    uint32_t count = 0;
+    for(uint32_t i = 0; i < CFG_DIRTY_WORD_COUNT(cfg->count); i++) {
+        // Population count, clearing the lowest set bit per iteration
+        for(uint32_t word = cfg->dirty[i]; word != 0; word &= word - 1) count++;
+    }
+    return count;
+}
+
+CfgRet_t config_markDirty(ConfigTable_t* cfg, uint32_t idx) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    if(cfg->dirty == NULL) return CFG_RC_ERROR_INVALID;
+    config_setDirtyBit(cfg->dirty, idx);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_clearDirty(ConfigTable_t* cfg, uint32_t idx) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    if(cfg->dirty == NULL) return CFG_RC_ERROR_INVALID;
+    config_clearDirtyBit(cfg->dirty, idx);
+    return CFG_RC_SUCCESS;
+}
+
+void config_clearAllDirty(ConfigTable_t* cfg) {
+    if(cfg == NULL || cfg->dirty == NULL) return;
+    memset(cfg->dirty, 0, CFG_DIRTY_WORD_COUNT(cfg->count) * sizeof(uint32_t));
+}
+
+/**
+ * Storage and parsing
+ * ===================================================================
+ */
+
+#ifndef ARRAY_PARSE_STACK_SIZE
+    // Arrays up to this size in bytes are parsed on the stack, larger ones into an allocated buffer
+    #define ARRAY_PARSE_STACK_SIZE (256)
+#endif
+
+// Parses comma separated elements into the array entry with the given index.
+// All elements are parsed into a buffer of the entry size first and written at once
+static CfgRet_t config_parseArray(ConfigTable_t* cfg, uint32_t idx, const char* value, uint32_t value_len) {
+    const ConfigEntry_t* entry = &(cfg->entries[idx]);
+    const ConfigType_t element_type = config_arrayElementType(entry->type);
+    const uint32_t element_size = config_numberSize(element_type);
+    const uint32_t capacity = config_arrayLength(entry);
+    uint64_t stack_buf[ARRAY_PARSE_STACK_SIZE / sizeof(uint64_t)];
+    uint8_t* buf = (uint8_t*)stack_buf;
+    if(entry->size > sizeof(stack_buf)) {
+        buf = malloc(entry->size);
+        if(buf == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    }
+    CfgRet_t ret = CFG_RC_SUCCESS;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    while(i < value_len && isspace((unsigned char)value[i])) i++;
+    // An empty value sets all elements to 0
+    while(i < value_len) {
+        if(count >= capacity) {
+            ret = CFG_RC_ERROR_TOO_LARGE;
             break;
         }
+        uint32_t consumed = 0;
+        ret = config_parseNumber(element_type, value + i, value_len - i, buf + count * element_size, &consumed);
+        if(ret != CFG_RC_SUCCESS) break;
+        count++;
+        i += consumed;
+        while(i < value_len && isspace((unsigned char)value[i])) i++;
+        if(i == value_len) break;
+        if(value[i] != ',') {
+            ret = CFG_RC_ERROR_FORMAT;
+            break;
+        }
+        i++;
+        while(i < value_len && isspace((unsigned char)value[i])) i++;
+        // A trailing comma is missing its element
+        if(i == value_len) ret = CFG_RC_ERROR_FORMAT;
     }
-    if(cfg_entry_idx == cfg->count){
+    if(ret == CFG_RC_SUCCESS) ret = config_setByIdx(cfg, idx, buf, count * element_size);
+    if(buf != (uint8_t*)stack_buf) free(buf);
+    return ret;
+}
+
+// Parses the value into the entry with the given key, see config_parseKV
+static CfgRet_t config_parseEntry(ConfigTable_t* cfg, const char* key, uint32_t key_len, char* value, uint32_t value_len) {
+    // Look for a matching key
+    const int32_t found_idx = config_findKey(cfg, key, key_len);
+    if(found_idx < 0) {
         // Key does not exist in config
         return CFG_RC_ERROR_UNKNOWN_KEY;
     }
-    ConfigEntry_t* entry = &(cfg->entries[cfg_entry_idx]);
+    const uint32_t cfg_entry_idx = (uint32_t)found_idx;
+    const ConfigEntry_t* entry = &(cfg->entries[cfg_entry_idx]);
+    // Terminate the value, an empty boolean value must not read the character behind it
+    value[value_len] = '\0';
     // Parse variable to correct type
-    // 8 byte should be enough for any non-string type commonly used.
-    // Strings do not need to be stored here
-    uint32_t value_str_size = len - sep_idx - 1;
-    // Advance value string to get rid of possible whitespace
-    while(isspace(value_str[0])) {
-        value_str++;
-        value_str_size--;
-    }
-    // trim trailing whitespace of value string
-    if(value_str_size >= 2) {
-        while(isspace(value_str[value_str_size-2])) {
-            value_str[value_str_size-2] = '\0';
-            value_str_size--;
-        }
-    }
     switch(entry->type) {
         default:
         case CONFIG_NONE:
             return CFG_RC_ERROR_INVALID;
-        case CONFIG_UINT32: {
-                if(value_str[0] == '-') return CFG_RC_ERROR;
-                const uint32_t tmp = strtoull(value_str, NULL, 10);
-                if(errno == ERANGE) {
-                    errno = 0;
-                    return CFG_RC_ERROR;
-                }
-                return config_setByIdx(cfg, cfg_entry_idx, &tmp, sizeof(tmp));
-            }
-        case CONFIG_INT32: {
-                const int32_t tmp = strtol(value_str, NULL, 10);
-                if(errno == ERANGE) {
-                    errno = 0;
-                    return CFG_RC_ERROR;
-                }
-                return config_setByIdx(cfg, cfg_entry_idx, &tmp, sizeof(tmp));
-            }
-        case CONFIG_FLOAT: {
-                const float tmp = strtof(value_str, NULL);
-                if(errno == ERANGE) {
-                    errno = 0;
-                    return CFG_RC_ERROR;
-                }
-                return config_setByIdx(cfg, cfg_entry_idx, &tmp, sizeof(tmp));
+        case CONFIG_UINT32:
+        case CONFIG_INT32:
+        case CONFIG_FLOAT:
+        case CONFIG_UINT64:
+        case CONFIG_INT64:
+        case CONFIG_DOUBLE: {
+                uint64_t tmp;
+                const CfgRet_t ret = config_parseNumber(entry->type, value, value_len, &tmp, NULL);
+                if(ret != CFG_RC_SUCCESS) return ret;
+                return config_setByIdx(cfg, cfg_entry_idx, &tmp, config_numberSize(entry->type));
             }
+        case CONFIG_UINT32_ARRAY:
+        case CONFIG_INT32_ARRAY:
+        case CONFIG_FLOAT_ARRAY:
+        case CONFIG_UINT64_ARRAY:
+        case CONFIG_INT64_ARRAY:
+        case CONFIG_DOUBLE_ARRAY:
+            return config_parseArray(cfg, cfg_entry_idx, value, value_len);
         case CONFIG_STRING:
-            if(value_str[0] == '"' && REMOVE_STRING_DELIMITERS) {
-                value_str[value_str_size-2] = '\0';
-                value_str++;
-                value_str_size -= 2;
+            if(REMOVE_STRING_DELIMITERS && value_len >= 2 && value[0] == '"' && value[value_len - 1] == '"') {
+                value++;
+                value_len -= 2;
             }
-            return config_setByIdx(cfg, cfg_entry_idx, value_str, value_str_size);
+            // The remaining memory is zero filled, but at least one byte is needed for the null-terminator
+            if(value_len >= entry->size) return CFG_RC_ERROR_TOO_LARGE;
+            return config_setByIdx(cfg, cfg_entry_idx, value, value_len);
         case CONFIG_BOOL: {
-                char bool_char = value_str[0];
-                if(bool_char == 'T' || bool_char == 't' || bool_char == '1') {
-                    uint8_t tmp = 1;
-                    config_setByIdx(cfg, cfg_entry_idx, &tmp, sizeof(tmp));
-                }
-                else if(bool_char == 'F' || bool_char == 'f' || bool_char == '0') {
-                    uint8_t tmp = 0;
-                    config_setByIdx(cfg, cfg_entry_idx, &tmp, sizeof(tmp));
-                }
+                const char bool_char = value[0];
+                bool tmp;
+                if(bool_char == 'T' || bool_char == 't' || bool_char == '1') tmp = true;
+                else if(bool_char == 'F' || bool_char == 'f' || bool_char == '0') tmp = false;
                 else return CFG_RC_ERROR;
+                return config_setByIdx(cfg, cfg_entry_idx, &tmp, sizeof(tmp));
             }
-            break;
     }
-    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_parseKV(ConfigTable_t* cfg, const char* key, uint32_t key_len, char* value, uint32_t value_len) {
+    if(cfg == NULL || key == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const CfgRet_t ret = config_parseEntry(cfg, key, key_len, value, value_len);
+    if(ret != CFG_RC_SUCCESS) CFG_STATS_ADD(cfg, CFG_STAT_PARSE_ERRORS, 1);
+    return ret;
+}
+
+CfgRet_t config_parseKVStr(ConfigTable_t* cfg, char* str, uint32_t len) {
+    if(cfg == NULL || str == NULL) return CFG_RC_ERROR_NULLPTR;
+    // First step, try to parse a key.
+    // Find the index of the key-value separator
+    char* value_str = strchr(str, KV_SEP_CHAR);
+    if(value_str == NULL) {
+        // separator char not found
+        CFG_STATS_ADD(cfg, CFG_STAT_PARSE_ERRORS, 1);
+        return CFG_RC_ERROR_FORMAT;
+    }
+    uint32_t sep_idx = (uint32_t)(value_str-str);
+    // advance by one to omit the separator char from value string
+    value_str++;
+
+    // trim leading and trailing whitespace of the key
+    char* key_str = str;
+    while(isspace(key_str[0])) key_str++;
+    uint32_t key_len = (uint32_t)(str + sep_idx - key_str);
+    while(key_len > 0 && isspace(key_str[key_len - 1])) key_len--;
+
+    // len includes the null-terminator
+    if(len < sep_idx + 2) {
+        CFG_STATS_ADD(cfg, CFG_STAT_PARSE_ERRORS, 1);
+        return CFG_RC_ERROR_FORMAT;
+    }
+    uint32_t value_len = len - sep_idx - 2;
+    // Advance value string to get rid of possible whitespace
+    while(value_len > 0 && isspace(value_str[0])) {
+        value_str++;
+        value_len--;
+    }
+    // trim trailing whitespace of value string
+    while(value_len > 0 && isspace(value_str[value_len - 1])) value_len--;
+    return config_parseKV(cfg, key_str, key_len, value_str, value_len);
 }
 
 CfgRet_t config_defaultLoadFunc(ConfigTable_t* cfg, const char* filename){
@@ -293,6 +935,21 @@ CfgRet_t config_defaultLoadFunc(ConfigTable_t* cfg, const char* filename){
     // Read each line
     while(NULL != fgets(line, sizeof(line), file_ptr)) {
         uint32_t line_len = strlen(line);
+        CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, line_len);
+        // A line starting with a NUL character has length 0
+        if(line_len > 0 && line[line_len - 1] != '\n' && !feof(file_ptr)) {
+            // Line does not fit into the buffer. Skip the rest of it instead of parsing it as a new line
+            uint32_t skipped = 0;
+            int c;
+            while((c = fgetc(file_ptr)) != EOF) {
+                skipped++;
+                if(c == '\n') break;
+            }
+            CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, skipped);
+            CFG_STATS_ADD(cfg, CFG_STAT_PARSE_ERRORS, 1);
+            parsing_error_occurred = true;
+            continue;
+        }
         if(CFG_RC_SUCCESS != config_parseKVStr(cfg, line, line_len + 1)) {
             // If any line could not be matched to a valid entry, set a flag
             parsing_error_occurred = true;
@@ -306,63 +963,488 @@ CfgRet_t config_defaultLoadFunc(ConfigTable_t* cfg, const char* filename){
     return CFG_RC_SUCCESS;
 }
 
-CfgRet_t config_loadFromFile(ConfigTable_t* cfg, const char* filename) {
-    if(loadFromFileFunction != NULL) return loadFromFileFunction(cfg, filename);
-    else return CFG_RC_ERROR_INVALID;
+#ifndef PARSE_BUFFER_SPAN_COUNT
+    // Number of key-value spans tokenized at once by config_parseBuffer
+    #define PARSE_BUFFER_SPAN_COUNT (64)
+#endif
+
+CfgRet_t config_parseBuffer(ConfigTable_t* cfg, char* buf, uint32_t len, parseErrorFunc on_error, void* ctx) {
+    if(cfg == NULL || buf == NULL) return CFG_RC_ERROR_NULLPTR;
+    const uint64_t start = CFG_STATS_START(cfg);
+    bool parsing_error_occurred = false;
+    // All changed entries are notified together once the buffer has been parsed
+    config_notifyBeginBatch(cfg);
+    ConfigTokenizer_t tokenizer;
+    config_tokenizerInit(&tokenizer, buf, len);
+    ConfigKVSpan_t spans[PARSE_BUFFER_SPAN_COUNT];
+    uint32_t span_count = 0;
+    CfgRet_t tokenizer_ret;
+    do {
+        tokenizer_ret = config_tokenizerNext(&tokenizer, spans, PARSE_BUFFER_SPAN_COUNT, &span_count);
+        for(uint32_t i = 0; i < span_count; i++) {
+            const ConfigKVSpan_t* span = &spans[i];
+            // Values are terminated in place. The character after a value span is either
+            // whitespace, the line ending or buf[len], so no other span is affected
+            const CfgRet_t ret = span->has_separator ? config_parseKV(cfg, buf + span->key_offset, span->key_len,
+                                                                      buf + span->value_offset, span->value_len)
+                                                     : CFG_RC_ERROR_FORMAT;
+            if(CFG_RC_SUCCESS != ret) {
+                // Errors of config_parseKV are counted by it
+                if(!span->has_separator) CFG_STATS_ADD(cfg, CFG_STAT_PARSE_ERRORS, 1);
+                parsing_error_occurred = true;
+                if(on_error != NULL) on_error(ctx, span->line, ret);
+            }
+        }
+    } while(tokenizer_ret == CFG_RC_ERROR_INCOMPLETE);
+    config_notifyEndBatch(cfg);
+    CFG_STATS_RECORD(cfg, CFG_STAT_PARSE, start);
+    if(parsing_error_occurred) return CFG_RC_ERROR_INCOMPLETE;
+    return CFG_RC_SUCCESS;
 }
 
-CfgRet_t config_defaultSaveFunc(const ConfigTable_t* cfg, const char* filename){
+CfgRet_t config_readFileContents(FILE* file_ptr, char** buf, uint32_t* len) {
+    if(fseek(file_ptr, 0, SEEK_END) != 0) return CFG_RC_ERROR;
+    const long file_size = ftell(file_ptr);
+    if(file_size < 0 || (unsigned long)file_size >= UINT32_MAX || fseek(file_ptr, 0, SEEK_SET) != 0) {
+        return CFG_RC_ERROR;
+    }
+    *buf = malloc((size_t)file_size + 1);
+    if(*buf == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    if(fread(*buf, 1, (size_t)file_size, file_ptr) != (size_t)file_size) {
+        free(*buf);
+        return CFG_RC_ERROR;
+    }
+    *len = (uint32_t)file_size;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_loadFromFileBuffered(ConfigTable_t* cfg, const char* filename, parseErrorFunc on_error, void* ctx) {
     if(cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
     FILE* file_ptr = NULL;
-    file_ptr = fopen(filename, "w+");
+    file_ptr = fopen(filename, "rb");
     if(file_ptr == NULL) return CFG_RC_ERROR;
+    char* buf = NULL;
+    uint32_t len = 0;
+    CfgRet_t ret = config_readFileContents(file_ptr, &buf, &len);
+    fclose(file_ptr);
+    if(ret != CFG_RC_SUCCESS) return ret;
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, len);
+    ret = config_parseBuffer(cfg, buf, len, on_error, ctx);
+    free(buf);
+    return ret;
+}
 
-    char line[FILE_MAX_LINE_LEN] = "";
-    // iterate over all config entries
+CfgRet_t config_bufferedLoadFunc(ConfigTable_t* cfg, const char* filename) {
+    return config_loadFromFileBuffered(cfg, filename, NULL, NULL);
+}
+
+CfgRet_t config_loadFromFile(ConfigTable_t* cfg, const char* filename) {
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const loadFromFileFunc load = config_getLoadFunction(cfg);
+    if(load == NULL) return CFG_RC_ERROR_INVALID;
+    const uint64_t start = CFG_STATS_START(cfg);
+    // All changed entries are notified together once the file has been loaded
+    config_notifyBeginBatch(cfg);
+    const CfgRet_t ret = load(cfg, filename);
+    config_notifyEndBatch(cfg);
+    CFG_STATS_RECORD(cfg, CFG_STAT_LOAD, start);
+    return ret;
+}
+
+// Entries with other types are skipped while saving
+static bool config_isSavedType(ConfigType_t type) {
+    return type > CONFIG_NONE && type <= CONFIG_DOUBLE_ARRAY;
+}
+
+// Upper bound for the number of characters written by config_formatNumber
+static uint32_t config_maxNumberLen(ConfigType_t type) {
+    switch(type) {
+        default:
+            return 0;
+        case CONFIG_UINT32:
+            return CFG_UINT32_MAX_LEN;
+        case CONFIG_INT32:
+            return CFG_INT32_MAX_LEN;
+        case CONFIG_FLOAT:
+            return CFG_FLOAT_MAX_LEN;
+        case CONFIG_UINT64:
+            return CFG_UINT64_MAX_LEN;
+        case CONFIG_INT64:
+            return CFG_INT64_MAX_LEN;
+        case CONFIG_DOUBLE:
+            return CFG_DOUBLE_MAX_LEN;
+    }
+}
+
+// Writes the text representation of a number of the given numeric type
+static uint32_t config_formatNumber(ConfigType_t type, const void* value, char* buf) {
+    switch(type) {
+        default:
+            return 0;
+        case CONFIG_UINT32:
+            return config_formatUint32(buf, *(const uint32_t*)value);
+        case CONFIG_INT32:
+            return config_formatInt32(buf, *(const int32_t*)value);
+        case CONFIG_FLOAT:
+            return config_formatFloat(buf, *(const float*)value);
+        case CONFIG_UINT64:
+            return config_formatUint64(buf, *(const uint64_t*)value);
+        case CONFIG_INT64:
+            return config_formatInt64(buf, *(const int64_t*)value);
+        case CONFIG_DOUBLE:
+            return config_formatDouble(buf, *(const double*)value);
+    }
+}
+
+// Upper bound for the number of characters written by config_formatValue, 0 for entries which are not saved
+static uint32_t config_maxValueLen(const ConfigEntry_t* e) {
+    switch(e->type) {
+        default:
+        case CONFIG_NONE:
+            return 0;
+        case CONFIG_BOOL:
+            return 1;
+        case CONFIG_UINT32:
+        case CONFIG_INT32:
+        case CONFIG_FLOAT:
+        case CONFIG_UINT64:
+        case CONFIG_INT64:
+        case CONFIG_DOUBLE:
+            return config_maxNumberLen(e->type);
+        case CONFIG_STRING:
+            return config_storedStringLen(e);
+        case CONFIG_UINT32_ARRAY:
+        case CONFIG_INT32_ARRAY:
+        case CONFIG_FLOAT_ARRAY:
+        case CONFIG_UINT64_ARRAY:
+        case CONFIG_INT64_ARRAY:
+        case CONFIG_DOUBLE_ARRAY: {
+                const uint32_t count = config_arrayLength(e);
+                if(count == 0) return 0;
+                // Elements are separated by ", "
+                return count * config_maxNumberLen(config_arrayElementType(e->type)) + (count - 1) * 2;
+            }
+    }
+}
+
+// Writes the text representation of the entry value and returns the number of characters written
+static uint32_t config_formatValue(const ConfigEntry_t* e, char* buf) {
+    switch(e->type) {
+        default:
+        case CONFIG_NONE:
+            return 0;
+        case CONFIG_BOOL:
+            buf[0] = *(bool*)e->value ? '1' : '0';
+            return 1;
+        case CONFIG_UINT32:
+        case CONFIG_INT32:
+        case CONFIG_FLOAT:
+        case CONFIG_UINT64:
+        case CONFIG_INT64:
+        case CONFIG_DOUBLE:
+            return config_formatNumber(e->type, e->value, buf);
+        case CONFIG_STRING: {
+                const uint32_t len = config_storedStringLen(e);
+                memcpy(buf, e->value, len);
+                return len;
+            }
+        case CONFIG_UINT32_ARRAY:
+        case CONFIG_INT32_ARRAY:
+        case CONFIG_FLOAT_ARRAY:
+        case CONFIG_UINT64_ARRAY:
+        case CONFIG_INT64_ARRAY:
+        case CONFIG_DOUBLE_ARRAY: {
+                const ConfigType_t element_type = config_arrayElementType(e->type);
+                const uint32_t element_size = config_numberSize(element_type);
+                const uint32_t count = config_arrayLength(e);
+                char* p = buf;
+                for(uint32_t i = 0; i < count; i++) {
+                    if(i > 0) {
+                        *p++ = ',';
+                        *p++ = ' ';
+                    }
+                    p += config_formatNumber(element_type, (const uint8_t*)e->value + i * element_size, p);
+                }
+                return (uint32_t)(p - buf);
+            }
+    }
+}
+
+// Number of characters of the "key: value\n" line of an entry in the worst case
+static uint32_t config_maxLineLen(const ConfigEntry_t* e, uint32_t key_len) {
+    return key_len + 2 + config_maxValueLen(e) + 1;
+}
+
+// Writes the "key: value\n" line of an entry and returns the number of characters written.
+// buf has to provide config_maxLineLen characters
+static uint32_t config_formatLine(const ConfigEntry_t* e, uint32_t key_len, char* buf) {
+    char* p = buf;
+    memcpy(p, e->key, key_len);
+    p += key_len;
+    *p++ = KV_SEP_CHAR;
+    *p++ = ' ';
+    uint32_t value_len;
+    uint32_t seq;
+    do {
+        seq = config_seqReadBegin(e);
+        value_len = config_formatValue(e, p);
+    } while(config_seqReadRetry(e, seq));
+    p += value_len;
+    *p++ = '\n';
+    return (uint32_t)(p - buf);
+}
+
+uint32_t config_getFormattedSize(const ConfigTable_t* cfg) {
+    if(cfg == NULL) return 0;
+    uint32_t size = 0;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isSavedType(e->type)) continue;
+        size += config_maxLineLen(e, strlen(e->key));
+    }
+    return size;
+}
+
+uint32_t config_getFormattedEntrySize(const ConfigTable_t* cfg, uint32_t idx) {
+    if(cfg == NULL || idx >= cfg->count) return 0;
+    const ConfigEntry_t* e = &(cfg->entries[idx]);
+    if(!config_isSavedType(e->type)) return 0;
+    return config_maxLineLen(e, strlen(e->key));
+}
+
+CfgRet_t config_formatEntry(const ConfigTable_t* cfg, uint32_t idx, char* buf, uint32_t buf_size, uint32_t* len) {
+    if(cfg == NULL || buf == NULL || len == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(idx >= cfg->count) return CFG_RC_ERROR_RANGE;
+    *len = 0;
+    const ConfigEntry_t* e = &(cfg->entries[idx]);
+    if(!config_isSavedType(e->type)) return CFG_RC_ERROR_INVALID;
+    const uint32_t key_len = strlen(e->key);
+    if(buf_size < config_maxLineLen(e, key_len)) return CFG_RC_ERROR_TOO_LARGE;
+    *len = config_formatLine(e, key_len, buf);
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_formatTable(const ConfigTable_t* cfg, char* buf, uint32_t buf_size, uint32_t* len) {
+    if(cfg == NULL || buf == NULL || len == NULL) return CFG_RC_ERROR_NULLPTR;
+    char* p = buf;
+    char* const end = buf + buf_size;
     bool line_length_error = false;
-    bool encoding_error = false;
     for(uint32_t i = 0; i < cfg->count; i++) {
-        const ConfigEntry_t e = cfg->entries[i];
-        int32_t ret;
-        switch(e.type) {
-            default:
-            case CONFIG_NONE:
-                    continue;
-            case CONFIG_BOOL:
-                ret = snprintf(line, sizeof(line), "%s: %u\n", e.key, *(bool*)e.value);
-                break;
-            case CONFIG_UINT32:
-                ret = snprintf(line, sizeof(line), "%s: %lu\n", e.key, *(uint32_t*)e.value);
-                break;
-            case CONFIG_INT32:
-                ret = snprintf(line, sizeof(line), "%s: %i\n", e.key, *(int32_t*)e.value);
-                break;
-            case CONFIG_FLOAT:
-                ret = snprintf(line, sizeof(line), "%s: %f\n", e.key, *(float*)e.value);
-                break;
-            case CONFIG_STRING:
-                ret = snprintf(line, sizeof(line), "%s: %s\n", e.key, e.value);
-                break;
-        }
-        // Check if snprintf was successful
-        if(ret > sizeof(line)) line_length_error = true;
-        else if(ret < 0) encoding_error = true;
-        else {
-            // write to file
-            fprintf(file_ptr, line);
+        const ConfigEntry_t* e = &(cfg->entries[i]);
+        if(!config_isSavedType(e->type)) continue;
+        const uint32_t key_len = strlen(e->key);
+        if((uint32_t)(end - p) < config_maxLineLen(e, key_len)) {
+            *len = (uint32_t)(p - buf);
+            return CFG_RC_ERROR_TOO_LARGE;
         }
+        const uint32_t line_len = config_formatLine(e, key_len, p);
+        // Lines have to fit into the line buffer of the default load function
+        if(line_len > FILE_MAX_LINE_LEN - 1) line_length_error = true;
+        else p += line_len;
     }
-    // close file
-    fclose(file_ptr);
-
-    if(encoding_error) return CFG_RC_ERROR_INVALID;
+    *len = (uint32_t)(p - buf);
     if(line_length_error) return CFG_RC_ERROR_INCOMPLETE;
     return CFG_RC_SUCCESS;
 }
 
+CfgRet_t config_defaultSaveFunc(const ConfigTable_t* cfg, const char* filename){
+    if(cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    // Format everything into one buffer first so the file is written with a single call
+    const uint32_t buf_size = config_getFormattedSize(cfg);
+    char* buf = malloc(buf_size > 0 ? buf_size : 1);
+    if(buf == NULL) return CFG_RC_ERROR_TOO_LARGE;
+    uint32_t len = 0;
+    const CfgRet_t format_ret = config_formatTable(cfg, buf, buf_size, &len);
+    if(format_ret != CFG_RC_SUCCESS && format_ret != CFG_RC_ERROR_INCOMPLETE) {
+        free(buf);
+        return format_ret;
+    }
+
+    FILE* file_ptr = NULL;
+    file_ptr = fopen(filename, "wb");
+    if(file_ptr == NULL) {
+        free(buf);
+        return CFG_RC_ERROR;
+    }
+    const size_t written = fwrite(buf, 1, len, file_ptr);
+    const int close_ret = fclose(file_ptr);
+    free(buf);
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_WRITTEN, written);
+
+    if(written != len || close_ret != 0) return CFG_RC_ERROR;
+    return format_ret;
+}
+
 CfgRet_t config_saveToFile(const ConfigTable_t* cfg, const char* filename) {
-    if(saveToFileFunction != NULL) return saveToFileFunction(cfg, filename);
-    else return CFG_RC_ERROR_INVALID;
+    if(cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    const saveToFileFunc save = config_getSaveFunction(cfg);
+    if(save == NULL) return CFG_RC_ERROR_INVALID;
+    const uint64_t start = CFG_STATS_START(cfg);
+    const CfgRet_t ret = save(cfg, filename);
+    CFG_STATS_RECORD(cfg, CFG_STAT_SAVE, start);
+    return ret;
+}
+
+// Overwrites the values of dirty entries in buf. Marks each patched entry in found.
+// Sets rewrite if a value does not fit into its line. first and last span the modified bytes
+static void config_patchBuffer(const ConfigTable_t* cfg, char* buf, uint32_t len, uint32_t* found, bool* rewrite,
+                               uint32_t* first, uint32_t* last) {
+    ConfigTokenizer_t tokenizer;
+    config_tokenizerInit(&tokenizer, buf, len);
+    ConfigKVSpan_t spans[PARSE_BUFFER_SPAN_COUNT];
+    uint32_t span_count = 0;
+    CfgRet_t tokenizer_ret;
+    do {
+        tokenizer_ret = config_tokenizerNext(&tokenizer, spans, PARSE_BUFFER_SPAN_COUNT, &span_count);
+        for(uint32_t i = 0; i < span_count; i++) {
+            const ConfigKVSpan_t* span = &spans[i];
+            if(!span->has_separator) continue;
+            const int32_t idx = config_findKey(cfg, buf + span->key_offset, span->key_len);
+            if(idx < 0 || !config_getDirtyBit(cfg->dirty, idx)) continue;
+            const ConfigEntry_t* e = &(cfg->entries[idx]);
+            if(!config_isSavedType(e->type)) continue;
+            // The value may take up all space up to the line ending
+            uint32_t end = span->value_offset + span->value_len;
+            while(end < len && buf[end] != '\n' && buf[end] != '\r') end++;
+            const uint32_t space = end - span->value_offset;
+            // Numbers fit into a small buffer, strings are copied directly into the line if they fit.
+            // Arrays are formatted directly into the line, so they have to fit in the worst case
+            char number[32];
+            const bool is_array = config_arrayElementType(e->type) != CONFIG_NONE;
+            if(is_array && config_maxValueLen(e) > space) {
+                *rewrite = true;
+                return;
+            }
+            uint32_t value_len;
+            uint32_t seq;
+            do {
+                seq = config_seqReadBegin(e);
+                const char* value = number;
+                if(is_array) {
+                    value_len = config_formatValue(e, buf + span->value_offset);
+                    value = NULL;
+                } else if(e->type == CONFIG_STRING) {
+                    value = e->value;
+                    value_len = config_storedStringLen(e);
+                } else {
+                    value_len = config_formatValue(e, number);
+                }
+                if(value != NULL && value_len <= space) memcpy(buf + span->value_offset, value, value_len);
+            } while(config_seqReadRetry(e, seq));
+            if(value_len > space) {
+                *rewrite = true;
+                return;
+            }
+            memset(buf + span->value_offset + value_len, ' ', space - value_len);
+            if(span->value_offset < *first) *first = span->value_offset;
+            if(end > *last) *last = end;
+            config_setDirtyBit(found, idx);
+        }
+    } while(tokenizer_ret == CFG_RC_ERROR_INCOMPLETE);
+}
+
+// Updates the dirty entries in an existing file. Sets rewrite if the file has to be saved completely
+static CfgRet_t config_updateFile(ConfigTable_t* cfg, const char* filename, bool* rewrite) {
+    *rewrite = false;
+    FILE* file_ptr = fopen(filename, "r+b");
+    if(file_ptr == NULL) {
+        *rewrite = true;
+        return CFG_RC_SUCCESS;
+    }
+    char* buf = NULL;
+    uint32_t len = 0;
+    CfgRet_t ret = config_readFileContents(file_ptr, &buf, &len);
+    if(ret != CFG_RC_SUCCESS) {
+        fclose(file_ptr);
+        return ret;
+    }
+    CFG_STATS_ADD(cfg, CFG_STAT_BYTES_READ, len);
+    const uint32_t word_count = CFG_DIRTY_WORD_COUNT(cfg->count);
+    uint32_t* found = calloc(word_count > 0 ? word_count : 1, sizeof(uint32_t));
+    if(found == NULL) {
+        free(buf);
+        fclose(file_ptr);
+        return CFG_RC_ERROR_TOO_LARGE;
+    }
+    uint32_t first = UINT32_MAX;
+    uint32_t last = 0;
+    config_patchBuffer(cfg, buf, len, found, rewrite, &first, &last);
+
+    // Dirty entries without a line in the file are appended
+    uint32_t append_size = 1;
+    for(uint32_t i = 0; i < cfg->count && !*rewrite; i++) {
+        if(config_getDirtyBit(cfg->dirty, i) && !config_getDirtyBit(found, i)) {
+            append_size += config_getFormattedEntrySize(cfg, i);
+        }
+    }
+    char* append_buf = *rewrite ? NULL : malloc(append_size);
+    if(!*rewrite && append_buf == NULL) ret = CFG_RC_ERROR_TOO_LARGE;
+    uint32_t append_len = 0;
+    bool line_length_error = false;
+    if(append_buf != NULL) {
+        // Start a new line if the last line of the file has no line ending
+        if(len > 0 && buf[len - 1] != '\n') append_buf[append_len++] = '\n';
+        const uint32_t separator_len = append_len;
+        for(uint32_t i = 0; i < cfg->count; i++) {
+            if(!config_getDirtyBit(cfg->dirty, i) || config_getDirtyBit(found, i)) continue;
+            const ConfigEntry_t* e = &(cfg->entries[i]);
+            if(!config_isSavedType(e->type)) {
+                config_setDirtyBit(found, i);
+                continue;
+            }
+            const uint32_t line_len = config_formatLine(e, strlen(e->key), append_buf + append_len);
+            // Lines have to fit into the line buffer of the default load function
+            if(line_len > FILE_MAX_LINE_LEN - 1) {
+                line_length_error = true;
+                continue;
+            }
+            append_len += line_len;
+            config_setDirtyBit(found, i);
+        }
+        if(append_len == separator_len) append_len = 0;
+
+        // Write the modified range and the appended lines
+        if(first < last && (fseek(file_ptr, first, SEEK_SET) != 0 ||
+                            fwrite(buf + first, 1, last - first, file_ptr) != last - first)) {
+            ret = CFG_RC_ERROR;
+        }
+        if(ret == CFG_RC_SUCCESS && append_len > 0 &&
+           (fseek(file_ptr, 0, SEEK_END) != 0 || fwrite(append_buf, 1, append_len, file_ptr) != append_len)) {
+            ret = CFG_RC_ERROR;
+        }
+        if(ret == CFG_RC_SUCCESS) {
+            CFG_STATS_ADD(cfg, CFG_STAT_BYTES_WRITTEN, (first < last ? last - first : 0) + append_len);
+        }
+    }
+    if(fclose(file_ptr) != 0 && ret == CFG_RC_SUCCESS) ret = CFG_RC_ERROR;
+    free(append_buf);
+    free(buf);
+    if(ret == CFG_RC_SUCCESS && !*rewrite) {
+        // Entries which have been written are clean now
+        for(uint32_t i = 0; i < word_count; i++) cfg->dirty[i] &= ~found[i];
+        if(line_length_error) ret = CFG_RC_ERROR_INCOMPLETE;
+    }
+    free(found);
+    return ret;
+}
+
+CfgRet_t config_saveDirty(ConfigTable_t* cfg, const char* filename) {
+    if(cfg == NULL || filename == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(cfg->dirty == NULL) return config_saveToFile(cfg, filename);
+    if(config_getDirtyCount(cfg) == 0) return CFG_RC_SUCCESS;
+    // Only files written by the default save function can be patched in place
+    if(config_getSaveFunction(cfg) == config_defaultSaveFunc) {
+        bool rewrite = false;
+        const uint64_t start = CFG_STATS_START(cfg);
+        const CfgRet_t ret = config_updateFile(cfg, filename, &rewrite);
+        if(!rewrite) {
+            CFG_STATS_RECORD(cfg, CFG_STAT_SAVE, start);
+            return ret;
+        }
+    }
+    const CfgRet_t save_ret = config_saveToFile(cfg, filename);
+    if(save_ret == CFG_RC_SUCCESS) config_clearAllDirty(cfg);
+    return save_ret;
 }
 
 void config_setSaveLoadFunctions(saveToFileFunc saveFunc, loadFromFileFunc loadFunc){
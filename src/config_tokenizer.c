@@ -0,0 +1,150 @@
+#include "config_tokenizer.h"
+
+#include <ctype.h>
+#include <stddef.h>
+
+#if CFG_TOKENIZER_SIMD && defined(__AVX2__)
+    #include <immintrin.h>
+    #define TOKENIZER_BLOCK_SIZE (32)
+#elif CFG_TOKENIZER_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define TOKENIZER_BLOCK_SIZE (16)
+#else
+    #define TOKENIZER_BLOCK_SIZE (8)
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+static uint32_t countTrailingZeros(uint32_t mask) {
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+}
+#else
+    #define countTrailingZeros(mask) ((uint32_t)__builtin_ctz(mask))
+#endif
+
+/**
+ * Returns a bitmask of all line endings and key-value separators in the block
+ * starting at buf. Bit n is set if buf[n] is one of these characters.
+ */
+static uint32_t config_classifyBlock(const char* buf) {
+#if TOKENIZER_BLOCK_SIZE == 32
+    const __m256i block = _mm256_loadu_si256((const __m256i*)buf);
+    const __m256i newlines = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\n'));
+    const __m256i separators = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(KV_SEP_CHAR));
+    return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(newlines, separators));
+#elif TOKENIZER_BLOCK_SIZE == 16
+    const __m128i block = _mm_loadu_si128((const __m128i*)buf);
+    const __m128i newlines = _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'));
+    const __m128i separators = _mm_cmpeq_epi8(block, _mm_set1_epi8(KV_SEP_CHAR));
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(newlines, separators));
+#else
+    uint32_t mask = 0;
+    for(uint32_t i = 0; i < TOKENIZER_BLOCK_SIZE; i++) {
+        if(buf[i] == '\n' || buf[i] == KV_SEP_CHAR) mask |= (1u << i);
+    }
+    return mask;
+#endif
+}
+
+// Same as config_classifyBlock for blocks shorter than TOKENIZER_BLOCK_SIZE at the end of the buffer
+static uint32_t config_classifyTail(const char* buf, uint32_t len) {
+    uint32_t mask = 0;
+    for(uint32_t i = 0; i < len; i++) {
+        if(buf[i] == '\n' || buf[i] == KV_SEP_CHAR) mask |= (1u << i);
+    }
+    return mask;
+}
+
+// Narrows [*start, *end) to exclude leading and trailing whitespace
+static void config_trimSpan(const char* buf, uint32_t* start, uint32_t* end) {
+    while(*start < *end && isspace((unsigned char)buf[*start])) (*start)++;
+    while(*end > *start && isspace((unsigned char)buf[*end - 1])) (*end)--;
+}
+
+void config_tokenizerInit(ConfigTokenizer_t* tokenizer, const char* buf, uint32_t len) {
+    if(tokenizer == NULL) return;
+    tokenizer->buf = buf;
+    tokenizer->len = buf == NULL ? 0 : len;
+    tokenizer->pos = 0;
+    tokenizer->line = 0;
+}
+
+// Writes the span for the line [line_start, line_end) with the separator at sep or none if sep is UINT32_MAX.
+// Returns false for empty lines
+static bool config_makeSpan(const char* buf, uint32_t line_start, uint32_t line_end, uint32_t sep, uint32_t line,
+                            ConfigKVSpan_t* span) {
+    uint32_t key_start = line_start;
+    uint32_t key_end = sep == UINT32_MAX ? line_end : sep;
+    config_trimSpan(buf, &key_start, &key_end);
+    span->key_offset = key_start;
+    span->key_len = key_end - key_start;
+    span->line = line;
+    if(sep == UINT32_MAX) {
+        if(span->key_len == 0) return false;
+        span->value_offset = key_end;
+        span->value_len = 0;
+        span->has_separator = false;
+        return true;
+    }
+    uint32_t value_start = sep + 1;
+    uint32_t value_end = line_end;
+    config_trimSpan(buf, &value_start, &value_end);
+    span->value_offset = value_start;
+    span->value_len = value_end - value_start;
+    span->has_separator = true;
+    return true;
+}
+
+CfgRet_t config_tokenizerNext(ConfigTokenizer_t* tokenizer, ConfigKVSpan_t* spans, uint32_t max_spans,
+                              uint32_t* span_count) {
+    if(tokenizer == NULL || spans == NULL || span_count == NULL) return CFG_RC_ERROR_NULLPTR;
+    *span_count = 0;
+    // Without space for a span the tokenizer could never advance
+    if(max_spans == 0) return CFG_RC_ERROR_RANGE;
+    const char* buf = tokenizer->buf;
+    const uint32_t len = tokenizer->len;
+    uint32_t line_start = tokenizer->pos;
+    uint32_t sep = UINT32_MAX;
+    uint32_t count = 0;
+    uint32_t block_start = line_start;
+    while(block_start < len) {
+        const uint32_t block_len = len - block_start;
+        uint32_t mask = block_len >= TOKENIZER_BLOCK_SIZE ? config_classifyBlock(buf + block_start)
+                                                          : config_classifyTail(buf + block_start, block_len);
+        // Visit line endings and separators in order
+        while(mask != 0) {
+            const uint32_t pos = block_start + countTrailingZeros(mask);
+            mask &= mask - 1;
+            if(buf[pos] != '\n') {
+                // Only the first separator of a line counts, values may contain the separator character
+                if(sep == UINT32_MAX) sep = pos;
+                continue;
+            }
+            if(count == max_spans) {
+                tokenizer->pos = line_start;
+                *span_count = count;
+                return CFG_RC_ERROR_INCOMPLETE;
+            }
+            tokenizer->line++;
+            if(config_makeSpan(buf, line_start, pos, sep, tokenizer->line, &spans[count])) count++;
+            line_start = pos + 1;
+            sep = UINT32_MAX;
+        }
+        block_start += TOKENIZER_BLOCK_SIZE;
+    }
+    // Last line without a line ending
+    if(line_start < len) {
+        if(count == max_spans) {
+            tokenizer->pos = line_start;
+            *span_count = count;
+            return CFG_RC_ERROR_INCOMPLETE;
+        }
+        tokenizer->line++;
+        if(config_makeSpan(buf, line_start, len, sep, tokenizer->line, &spans[count])) count++;
+    }
+    tokenizer->pos = len;
+    *span_count = count;
+    return CFG_RC_SUCCESS;
+}
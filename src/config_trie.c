@@ -0,0 +1,195 @@
+#include "config_trie.h"
+
+#include <string.h>
+
+// Orders key characters so that a segment sorts before all segments it is a prefix of.
+// The end of the key comes first, followed by the segment separator
+static uint32_t config_trieRank(char c) {
+    if(c == '\0') return 0;
+    if(c == '.') return 1;
+    return (uint32_t)(uint8_t)c + 2;
+}
+
+// Compares two keys segment by segment
+static int config_trieCompareKeys(const char* a, const char* b) {
+    for(uint32_t i = 0;; i++) {
+        const uint32_t rank_a = config_trieRank(a[i]);
+        const uint32_t rank_b = config_trieRank(b[i]);
+        if(rank_a != rank_b) return rank_a < rank_b ? -1 : 1;
+        if(a[i] == '\0') return 0;
+    }
+}
+
+// Entries with equal keys are ordered by index, so the first of them is the lowest index
+static bool config_trieLess(const ConfigTable_t* cfg, uint32_t a, uint32_t b) {
+    const int cmp = config_trieCompareKeys(cfg->entries[a].key, cfg->entries[b].key);
+    return cmp < 0 || (cmp == 0 && a < b);
+}
+
+static void config_trieSiftDown(const ConfigTable_t* cfg, uint32_t* order, uint32_t root, uint32_t end) {
+    while(2 * root + 1 < end) {
+        uint32_t child = 2 * root + 1;
+        if(child + 1 < end && config_trieLess(cfg, order[child], order[child + 1])) child++;
+        if(!config_trieLess(cfg, order[root], order[child])) return;
+        const uint32_t tmp = order[root];
+        order[root] = order[child];
+        order[child] = tmp;
+        root = child;
+    }
+}
+
+// Heap sort, qsort cannot pass the table to the comparison
+static void config_trieSort(const ConfigTable_t* cfg, uint32_t* order, uint32_t count) {
+    for(uint32_t i = count / 2; i > 0; i--) config_trieSiftDown(cfg, order, i - 1, count);
+    for(uint32_t end = count; end > 1; end--) {
+        const uint32_t tmp = order[0];
+        order[0] = order[end - 1];
+        order[end - 1] = tmp;
+        config_trieSiftDown(cfg, order, 0, end - 1);
+    }
+}
+
+// Returns true if the key continues with exactly the given segment
+static bool config_trieSegmentEquals(const char* key, const char* segment, uint32_t len) {
+    return strncmp(key, segment, len) == 0 && (key[len] == '.' || key[len] == '\0');
+}
+
+static bool config_trieValid(const ConfigTrie_t* trie) {
+    return trie->cfg != NULL && trie->node_count > 0 && trie->generation == trie->cfg->generation;
+}
+
+// Finds the child of a node with the given segment. Returns its node index or -1
+static int32_t config_trieChild(const ConfigTrie_t* trie, uint32_t node_idx, const char* segment, uint32_t len) {
+    const ConfigTrieNode_t* node = &(trie->nodes[node_idx]);
+    uint32_t low = 0;
+    uint32_t high = node->child_count;
+    while(low < high) {
+        const uint32_t mid = low + (high - low) / 2;
+        const ConfigTrieNode_t* child = &(trie->nodes[node->first_child + mid]);
+        // The segment is stored in every key below the child
+        const char* child_segment =
+            trie->cfg->entries[trie->order[child->first]].key + child->path_len - child->segment_len;
+        const uint32_t common = child->segment_len < len ? child->segment_len : len;
+        int cmp = memcmp(child_segment, segment, common);
+        if(cmp == 0 && child->segment_len != len) cmp = child->segment_len < len ? -1 : 1;
+        if(cmp == 0) return (int32_t)(node->first_child + mid);
+        if(cmp < 0) low = mid + 1;
+        else high = mid;
+    }
+    return -1;
+}
+
+// Returns the node index of the key or -1
+static int32_t config_trieFindKey(const ConfigTrie_t* trie, const char* key) {
+    int32_t node_idx = 0;
+    for(;;) {
+        const uint32_t len = strcspn(key, ".");
+        node_idx = config_trieChild(trie, node_idx, key, len);
+        if(node_idx < 0 || key[len] == '\0') return node_idx;
+        key += len + 1;
+    }
+}
+
+// Returns the node index of the path or -1
+static int32_t config_trieFindPath(const ConfigTrie_t* trie, const char* const* segments, uint32_t segment_count) {
+    int32_t node_idx = 0;
+    for(uint32_t i = 0; i < segment_count && node_idx >= 0; i++) {
+        if(segments[i] == NULL) return -1;
+        node_idx = config_trieChild(trie, node_idx, segments[i], strlen(segments[i]));
+    }
+    return node_idx;
+}
+
+uint32_t config_trieNodeCount(const ConfigTable_t* cfg) {
+    if(cfg == NULL) return 0;
+    uint32_t count = 1;
+    for(uint32_t i = 0; i < cfg->count; i++) {
+        count++;
+        for(const char* c = cfg->entries[i].key; *c != '\0'; c++) {
+            if(*c == '.') count++;
+        }
+    }
+    return count;
+}
+
+CfgRet_t config_trieBuild(ConfigTrie_t* trie, const ConfigTable_t* cfg) {
+    if(trie == NULL || cfg == NULL || trie->nodes == NULL || trie->order == NULL) return CFG_RC_ERROR_NULLPTR;
+    // Queries fail until the trie is complete
+    trie->cfg = NULL;
+    trie->node_count = 0;
+    if(trie->node_capacity == 0) return CFG_RC_ERROR_TOO_LARGE;
+    for(uint32_t i = 0; i < cfg->count; i++) trie->order[i] = i;
+    config_trieSort(cfg, trie->order, cfg->count);
+
+    // The root has no segment and no entry. Nodes are created breadth-first,
+    // so the children of every node are created one after another
+    trie->nodes[0] = (ConfigTrieNode_t){0, 0, -1, 0, 0, 0, cfg->count};
+    uint32_t node_count = 1;
+    for(uint32_t n = 0; n < node_count; n++) {
+        ConfigTrieNode_t* node = &(trie->nodes[n]);
+        uint32_t i = node->first;
+        uint32_t start = 0;
+        if(n > 0) {
+            // Keys ending with this segment are sorted before the keys continuing it
+            while(i < node->last && cfg->entries[trie->order[i]].key[node->path_len] == '\0') {
+                if(node->entry < 0) node->entry = (int32_t)trie->order[i];
+                i++;
+            }
+            start = node->path_len + 1;
+        }
+        node->first_child = node_count;
+        while(i < node->last) {
+            const char* segment = cfg->entries[trie->order[i]].key + start;
+            const uint32_t segment_len = strcspn(segment, ".");
+            uint32_t end = i + 1;
+            while(end < node->last &&
+                  config_trieSegmentEquals(cfg->entries[trie->order[end]].key + start, segment, segment_len)) {
+                end++;
+            }
+            if(node_count == trie->node_capacity) return CFG_RC_ERROR_TOO_LARGE;
+            trie->nodes[node_count++] = (ConfigTrieNode_t){segment_len, start + segment_len, -1, 0, 0, i, end};
+            node->child_count++;
+            i = end;
+        }
+    }
+    trie->cfg = cfg;
+    trie->node_count = node_count;
+    trie->generation = cfg->generation;
+    return CFG_RC_SUCCESS;
+}
+
+int32_t config_trieGetIdx(const ConfigTrie_t* trie, const char* key) {
+    if(trie == NULL || key == NULL || !config_trieValid(trie)) return -1;
+    const int32_t node_idx = config_trieFindKey(trie, key);
+    return node_idx < 0 ? -1 : trie->nodes[node_idx].entry;
+}
+
+int32_t config_trieGetIdxFromPath(const ConfigTrie_t* trie, const char* const* segments, uint32_t segment_count) {
+    if(trie == NULL || segments == NULL || segment_count == 0 || !config_trieValid(trie)) return -1;
+    const int32_t node_idx = config_trieFindPath(trie, segments, segment_count);
+    return node_idx < 0 ? -1 : trie->nodes[node_idx].entry;
+}
+
+// Returns the order range of a node
+static CfgRet_t config_trieSubtree(const ConfigTrie_t* trie, int32_t node_idx, const uint32_t** indices,
+                                   uint32_t* count) {
+    if(node_idx < 0) return CFG_RC_ERROR_UNKNOWN_KEY;
+    const ConfigTrieNode_t* node = &(trie->nodes[node_idx]);
+    *indices = trie->order + node->first;
+    *count = node->last - node->first;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_trieGetPrefix(const ConfigTrie_t* trie, const char* prefix, const uint32_t** indices, uint32_t* count) {
+    if(trie == NULL || prefix == NULL || indices == NULL || count == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(!config_trieValid(trie)) return CFG_RC_ERROR_INVALID;
+    return config_trieSubtree(trie, config_trieFindKey(trie, prefix), indices, count);
+}
+
+CfgRet_t config_trieGetPrefixFromPath(const ConfigTrie_t* trie, const char* const* segments, uint32_t segment_count,
+                                      const uint32_t** indices, uint32_t* count) {
+    if(trie == NULL || indices == NULL || count == NULL) return CFG_RC_ERROR_NULLPTR;
+    if(segments == NULL && segment_count > 0) return CFG_RC_ERROR_NULLPTR;
+    if(!config_trieValid(trie)) return CFG_RC_ERROR_INVALID;
+    return config_trieSubtree(trie, config_trieFindPath(trie, segments, segment_count), indices, count);
+}
@@ -0,0 +1,94 @@
+#include "config_txn.h"
+#include "config_internal.h"
+#include "config_log.h"
+#include "config_notify.h"
+
+#include <string.h>
+
+CfgRet_t config_txnBegin(ConfigTxn_t* txn, ConfigTable_t* cfg) {
+    if(txn == NULL || cfg == NULL || txn->writes == NULL || txn->buffer == NULL) return CFG_RC_ERROR_NULLPTR;
+    txn->cfg = cfg;
+    txn->write_count = 0;
+    txn->buffer_used = 0;
+    txn->generation = cfg->generation;
+    txn->error = CFG_RC_SUCCESS;
+    return CFG_RC_SUCCESS;
+}
+
+static CfgRet_t config_txnStage(ConfigTxn_t* txn, uint32_t idx, const void* value, uint32_t size) {
+    const ConfigEntry_t* entry = &(txn->cfg->entries[idx]);
+    if(entry->perm == CFG_PERM_RO || entry->perm == CFG_PERM_SECRET_RO) return CFG_RC_ERROR_READ_ONLY;
+    if(size > entry->size || size > txn->buffer_size - txn->buffer_used) return CFG_RC_ERROR_TOO_LARGE;
+    ConfigStagedWrite_t* write = NULL;
+    for(uint32_t i = 0; i < txn->write_count; i++) {
+        if(txn->writes[i].idx == idx) write = &txn->writes[i];
+    }
+    if(write == NULL) {
+        if(txn->write_count >= txn->write_capacity) return CFG_RC_ERROR_TOO_LARGE;
+        write = &txn->writes[txn->write_count++];
+        write->idx = idx;
+    }
+    // A replaced value keeps its old space in the buffer until the transaction ends
+    write->offset = txn->buffer_used;
+    write->size = size;
+    memcpy(txn->buffer + txn->buffer_used, value, size);
+    txn->buffer_used += size;
+    return CFG_RC_SUCCESS;
+}
+
+CfgRet_t config_txnSetByIdx(ConfigTxn_t* txn, uint32_t idx, const void* value, uint32_t size) {
+    if(txn == NULL || txn->cfg == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    CfgRet_t ret = CFG_RC_ERROR_RANGE;
+    if(idx < txn->cfg->count) ret = config_txnStage(txn, idx, value, size);
+    if(ret != CFG_RC_SUCCESS && txn->error == CFG_RC_SUCCESS) txn->error = ret;
+    return ret;
+}
+
+CfgRet_t config_txnSetByKey(ConfigTxn_t* txn, const char* key, const void* value, uint32_t size) {
+    if(txn == NULL || txn->cfg == NULL || key == NULL || value == NULL) return CFG_RC_ERROR_NULLPTR;
+    const int32_t idx = config_getIdxFromKey(txn->cfg, key);
+    if(idx < 0) {
+        if(txn->error == CFG_RC_SUCCESS) txn->error = CFG_RC_ERROR_UNKNOWN_KEY;
+        return CFG_RC_ERROR_UNKNOWN_KEY;
+    }
+    return config_txnSetByIdx(txn, idx, value, size);
+}
+
+CfgRet_t config_txnCommit(ConfigTxn_t* txn) {
+    if(txn == NULL || txn->cfg == NULL) return CFG_RC_ERROR_NULLPTR;
+    ConfigTable_t* cfg = txn->cfg;
+    CfgRet_t ret = txn->error;
+    // Sorting moves entries, staged indices would refer to other entries now
+    if(ret == CFG_RC_SUCCESS && txn->generation != cfg->generation) ret = CFG_RC_ERROR_INVALID;
+    if(ret != CFG_RC_SUCCESS) {
+        config_txnAbort(txn);
+        return ret;
+    }
+
+    // Staged writes were validated and neither permissions nor sizes of entries change,
+    // so none of the writes below can fail. The log stays attached, so writes of other threads are
+    // logged as usual, while the changes of the transaction are logged together below
+    if(cfg->log != NULL && txn->changed == NULL) {
+        config_txnAbort(txn);
+        return CFG_RC_ERROR_NULLPTR;
+    }
+    uint32_t changed_count = 0;
+    config_notifyBeginBatch(cfg);
+    for(uint32_t i = 0; i < txn->write_count; i++) {
+        const ConfigStagedWrite_t* write = &txn->writes[i];
+        bool changed = false;
+        config_setByIdxUnlogged(cfg, write->idx, txn->buffer + write->offset, write->size, &changed);
+        if(changed && txn->changed != NULL) txn->changed[changed_count++] = write->idx;
+    }
+    if(cfg->log != NULL && changed_count > 0) ret = config_logAppendEntries(cfg, txn->changed, changed_count);
+    config_notifyEndBatch(cfg);
+    config_txnAbort(txn);
+    return ret;
+}
+
+void config_txnAbort(ConfigTxn_t* txn) {
+    if(txn == NULL) return;
+    txn->cfg = NULL;
+    txn->write_count = 0;
+    txn->buffer_used = 0;
+}
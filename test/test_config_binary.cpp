@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "config_binary.h"
+
+#include <vector>
+
+class Config_Binary_Test : public testing::Test {
+protected:
+    uint32_t _uint32_config_entry = 115200;
+    int32_t _int32_config_entry = -42;
+    float _float_config_entry = 1.5f;
+    char _string_config_entry[16] = "foobar";
+    bool _bool_config_entry = true;
+    uint32_t _read_only_entry = 7;
+
+    ConfigEntry_t config_entries[6] = {
+        {"uint32_t", CONFIG_UINT32, &_uint32_config_entry, sizeof(_uint32_config_entry)},
+        {"int32_t", CONFIG_INT32, &_int32_config_entry, sizeof(_int32_config_entry)},
+        {"float", CONFIG_FLOAT, &_float_config_entry, sizeof(_float_config_entry)},
+        {"string", CONFIG_STRING, &_string_config_entry, sizeof(_string_config_entry)},
+        {"bool", CONFIG_BOOL, &_bool_config_entry, sizeof(_bool_config_entry)},
+        {"read_only", CONFIG_UINT32, &_read_only_entry, sizeof(_read_only_entry), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    std::vector<uint8_t> format() {
+        std::vector<uint8_t> buf(config_binaryGetSize(&config_table));
+        uint32_t len = 0;
+        EXPECT_EQ(CFG_RC_SUCCESS, config_binaryFormat(&config_table, buf.data(), buf.size(), &len));
+        EXPECT_EQ(buf.size(), len);
+        return buf;
+    }
+
+    void clearValues() {
+        _uint32_config_entry = 0;
+        _int32_config_entry = 0;
+        _float_config_entry = 0;
+        memset(_string_config_entry, 0, sizeof(_string_config_entry));
+        _bool_config_entry = false;
+    }
+};
+
+TEST_F(Config_Binary_Test, FormatTest) {
+    const std::vector<uint8_t> buf = format();
+    ASSERT_GE(buf.size(), CFG_BINARY_HEADER_SIZE);
+    EXPECT_EQ(0, memcmp(buf.data(), "CFGB", 4));
+    EXPECT_EQ(CFG_BINARY_VERSION, buf[4] | (buf[5] << 8));
+    // Values follow the schema in table order
+    const uint32_t values_size = 4 + 4 + 4 + 16 + sizeof(bool) + 4;
+    EXPECT_EQ(0, memcmp(buf.data() + buf.size() - values_size, &_uint32_config_entry, 4));
+
+    std::vector<uint8_t> small(buf.size() - 1);
+    uint32_t len = 0;
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_binaryFormat(&config_table, small.data(), small.size(), &len));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_binaryFormat(&config_table, nullptr, buf.size(), &len));
+}
+
+TEST_F(Config_Binary_Test, FingerprintTest) {
+    const uint32_t fingerprint = config_binaryFingerprint(&config_table);
+    // Values do not change the layout
+    _uint32_config_entry = 1;
+    EXPECT_EQ(fingerprint, config_binaryFingerprint(&config_table));
+    // Keys, types and sizes do
+    config_entries[3].size = 8;
+    EXPECT_NE(fingerprint, config_binaryFingerprint(&config_table));
+    config_entries[3].size = sizeof(_string_config_entry);
+    config_entries[0].type = CONFIG_INT32;
+    EXPECT_NE(fingerprint, config_binaryFingerprint(&config_table));
+    config_entries[0].type = CONFIG_UINT32;
+    config_entries[0].key = "uint32";
+    EXPECT_NE(fingerprint, config_binaryFingerprint(&config_table));
+}
+
+TEST_F(Config_Binary_Test, MatchingLayoutTest) {
+    const std::vector<uint8_t> buf = format();
+    clearValues();
+    _read_only_entry = 8;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_binaryParse(&config_table, buf.data(), buf.size()));
+    EXPECT_EQ(115200, _uint32_config_entry);
+    EXPECT_EQ(-42, _int32_config_entry);
+    EXPECT_EQ(1.5f, _float_config_entry);
+    EXPECT_STREQ("foobar", _string_config_entry);
+    EXPECT_TRUE(_bool_config_entry);
+    // Read-only entries keep their value
+    EXPECT_EQ(8, _read_only_entry);
+}
+
+TEST_F(Config_Binary_Test, ChangedLayoutTest) {
+    const std::vector<uint8_t> buf = format();
+
+    // Reordered entries, a smaller string buffer, a changed type and a new entry
+    char small_string[8] = "";
+    uint32_t uint = 0;
+    int32_t bool_as_int = 0;
+    uint32_t new_entry = 3;
+    ConfigEntry_t changed_entries[] = {
+        {"string", CONFIG_STRING, &small_string, sizeof(small_string)},
+        {"bool", CONFIG_INT32, &bool_as_int, sizeof(bool_as_int)},
+        {"new", CONFIG_UINT32, &new_entry, sizeof(new_entry)},
+        {"uint32_t", CONFIG_UINT32, &uint, sizeof(uint)},
+    };
+    ConfigTable_t changed_table = {
+        .entries = changed_entries,
+        .count = static_cast<uint32_t>(std::size(changed_entries))
+    };
+    ASSERT_NE(config_binaryFingerprint(&config_table), config_binaryFingerprint(&changed_table));
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_binaryParse(&changed_table, buf.data(), buf.size()));
+    EXPECT_STREQ("foobar", small_string);
+    EXPECT_EQ(115200, uint);
+    EXPECT_EQ(0, bool_as_int);
+    EXPECT_EQ(3, new_entry);
+
+    // Strings which do not fit are skipped
+    strcpy(_string_config_entry, "0123456789");
+    const std::vector<uint8_t> long_string = format();
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_binaryParse(&changed_table, long_string.data(), long_string.size()));
+    EXPECT_STREQ("foobar", small_string);
+}
+
+TEST_F(Config_Binary_Test, CorruptionTest) {
+    std::vector<uint8_t> buf = format();
+    clearValues();
+
+    // Any flipped bit is detected before a value is changed
+    buf[buf.size() - 5] ^= 0x10;
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_binaryParse(&config_table, buf.data(), buf.size()));
+    EXPECT_EQ(0, _uint32_config_entry);
+    buf[buf.size() - 5] ^= 0x10;
+
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_binaryParse(&config_table, buf.data(), buf.size() - 1));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_binaryParse(&config_table, buf.data(), CFG_BINARY_HEADER_SIZE - 1));
+    buf[0] = 'X';
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_binaryParse(&config_table, buf.data(), buf.size()));
+    buf[0] = 'C';
+    buf[4] = CFG_BINARY_VERSION + 1;
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_binaryParse(&config_table, buf.data(), buf.size()));
+    buf[4] = CFG_BINARY_VERSION;
+    // Text files are rejected
+    const char text[] = "uint32_t: 1\nint32_t: 2\nfloat: 3\nstring: foo\n";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_binaryParse(&config_table, (const uint8_t*)text, sizeof(text)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_binaryParse(&config_table, buf.data(), buf.size()));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_binaryParse(&config_table, nullptr, buf.size()));
+}
+
+TEST_F(Config_Binary_Test, SaveLoadTest) {
+    constexpr char filename[] = "test_binary.bin";
+    config_setSaveLoadFunctions(config_binarySaveFunc, config_binaryLoadFunc);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveToFile(&config_table, filename));
+    clearValues();
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    config_setSaveLoadFunctions(nullptr, nullptr);
+    EXPECT_EQ(115200, _uint32_config_entry);
+    EXPECT_STREQ("foobar", _string_config_entry);
+
+    EXPECT_EQ(CFG_RC_ERROR, config_binaryLoadFunc(&config_table, "does_not_exist.bin"));
+    remove(filename);
+}
+
+TEST_F(Config_Binary_Test, SaveDirtyTest) {
+    constexpr char filename[] = "test_binary_dirty.bin";
+    uint32_t bitmap[CFG_DIRTY_WORD_COUNT(sizeof(config_entries) / sizeof(config_entries[0]))];
+    ASSERT_EQ(CFG_RC_SUCCESS, config_enableDirtyTracking(&config_table, bitmap, std::size(bitmap)));
+    const ConfigIo_t binary_io = {config_binarySaveFunc, config_binaryLoadFunc, nullptr};
+    config_table.io = &binary_io;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveToFile(&config_table, filename));
+
+    // Binary snapshots are never patched with text lines, the whole table is saved instead
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "string", "baz", sizeof("baz")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ(0u, config_getDirtyCount(&config_table));
+    clearValues();
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    EXPECT_STREQ("baz", _string_config_entry);
+    EXPECT_EQ(115200u, _uint32_config_entry);
+
+    // The same for the process-wide save function
+    config_table.io = nullptr;
+    config_setSaveLoadFunctions(config_binarySaveFunc, config_binaryLoadFunc);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "string", "qux", sizeof("qux")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    clearValues();
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    config_setSaveLoadFunctions(nullptr, nullptr);
+    EXPECT_STREQ("qux", _string_config_entry);
+    remove(filename);
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+#include "config_layer.h"
+#include "config_notify.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+constexpr char test_filename[] = "test_layer.txt";
+constexpr uint32_t entry_count = 4;
+constexpr uint32_t layer_count = 3;
+
+void writeFile(const char* contents) {
+    FILE* file = std::fopen(test_filename, "w");
+    ASSERT_NE(nullptr, file);
+    std::fputs(contents, file);
+    std::fclose(file);
+}
+
+// Records every batch of changed entries
+struct Recorder {
+    std::vector<std::vector<uint32_t>> batches;
+
+    static void callback(void* ctx, const ConfigTable_t*, const uint32_t* changed, uint32_t changed_count) {
+        static_cast<Recorder*>(ctx)->batches.emplace_back(changed, changed + changed_count);
+    }
+};
+}  // namespace
+
+class Config_Layer_Test : public testing::Test {
+protected:
+    char _ssid[16] = "default";
+    uint32_t _baud_rate = 9600;
+    bool _enabled = false;
+    uint32_t _version = 3;
+
+    ConfigEntry_t config_entries[entry_count] = {
+        {"wifi.ssid", CONFIG_STRING, &_ssid, sizeof(_ssid)},
+        {"uart.baud_rate", CONFIG_UINT32, &_baud_rate, sizeof(_baud_rate)},
+        {"enabled", CONFIG_BOOL, &_enabled, sizeof(_enabled)},
+        {"version", CONFIG_UINT32, &_version, sizeof(_version), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {.entries = config_entries, .count = entry_count};
+
+    // Layers: defaults, site file, runtime overrides
+    alignas(8) uint8_t values[layer_count][64] = {};
+    uint32_t present[layer_count][CFG_DIRTY_WORD_COUNT(entry_count)] = {};
+    ConfigLayer_t layer_storage[layer_count] = {
+        {"defaults", values[0], present[0]},
+        {"site", values[1], present[1]},
+        {"runtime", values[2], present[2]},
+    };
+    uint32_t offsets[entry_count] = {};
+    uint8_t sources[entry_count] = {};
+    ConfigLayers_t layers = {layer_storage, layer_count, offsets, sources, nullptr};
+
+    void SetUp() override {
+        ASSERT_LE(config_layerValueSize(&config_table), sizeof(values[0]));
+        ASSERT_EQ(CFG_RC_SUCCESS, config_layerInit(&layers, &config_table));
+    }
+
+    void TearDown() override {
+        std::remove(test_filename);
+    }
+
+    CfgRet_t setBaudRate(uint32_t layer, uint32_t baud_rate) {
+        return config_layerSet(&layers, layer, 1, &baud_rate, sizeof(baud_rate));
+    }
+};
+
+TEST_F(Config_Layer_Test, OverrideTest) {
+    EXPECT_EQ(40u, config_layerValueSize(&config_table));
+    for(uint32_t i = 0; i < entry_count; i++) {
+        EXPECT_EQ(0, config_layerGetSource(&layers, i));
+        EXPECT_TRUE(config_layerIsSet(&layers, 0, i));
+        EXPECT_FALSE(config_layerIsSet(&layers, 1, i));
+    }
+
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(1, 19200));
+    EXPECT_EQ(19200u, _baud_rate);
+    EXPECT_EQ(1, config_layerGetSource(&layers, 1));
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(2, 115200));
+    EXPECT_EQ(115200u, _baud_rate);
+    EXPECT_EQ(2, config_layerGetSource(&layers, 1));
+
+    // Lower layers are shadowed by the runtime override
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(1, 57600));
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(0, 4800));
+    EXPECT_EQ(115200u, _baud_rate);
+    EXPECT_EQ(2, config_layerGetSource(&layers, 1));
+
+    // Shorter strings do not keep parts of the old value
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerSet(&layers, 1, 0, "site-wifi", sizeof("site-wifi")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerSet(&layers, 1, 0, "lab", sizeof("lab")));
+    EXPECT_EQ(0, std::memcmp("lab\0\0\0\0\0\0\0", _ssid, 10));
+}
+
+TEST_F(Config_Layer_Test, UnsetTest) {
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(1, 19200));
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(2, 115200));
+
+    // Falls back to the next lower layer setting the entry
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 2, 1));
+    EXPECT_EQ(19200u, _baud_rate);
+    EXPECT_EQ(1, config_layerGetSource(&layers, 1));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 2, 1));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 1, 1));
+    EXPECT_EQ(9600u, _baud_rate);
+    EXPECT_EQ(0, config_layerGetSource(&layers, 1));
+
+    // Removing a shadowed value keeps the effective value
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(1, 19200));
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(2, 115200));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 1, 1));
+    EXPECT_EQ(115200u, _baud_rate);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 2, 1));
+    EXPECT_EQ(9600u, _baud_rate);
+
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerUnset(&layers, 0, 1));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_layerUnset(&layers, layer_count, 1));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_layerUnset(&layers, 1, entry_count));
+}
+
+TEST_F(Config_Layer_Test, ClearTest) {
+    const bool enabled = true;
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(1, 19200));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerSet(&layers, 2, 2, &enabled, sizeof(enabled)));
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(2, 115200));
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerClear(&layers, 2));
+    EXPECT_EQ(19200u, _baud_rate);
+    EXPECT_FALSE(_enabled);
+    for(uint32_t i = 0; i < entry_count; i++) EXPECT_FALSE(config_layerIsSet(&layers, 2, i));
+
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerClear(&layers, 0));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_layerClear(&layers, layer_count));
+}
+
+TEST_F(Config_Layer_Test, ParseBufferTest) {
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(2, 115200));
+    char buf[] = "wifi.ssid: site\nuart.baud_rate: 19200\nenabled: 1\n";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerParseBuffer(&layers, 1, buf, sizeof(buf) - 1, nullptr, nullptr));
+    EXPECT_STREQ("site", _ssid);
+    EXPECT_TRUE(_enabled);
+    EXPECT_EQ(115200u, _baud_rate);
+    EXPECT_TRUE(config_layerIsSet(&layers, 1, 1));
+    EXPECT_EQ(2, config_layerGetSource(&layers, 1));
+
+    // Invalid lines are reported and leave the layer unchanged
+    std::vector<std::pair<uint32_t, CfgRet_t>> errors;
+    auto on_error = [](void* ctx, uint32_t line, CfgRet_t ret) {
+        static_cast<std::vector<std::pair<uint32_t, CfgRet_t>>*>(ctx)->emplace_back(line, ret);
+    };
+    char bad[] = "unknown: 1\nuart.baud_rate: fast\nversion: 4\nno separator\nwifi.ssid: lab\n";
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_layerParseBuffer(&layers, 1, bad, sizeof(bad) - 1, on_error, &errors));
+    ASSERT_EQ(4u, errors.size());
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, errors[0].second);
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, errors[2].second);
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, errors[3].second);
+    EXPECT_EQ(3u, _version);
+    EXPECT_STREQ("lab", _ssid);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 2, 1));
+    EXPECT_EQ(19200u, _baud_rate);
+}
+
+TEST_F(Config_Layer_Test, LoadFromFileTest) {
+    writeFile("wifi.ssid: site\nuart.baud_rate: 19200\n");
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerLoadFromFile(&layers, 1, test_filename));
+    EXPECT_STREQ("site", _ssid);
+    EXPECT_EQ(19200u, _baud_rate);
+
+    // Entries missing in the new file fall back to the defaults
+    writeFile("uart.baud_rate: 57600\nenabled: true\n");
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerLoadFromFile(&layers, 1, test_filename));
+    EXPECT_STREQ("default", _ssid);
+    EXPECT_EQ(57600u, _baud_rate);
+    EXPECT_TRUE(_enabled);
+    EXPECT_FALSE(config_layerIsSet(&layers, 1, 0));
+
+    // A missing file leaves the layer unchanged
+    std::remove(test_filename);
+    EXPECT_EQ(CFG_RC_ERROR, config_layerLoadFromFile(&layers, 1, test_filename));
+    EXPECT_EQ(57600u, _baud_rate);
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerLoadFromFile(&layers, 0, test_filename));
+}
+
+TEST_F(Config_Layer_Test, NotifyTest) {
+    uint32_t pending[CFG_DIRTY_WORD_COUNT(entry_count)];
+    uint32_t changed[entry_count];
+    uint32_t matched[entry_count];
+    ConfigSubscription_t subscriptions[1];
+    ConfigNotifier_t notifier = {
+        .pending = pending,
+        .changed = changed,
+        .matched = matched,
+        .subscriptions = subscriptions,
+        .subscription_capacity = 1,
+        .inline_dispatch = true,
+    };
+    Recorder recorder;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_notifyAttach(&config_table, &notifier));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, Recorder::callback, &recorder));
+
+    writeFile("wifi.ssid: site\nuart.baud_rate: 19200\n");
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerLoadFromFile(&layers, 1, test_filename));
+    ASSERT_EQ(1u, recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 1}), recorder.batches[0]);
+
+    // Reloading the same contents changes nothing, entries are not reset in between
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerLoadFromFile(&layers, 1, test_filename));
+    EXPECT_EQ(1u, recorder.batches.size());
+
+    // Shadowed changes are not notified
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(0, 4800));
+    EXPECT_EQ(1u, recorder.batches.size());
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerClear(&layers, 1));
+    ASSERT_EQ(2u, recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 1}), recorder.batches[1]);
+    EXPECT_EQ(4800u, _baud_rate);
+}
+
+TEST_F(Config_Layer_Test, SortedTableTest) {
+    EXPECT_EQ(CFG_RC_SUCCESS, setBaudRate(2, 115200));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    // Offsets and sources refer to the old entry order
+    writeFile("uart.baud_rate: 19200\n");
+    char buf[] = "enabled: 1\n";
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, setBaudRate(1, 19200));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerUnset(&layers, 2, 1));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerClear(&layers, 2));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerParseBuffer(&layers, 1, buf, sizeof(buf) - 1, nullptr, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerLoadFromFile(&layers, 1, test_filename));
+    EXPECT_EQ(-1, config_layerGetSource(&layers, 1));
+    EXPECT_FALSE(config_layerIsSet(&layers, 2, 1));
+    EXPECT_EQ(115200u, _baud_rate);
+    EXPECT_FALSE(_enabled);
+
+    // Initializing again takes the current values as defaults
+    ASSERT_EQ(CFG_RC_SUCCESS, config_layerInit(&layers, &config_table));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerLoadFromFile(&layers, 1, test_filename));
+    EXPECT_EQ(19200u, _baud_rate);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_layerUnset(&layers, 1, 1));
+    EXPECT_EQ(115200u, _baud_rate);
+    EXPECT_EQ(0, config_layerGetSource(&layers, 1));
+}
+
+TEST_F(Config_Layer_Test, ErrorTest) {
+    const uint32_t baud_rate = 19200;
+    const uint64_t too_large = 0;
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, config_layerSet(&layers, 1, 3, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_layerSet(&layers, 1, 1, &too_large, sizeof(too_large)));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_layerSet(&layers, layer_count, 1, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_layerSet(&layers, 1, entry_count, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_layerSet(&layers, 1, 1, nullptr, 0));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_layerSet(nullptr, 1, 1, &baud_rate, sizeof(baud_rate)));
+    EXPECT_FALSE(config_layerIsSet(&layers, 1, 3));
+    EXPECT_EQ(-1, config_layerGetSource(&layers, entry_count));
+    EXPECT_EQ(0u, config_layerValueSize(nullptr));
+
+    ConfigLayers_t uninitialized = {layer_storage, 0, offsets, sources, nullptr};
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_layerClear(&uninitialized, 1));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_layerInit(&uninitialized, &config_table));
+    uninitialized.layer_count = CFG_LAYER_MAX_COUNT + 1;
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_layerInit(&uninitialized, &config_table));
+    uninitialized.layer_count = layer_count;
+    uninitialized.sources = nullptr;
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_layerInit(&uninitialized, &config_table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_layerInit(&layers, nullptr));
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include "config_log.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+constexpr char snapshot_filename[] = "test_log_snapshot.txt";
+constexpr char log_filename[] = "test_log_changes.txt";
+constexpr char old_log_filename[] = "test_log_changes.txt.old";
+
+std::string readFile(const char* filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+void writeFile(const char* filename, const std::string& contents) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file << contents;
+}
+}  // namespace
+
+class Config_Log_Test : public testing::Test {
+protected:
+    uint32_t _counter = 0;
+    int32_t _offset = -1;
+    char _name[16] = "device";
+    bool _enabled = false;
+    uint32_t _read_only = 7;
+
+    ConfigEntry_t config_entries[5] = {
+        {"counter", CONFIG_UINT32, &_counter, sizeof(_counter)},
+        {"offset", CONFIG_INT32, &_offset, sizeof(_offset)},
+        {"name", CONFIG_STRING, &_name, sizeof(_name)},
+        {"enabled", CONFIG_BOOL, &_enabled, sizeof(_enabled)},
+        {"read_only", CONFIG_UINT32, &_read_only, sizeof(_read_only), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigLog_t log;
+
+    void SetUp() override {
+        std::remove(snapshot_filename);
+        std::remove(log_filename);
+        std::remove(old_log_filename);
+    }
+
+    void TearDown() override {
+        if(config_table.log != nullptr) config_logClose(&config_table);
+        std::remove(snapshot_filename);
+        std::remove(log_filename);
+        std::remove(old_log_filename);
+    }
+};
+
+TEST_F(Config_Log_Test, AppendOnChangeTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(&log, config_table.log);
+    EXPECT_EQ(0, log.size);
+
+    uint32_t counter = 1;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "counter", &counter, sizeof(counter)));
+    counter = 2;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    // Writing the stored value again does not add a record
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "name", "sensor", sizeof("sensor")));
+    // Failed writes do not add a record either
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, config_setByKey(&config_table, "read_only", &counter, sizeof(counter)));
+    char enabled_str[] = "enabled: true";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, enabled_str, sizeof(enabled_str)));
+
+    const std::string expected = "counter: 1\ncounter: 2\nname: sensor\nenabled: 1\n";
+    EXPECT_EQ(expected, readFile(log_filename));
+    EXPECT_EQ(expected.size(), log.size);
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+    EXPECT_EQ(nullptr, config_table.log);
+    // Without a log, writes are not recorded
+    counter = 3;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    EXPECT_EQ(expected, readFile(log_filename));
+}
+
+TEST_F(Config_Log_Test, ReplayTest) {
+    writeFile(snapshot_filename, "counter: 10\noffset: 5\nname: device\nenabled: 0\n");
+    writeFile(log_filename, "counter: 11\nname: sensor\ncounter: 12\n");
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(12, _counter);
+    EXPECT_EQ(5, _offset);
+    EXPECT_STREQ("sensor", _name);
+    EXPECT_FALSE(_enabled);
+    // Replaying must not append to the log
+    EXPECT_EQ("counter: 11\nname: sensor\ncounter: 12\n", readFile(log_filename));
+
+    // New records are appended behind the existing ones
+    int32_t offset = -3;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "offset", &offset, sizeof(offset)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+    EXPECT_EQ("counter: 11\nname: sensor\ncounter: 12\noffset: -3\n", readFile(log_filename));
+
+    // Reopening restores the latest state
+    _counter = 0;
+    _offset = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(12, _counter);
+    EXPECT_EQ(-3, _offset);
+
+    // Opening again closes the attached log first
+    ConfigLog_t reopened;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &reopened, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(&reopened, config_table.log);
+    EXPECT_EQ(nullptr, log.file);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+}
+
+TEST_F(Config_Log_Test, UnreadableSnapshotTest) {
+    // A snapshot which exists but cannot be read must not be replaced by a later compaction
+    ASSERT_TRUE(std::filesystem::create_directory(snapshot_filename));
+    writeFile(log_filename, "counter: 11\n");
+    EXPECT_EQ(CFG_RC_ERROR, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(nullptr, config_table.log);
+    EXPECT_TRUE(std::filesystem::is_directory(snapshot_filename));
+    std::filesystem::remove(snapshot_filename);
+
+    // Only missing files count as empty, not paths which cannot be opened
+    const std::string blocked_snapshot = std::string(log_filename) + "/snapshot.txt";
+    EXPECT_EQ(CFG_RC_ERROR, config_logOpen(&config_table, &log, blocked_snapshot.c_str(), log_filename, 1024));
+    EXPECT_EQ(nullptr, config_table.log);
+}
+
+TEST_F(Config_Log_Test, TornRecordTest) {
+    // Interrupted write of "counter: 1234\n"
+    writeFile(log_filename, "offset: 8\ncounter: 12");
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(0, _counter);
+    EXPECT_EQ(8, _offset);
+    // The log has been compacted, so new records start on a fresh line
+    EXPECT_EQ("", readFile(log_filename));
+    EXPECT_EQ(0, log.size);
+    EXPECT_NE(std::string::npos, readFile(snapshot_filename).find("offset: 8\n"));
+}
+
+TEST_F(Config_Log_Test, CompactionTest) {
+    // Each "counter: N\n" record with a single digit has 11 characters
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 30));
+    for(uint32_t counter = 1; counter <= 3; counter++) {
+        EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    }
+    // The third record crossed the threshold
+    EXPECT_EQ(0, log.size);
+    EXPECT_EQ("", readFile(log_filename));
+    const std::string snapshot = readFile(snapshot_filename);
+    EXPECT_NE(std::string::npos, snapshot.find("counter: 3\n"));
+    EXPECT_NE(std::string::npos, snapshot.find("read_only: 7\n"));
+    // The temporary snapshot has been renamed
+    EXPECT_EQ(nullptr, std::fopen((std::string(snapshot_filename) + ".tmp").c_str(), "rb"));
+
+    uint32_t counter = 4;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    EXPECT_EQ("counter: 4\n", readFile(log_filename));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+
+    _counter = 0;
+    // Like with config_loadFromFile, the read-only entry in the snapshot cannot be loaded
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 30));
+    EXPECT_EQ(&log, config_table.log);
+    EXPECT_EQ(4, _counter);
+}
+
+TEST_F(Config_Log_Test, FailedCompactionTest) {
+    // The snapshot cannot be created in a missing directory
+    constexpr char missing_snapshot[] = "missing_dir/test_log_snapshot.txt";
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, missing_snapshot, log_filename, 15));
+    uint32_t counter = 5;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    counter = 6;
+    EXPECT_EQ(CFG_RC_ERROR, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    EXPECT_EQ(6, _counter);
+    // The log is only truncated after the snapshot has been replaced
+    EXPECT_EQ("counter: 5\ncounter: 6\n", readFile(log_filename));
+    EXPECT_EQ(22, log.size);
+
+    // The next attempt waits until the log has grown by another threshold
+    counter = 7;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    counter = 8;
+    EXPECT_EQ(CFG_RC_ERROR, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    EXPECT_EQ(44, log.size);
+}
+
+TEST_F(Config_Log_Test, BackgroundCompactionTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 20));
+    uint32_t requests = 0;
+    log.request_compaction = [](void* ctx) { (*static_cast<uint32_t*>(ctx))++; };
+    log.request_ctx = &requests;
+    for(uint32_t counter = 1; counter <= 2; counter++) {
+        EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    }
+    // The setter crossing the threshold only started a new log file
+    EXPECT_EQ(1, requests);
+    EXPECT_TRUE(config_logNeedsCompaction(&log));
+    EXPECT_EQ("counter: 1\ncounter: 2\n", readFile(old_log_filename));
+    EXPECT_EQ("", readFile(log_filename));
+    EXPECT_EQ("", readFile(snapshot_filename));
+    uint32_t counter = 3;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &counter, sizeof(counter)));
+    EXPECT_EQ("counter: 3\n", readFile(log_filename));
+
+    // Work of the background task
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logCompactPrevious(&config_table));
+    EXPECT_FALSE(config_logNeedsCompaction(&log));
+    EXPECT_FALSE(std::filesystem::exists(old_log_filename));
+    EXPECT_NE(std::string::npos, readFile(snapshot_filename).find("counter: 3\n"));
+    EXPECT_EQ("counter: 3\n", readFile(log_filename));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logCompactPrevious(&config_table));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+
+    // A previous log file left by an interrupted compaction is replayed before the log and compacted
+    writeFile(old_log_filename, "counter: 7\noffset: 4\n");
+    writeFile(log_filename, "offset: 9\n");
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 20));
+    EXPECT_EQ(7, _counter);
+    EXPECT_EQ(9, _offset);
+    EXPECT_FALSE(config_logNeedsCompaction(&log));
+    EXPECT_FALSE(std::filesystem::exists(old_log_filename));
+    EXPECT_EQ("", readFile(log_filename));
+}
+
+TEST_F(Config_Log_Test, InvalidParameterTest) {
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logOpen(nullptr, &log, snapshot_filename, log_filename, 10));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logOpen(&config_table, nullptr, snapshot_filename, log_filename, 10));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logOpen(&config_table, &log, nullptr, log_filename, 10));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logAppend(&config_table, 0));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logCompact(&config_table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logCompactPrevious(&config_table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_logClose(&config_table));
+    EXPECT_FALSE(config_logNeedsCompaction(nullptr));
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_logAppend(&config_table, config_table.count));
+}
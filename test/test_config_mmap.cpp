@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "config_mmap.h"
+
+#include <cstdio>
+#include <string>
+
+#if CFG_MMAP_SUPPORTED
+
+namespace {
+constexpr char filename[] = "test_mmap.cfg";
+
+std::string readFile() {
+    std::string contents;
+    FILE* file_ptr = fopen(filename, "rb");
+    if(file_ptr == nullptr) return contents;
+    char buf[256];
+    size_t read;
+    while((read = fread(buf, 1, sizeof(buf), file_ptr)) > 0) contents.append(buf, read);
+    fclose(file_ptr);
+    return contents;
+}
+}  // namespace
+
+class Config_Mmap_Test : public testing::Test {
+protected:
+    uint32_t _uint32_config_entry = 115200;
+    float _float_config_entry = 1.5f;
+    char _string_config_entry[16] = "foobar";
+    uint32_t _read_only_entry = 7;
+
+    ConfigEntry_t config_entries[4] = {
+        {"uint32_t", CONFIG_UINT32, &_uint32_config_entry, sizeof(_uint32_config_entry)},
+        {"float", CONFIG_FLOAT, &_float_config_entry, sizeof(_float_config_entry)},
+        {"string", CONFIG_STRING, &_string_config_entry, sizeof(_string_config_entry)},
+        {"read_only", CONFIG_UINT32, &_read_only_entry, sizeof(_read_only_entry), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigMmap_t map{};
+
+    void SetUp() override {
+        remove(filename);
+    }
+
+    void TearDown() override {
+        if(map.base != nullptr) config_mmapClose(&map);
+        remove(filename);
+    }
+};
+
+TEST_F(Config_Mmap_Test, PersistWithoutSaveTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_mmapOpen(&config_table, &map, filename));
+    // The values live in the file now
+    EXPECT_NE(&_uint32_config_entry, config_entries[0].value);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(config_entries[0].value) % CFG_MMAP_ALIGNMENT);
+    uint32_t uint = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByIdx(&config_table, 0, &uint));
+    EXPECT_EQ(115200, uint);
+
+    // A write is visible in the file without any save call
+    uint = 0x5A5A1234;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &uint, sizeof(uint)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "string", "mapped", sizeof("mapped")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapFlush(&map));
+    const std::string contents = readFile();
+    EXPECT_NE(std::string::npos, contents.find(std::string(reinterpret_cast<const char*>(&uint), sizeof(uint))));
+    EXPECT_NE(std::string::npos, contents.find("mapped"));
+    // The original variables are not updated until the file is closed
+    EXPECT_EQ(115200, _uint32_config_entry);
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapClose(&map));
+    EXPECT_EQ(&_uint32_config_entry, config_entries[0].value);
+    EXPECT_EQ(0x5A5A1234, _uint32_config_entry);
+    EXPECT_STREQ("mapped", _string_config_entry);
+}
+
+TEST_F(Config_Mmap_Test, ReopenTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_mmapOpen(&config_table, &map, filename));
+    float value = 2.5f;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "float", &value, sizeof(value)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapClose(&map));
+
+    // Startup with the same table definition only maps the file
+    _float_config_entry = 0;
+    _read_only_entry = 8;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_mmapOpen(&config_table, &map, filename));
+    EXPECT_EQ(2.5f, *static_cast<float*>(config_entries[1].value));
+    // Read-only values come from the table definition
+    EXPECT_EQ(8, *static_cast<uint32_t*>(config_entries[3].value));
+}
+
+TEST_F(Config_Mmap_Test, MigrationTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_mmapOpen(&config_table, &map, filename));
+    uint32_t uint = 42;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &uint, sizeof(uint)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapClose(&map));
+
+    // New entry in front, a larger string buffer and a changed type
+    uint32_t new_entry = 3;
+    char large_string[64] = "";
+    int32_t float_as_int = -1;
+    uint32_t migrated_uint = 0;
+    ConfigEntry_t changed_entries[] = {
+        {"new", CONFIG_UINT32, &new_entry, sizeof(new_entry)},
+        {"string", CONFIG_STRING, &large_string, sizeof(large_string)},
+        {"float", CONFIG_INT32, &float_as_int, sizeof(float_as_int)},
+        {"uint32_t", CONFIG_UINT32, &migrated_uint, sizeof(migrated_uint)},
+    };
+    ConfigTable_t changed_table = {
+        .entries = changed_entries,
+        .count = static_cast<uint32_t>(std::size(changed_entries))
+    };
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_mmapOpen(&changed_table, &map, filename));
+    EXPECT_EQ(3, *static_cast<uint32_t*>(changed_entries[0].value));
+    EXPECT_STREQ("foobar", static_cast<char*>(changed_entries[1].value));
+    EXPECT_EQ(-1, *static_cast<int32_t*>(changed_entries[2].value));
+    EXPECT_EQ(42, *static_cast<uint32_t*>(changed_entries[3].value));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapClose(&map));
+
+    // The file has been replaced with the new layout, no temporary file is left behind
+    EXPECT_EQ(nullptr, fopen((std::string(filename) + ".tmp").c_str(), "rb"));
+    migrated_uint = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_mmapOpen(&changed_table, &map, filename));
+    EXPECT_EQ(42, *static_cast<uint32_t*>(changed_entries[3].value));
+    // The map refers to the local table, so it is closed before the table goes out of scope
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapClose(&map));
+}
+
+TEST_F(Config_Mmap_Test, SortWhileMappedTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_mmapOpen(&config_table, &map, filename));
+    uint32_t uint = 42;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "uint32_t", &uint, sizeof(uint)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "string", "sorted", sizeof("sorted")));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    ASSERT_STREQ("float", config_entries[0].key);
+
+    // Every value goes back to the variable of its own entry
+    EXPECT_EQ(CFG_RC_SUCCESS, config_mmapClose(&map));
+    EXPECT_EQ(42u, _uint32_config_entry);
+    EXPECT_EQ(1.5f, _float_config_entry);
+    EXPECT_STREQ("sorted", _string_config_entry);
+    EXPECT_EQ(7u, _read_only_entry);
+    EXPECT_EQ(&_float_config_entry, config_entries[0].value);
+    EXPECT_EQ(&_uint32_config_entry, config_entries[3].value);
+}
+
+TEST_F(Config_Mmap_Test, InvalidFileTest) {
+    FILE* file_ptr = fopen(filename, "wb");
+    ASSERT_NE(nullptr, file_ptr);
+    fputs("uint32_t: 1\nfloat: 2\nstring: text file which must not be overwritten\n", file_ptr);
+    fclose(file_ptr);
+    const std::string contents = readFile();
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_mmapOpen(&config_table, &map, filename));
+    EXPECT_EQ(nullptr, map.base);
+    EXPECT_EQ(&_uint32_config_entry, config_entries[0].value);
+    EXPECT_EQ(contents, readFile());
+
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_mmapOpen(nullptr, &map, filename));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_mmapFlush(&map));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_mmapClose(&map));
+}
+
+#endif
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+#include "config_notify.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr char test_filename[] = "test_notify.txt";
+
+// Records every batch delivered to a subscription
+struct Recorder {
+    std::vector<std::vector<uint32_t>> batches;
+
+    static void callback(void* ctx, const ConfigTable_t*, const uint32_t* changed, uint32_t changed_count) {
+        static_cast<Recorder*>(ctx)->batches.emplace_back(changed, changed + changed_count);
+    }
+};
+}  // namespace
+
+class Config_Notify_Test : public testing::Test {
+protected:
+    char _ssid[16] = "home";
+    char _password[16] = "secret";
+    uint32_t _baud_rate = 9600;
+    bool _enabled = false;
+
+    ConfigEntry_t config_entries[4] = {
+        {"wifi.ssid", CONFIG_STRING, &_ssid, sizeof(_ssid)},
+        {"wifi.password", CONFIG_STRING, &_password, sizeof(_password)},
+        {"uart.baud_rate", CONFIG_UINT32, &_baud_rate, sizeof(_baud_rate)},
+        {"enabled", CONFIG_BOOL, &_enabled, sizeof(_enabled)},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    uint32_t pending[CFG_DIRTY_WORD_COUNT(4)];
+    uint32_t changed[4];
+    uint32_t matched[4];
+    ConfigSubscription_t subscriptions[4];
+    ConfigNotifier_t notifier = {
+        .pending = pending,
+        .changed = changed,
+        .matched = matched,
+        .subscriptions = subscriptions,
+        .subscription_capacity = static_cast<uint32_t>(std::size(subscriptions)),
+    };
+
+    Recorder entry_recorder, prefix_recorder, table_recorder;
+
+    void SetUp() override {
+        ASSERT_EQ(CFG_RC_SUCCESS, config_notifyAttach(&config_table, &notifier));
+        ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeEntry(&config_table, "uart.baud_rate", Recorder::callback,
+                                                        &entry_recorder));
+        ASSERT_EQ(CFG_RC_SUCCESS, config_subscribePrefix(&config_table, "wifi.", Recorder::callback,
+                                                         &prefix_recorder));
+        ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, Recorder::callback, &table_recorder));
+    }
+
+    void TearDown() override {
+        std::remove(test_filename);
+    }
+};
+
+TEST_F(Config_Notify_Test, SubscribeTest) {
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_subscribeEntry(&config_table, "unknown", Recorder::callback, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_subscribeTable(&config_table, nullptr, nullptr));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, Recorder::callback, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_subscribeTable(&config_table, Recorder::callback, nullptr));
+    EXPECT_EQ(1u, config_unsubscribe(&config_table, Recorder::callback, nullptr));
+    EXPECT_EQ(3u, notifier.subscription_count);
+
+    ConfigTable_t table = config_table;
+    table.notifier = nullptr;
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_subscribeTable(&table, Recorder::callback, nullptr));
+}
+
+TEST_F(Config_Notify_Test, UnsubscribeInCallbackTest) {
+    EXPECT_EQ(1u, config_unsubscribe(&config_table, Recorder::callback, &entry_recorder));
+    EXPECT_EQ(1u, config_unsubscribe(&config_table, Recorder::callback, &prefix_recorder));
+    EXPECT_EQ(1u, config_unsubscribe(&config_table, Recorder::callback, &table_recorder));
+    // Unsubscribes itself on the first call
+    struct OneShot {
+        uint32_t calls = 0;
+        static void callback(void* ctx, const ConfigTable_t* cfg, const uint32_t*, uint32_t) {
+            static_cast<OneShot*>(ctx)->calls++;
+            config_unsubscribe(const_cast<ConfigTable_t*>(cfg), OneShot::callback, ctx);
+        }
+    } one_shot;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, OneShot::callback, &one_shot));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, Recorder::callback, &table_recorder));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribePrefix(&config_table, "wifi.", Recorder::callback, &prefix_recorder));
+
+    // The subscriptions behind the removed one still get the batch
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(1u, config_notifyDispatch(&config_table));
+    EXPECT_EQ(1u, one_shot.calls);
+    EXPECT_EQ(1u, table_recorder.batches.size());
+    EXPECT_EQ(1u, prefix_recorder.batches.size());
+    EXPECT_EQ(2u, notifier.subscription_count);
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.ssid", "home", sizeof("home")));
+    EXPECT_EQ(1u, config_notifyDispatch(&config_table));
+    EXPECT_EQ(1u, one_shot.calls);
+    EXPECT_EQ(2u, prefix_recorder.batches.size());
+}
+
+TEST_F(Config_Notify_Test, DispatchBatchTest) {
+    uint32_t baud_rate = 115200;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 2, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.ssid", "office", sizeof("office")));
+    // Unchanged values do not notify
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.password", "secret", sizeof("secret")));
+    // Nothing is delivered until dispatching
+    EXPECT_TRUE(table_recorder.batches.empty());
+    EXPECT_TRUE(config_notifyHasPending(&config_table));
+
+    EXPECT_EQ(2u, config_notifyDispatch(&config_table));
+    EXPECT_FALSE(config_notifyHasPending(&config_table));
+    ASSERT_EQ(1u, entry_recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({2}), entry_recorder.batches[0]);
+    ASSERT_EQ(1u, prefix_recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({0}), prefix_recorder.batches[0]);
+    ASSERT_EQ(1u, table_recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 2}), table_recorder.batches[0]);
+
+    // Writing the same values again is no change
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 2, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(0u, config_notifyDispatch(&config_table));
+    EXPECT_EQ(1u, table_recorder.batches.size());
+
+    // Only the prefix and table subscriptions match
+    bool enabled = true;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 3, &enabled, sizeof(enabled)));
+    EXPECT_EQ(1u, config_notifyDispatch(&config_table));
+    EXPECT_EQ(1u, entry_recorder.batches.size());
+    EXPECT_EQ(1u, prefix_recorder.batches.size());
+    EXPECT_EQ(2u, table_recorder.batches.size());
+}
+
+TEST_F(Config_Notify_Test, InlineDispatchTest) {
+    notifier.inline_dispatch = true;
+    uint32_t baud_rate = 115200;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 2, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(1u, entry_recorder.batches.size());
+    EXPECT_EQ(1u, table_recorder.batches.size());
+
+    // A batch delivers all changes together once it is closed
+    config_notifyBeginBatch(&config_table);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.password", "hunter2", sizeof("hunter2")));
+    EXPECT_TRUE(prefix_recorder.batches.empty());
+    config_notifyEndBatch(&config_table);
+    ASSERT_EQ(1u, prefix_recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 1}), prefix_recorder.batches[0]);
+    EXPECT_EQ(2u, table_recorder.batches.size());
+}
+
+TEST_F(Config_Notify_Test, LoadFiresOneBatchTest) {
+    notifier.inline_dispatch = true;
+    FILE* file = std::fopen(test_filename, "w");
+    ASSERT_NE(nullptr, file);
+    std::fputs("wifi.ssid: office\nwifi.password: hunter2\nuart.baud_rate: 9600\nenabled: 1\n", file);
+    std::fclose(file);
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, test_filename));
+    // The baud rate did not change
+    ASSERT_EQ(1u, table_recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 3}), table_recorder.batches[0]);
+    EXPECT_TRUE(entry_recorder.batches.empty());
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFileBuffered(&config_table, test_filename, nullptr, nullptr));
+    EXPECT_EQ(1u, table_recorder.batches.size());
+}
+
+TEST_F(Config_Notify_Test, SortTableTest) {
+    // Records the keys of the changed entries at delivery time
+    std::vector<std::string> keys;
+    auto key_callback = [](void* ctx, const ConfigTable_t* cfg, const uint32_t* changed, uint32_t changed_count) {
+        for(uint32_t i = 0; i < changed_count; i++) {
+            static_cast<std::vector<std::string>*>(ctx)->emplace_back(cfg->entries[changed[i]].key);
+        }
+    };
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeEntry(&config_table, "uart.baud_rate", key_callback, &keys));
+    uint32_t baud_rate = 115200;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 2, &baud_rate, sizeof(baud_rate)));
+
+    // Pending notifications are delivered before the entries move
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    ASSERT_STREQ("enabled", config_entries[0].key);
+    EXPECT_EQ(std::vector<std::string>({"uart.baud_rate"}), keys);
+    EXPECT_FALSE(config_notifyHasPending(&config_table));
+
+    // Entry subscriptions follow their entry to the new index
+    bool enabled = true;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "enabled", &enabled, sizeof(enabled)));
+    EXPECT_EQ(1u, config_notifyDispatch(&config_table));
+    EXPECT_EQ(1u, keys.size());
+    baud_rate = 9600;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "uart.baud_rate", &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(1u, config_notifyDispatch(&config_table));
+    EXPECT_EQ(std::vector<std::string>({"uart.baud_rate", "uart.baud_rate"}), keys);
+    ASSERT_EQ(2u, entry_recorder.batches.size());
+    EXPECT_EQ(std::vector<uint32_t>({1}), entry_recorder.batches[1]);
+}
+
+TEST_F(Config_Notify_Test, WakeFunctionTest) {
+    uint32_t wake_count = 0;
+    notifier.wake = [](void* ctx) { (*static_cast<uint32_t*>(ctx))++; };
+    notifier.wake_ctx = &wake_count;
+    uint32_t baud_rate = 115200;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 2, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(1u, wake_count);
+    // Already pending, the dispatching thread has been woken before
+    baud_rate = 57600;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 2, &baud_rate, sizeof(baud_rate)));
+    EXPECT_EQ(1u, wake_count);
+    EXPECT_EQ(1u, config_notifyDispatch(&config_table));
+    EXPECT_TRUE(entry_recorder.batches.size() == 1);
+}
@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include "config_number.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace {
+std::string formatFloat(float value) {
+    char buf[CFG_FLOAT_MAX_LEN];
+    const uint32_t len = config_formatFloat(buf, value);
+    EXPECT_LE(len, CFG_FLOAT_MAX_LEN);
+    return std::string(buf, len);
+}
+std::string formatDouble(double value) {
+    char buf[CFG_DOUBLE_MAX_LEN];
+    const uint32_t len = config_formatDouble(buf, value);
+    EXPECT_LE(len, CFG_DOUBLE_MAX_LEN);
+    return std::string(buf, len);
+}
+}  // namespace
+
+TEST(Config_Number_Test, IntegerFormattingTest) {
+    char buf[CFG_UINT64_MAX_LEN];
+    EXPECT_EQ("0", std::string(buf, config_formatUint32(buf, 0)));
+    EXPECT_EQ("9", std::string(buf, config_formatUint32(buf, 9)));
+    EXPECT_EQ("10", std::string(buf, config_formatUint32(buf, 10)));
+    EXPECT_EQ("115200", std::string(buf, config_formatUint32(buf, 115200)));
+    EXPECT_EQ("4294967295", std::string(buf, config_formatUint32(buf, UINT32_MAX)));
+    EXPECT_EQ("-42", std::string(buf, config_formatInt32(buf, -42)));
+    EXPECT_EQ("-2147483648", std::string(buf, config_formatInt32(buf, INT32_MIN)));
+    EXPECT_EQ("18446744073709551615", std::string(buf, config_formatUint64(buf, UINT64_MAX)));
+    EXPECT_EQ("-9223372036854775808", std::string(buf, config_formatInt64(buf, INT64_MIN)));
+}
+
+TEST(Config_Number_Test, FloatFormattingTest) {
+    EXPECT_EQ("0", formatFloat(0.0f));
+    EXPECT_EQ("-0", formatFloat(-0.0f));
+    EXPECT_EQ("1.5", formatFloat(1.5f));
+    EXPECT_EQ("0.1", formatFloat(0.1f));
+    EXPECT_EQ("-2.5", formatFloat(-2.5f));
+    EXPECT_EQ("100", formatFloat(100.0f));
+    EXPECT_EQ("123456.7", formatFloat(123456.7f));
+    EXPECT_EQ("16777216", formatFloat(16777216.0f));
+    EXPECT_EQ("0.00001", formatFloat(1e-5f));
+    EXPECT_EQ("1e9", formatFloat(1e9f));
+    EXPECT_EQ("1e-6", formatFloat(1e-6f));
+    EXPECT_EQ("3.4028235e38", formatFloat(std::numeric_limits<float>::max()));
+    EXPECT_EQ("1.1754944e-38", formatFloat(std::numeric_limits<float>::min()));
+    EXPECT_EQ("1e-45", formatFloat(std::numeric_limits<float>::denorm_min()));
+    EXPECT_EQ("inf", formatFloat(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("-inf", formatFloat(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("nan", formatFloat(std::numeric_limits<float>::quiet_NaN()));
+
+    // Every formatted value has to parse back to exactly the same float
+    uint32_t bits = 0x12345678;
+    for(int i = 0; i < 100000; i++) {
+        bits = bits * 1664525u + 1013904223u;
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        if(!std::isfinite(value)) continue;
+        const std::string str = formatFloat(value);
+        const float parsed = strtof(str.c_str(), nullptr);
+        ASSERT_EQ(0, memcmp(&value, &parsed, sizeof(value))) << str;
+    }
+}
+
+TEST(Config_Number_Test, DoubleFormattingTest) {
+    EXPECT_EQ("0", formatDouble(0.0));
+    EXPECT_EQ("-0", formatDouble(-0.0));
+    EXPECT_EQ("0.1", formatDouble(0.1));
+    EXPECT_EQ("0.30000000000000004", formatDouble(0.1 + 0.2));
+    EXPECT_EQ("123456789", formatDouble(123456789.0));
+    EXPECT_EQ("1e10", formatDouble(1e10));
+    EXPECT_EQ("-0.000012345678901234568", formatDouble(-0.000012345678901234567));
+    EXPECT_EQ("1.7976931348623157e308", formatDouble(std::numeric_limits<double>::max()));
+    EXPECT_EQ("2.2250738585072014e-308", formatDouble(std::numeric_limits<double>::min()));
+    EXPECT_EQ("5e-324", formatDouble(std::numeric_limits<double>::denorm_min()));
+    EXPECT_EQ("-inf", formatDouble(-std::numeric_limits<double>::infinity()));
+    EXPECT_EQ("nan", formatDouble(std::numeric_limits<double>::quiet_NaN()));
+
+    // Every formatted value has to parse back to exactly the same double
+    uint64_t bits = 0x123456789abcdefull;
+    for(int i = 0; i < 20000; i++) {
+        bits = bits * 6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if(!std::isfinite(value)) continue;
+        const std::string str = formatDouble(value);
+        const double parsed = strtod(str.c_str(), nullptr);
+        ASSERT_EQ(0, memcmp(&value, &parsed, sizeof(value))) << str;
+    }
+}
+
+TEST(Config_Number_Test, IntegerParsingTest) {
+    uint32_t uint32 = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("4294967295", 10, &uint32, nullptr));
+    EXPECT_EQ(UINT32_MAX, uint32);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("0x1f", 4, &uint32, nullptr));
+    EXPECT_EQ(0x1fu, uint32);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("0B101", 5, &uint32, nullptr));
+    EXPECT_EQ(5u, uint32);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("+7", 2, &uint32, nullptr));
+    EXPECT_EQ(7u, uint32);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("-0", 2, &uint32, nullptr));
+    EXPECT_EQ(0u, uint32);
+    uint32 = 42;
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseUint32("4294967296", 10, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseUint32("-1", 2, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseUint32("99999999999999999999999", 23, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32("", 0, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32("-", 1, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32("0x", 2, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32("0b2", 3, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32(" 1", 2, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32("1 ", 2, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseUint32("12abc", 5, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_parseUint32(nullptr, 0, &uint32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_parseUint32("1", 1, nullptr, nullptr));
+    // Failed calls leave the value unchanged
+    EXPECT_EQ(42u, uint32);
+
+    // Only len characters are parsed and consumed reports the end of the number
+    uint32_t consumed = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("123456", 3, &uint32, nullptr));
+    EXPECT_EQ(123u, uint32);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint32("12, 34", 6, &uint32, &consumed));
+    EXPECT_EQ(12u, uint32);
+    EXPECT_EQ(2u, consumed);
+
+    int32_t int32 = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseInt32("-2147483648", 11, &int32, nullptr));
+    EXPECT_EQ(INT32_MIN, int32);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseInt32("-0x10", 5, &int32, nullptr));
+    EXPECT_EQ(-16, int32);
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseInt32("2147483648", 10, &int32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseInt32("-2147483649", 11, &int32, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseInt32("0xFFFFFFFF", 10, &int32, nullptr));
+
+    uint64_t uint64 = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint64("18446744073709551615", 20, &uint64, nullptr));
+    EXPECT_EQ(UINT64_MAX, uint64);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseUint64("0xFFFFFFFFFFFFFFFF", 18, &uint64, nullptr));
+    EXPECT_EQ(UINT64_MAX, uint64);
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseUint64("18446744073709551616", 20, &uint64, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseUint64("0x10000000000000000", 19, &uint64, nullptr));
+
+    int64_t int64 = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseInt64("-9223372036854775808", 20, &int64, nullptr));
+    EXPECT_EQ(INT64_MIN, int64);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseInt64("9223372036854775807", 19, &int64, nullptr));
+    EXPECT_EQ(INT64_MAX, int64);
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseInt64("9223372036854775808", 19, &int64, nullptr));
+
+    // Every formatted integer parses back
+    char buf[CFG_INT64_MAX_LEN];
+    uint64_t bits = 0x9e3779b97f4a7c15ull;
+    for(int i = 0; i < 10000; i++) {
+        bits = bits * 6364136223846793005ull + 1442695040888963407ull;
+        const int64_t value = static_cast<int64_t>(bits) >> (i % 64);
+        const uint32_t len = config_formatInt64(buf, value);
+        ASSERT_EQ(CFG_RC_SUCCESS, config_parseInt64(buf, len, &int64, nullptr));
+        ASSERT_EQ(value, int64);
+    }
+}
+
+TEST(Config_Number_Test, FloatParsingTest) {
+    float f = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("1.5", 3, &f, nullptr));
+    EXPECT_EQ(1.5f, f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("-.25e1", 6, &f, nullptr));
+    EXPECT_EQ(-2.5f, f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("5.", 2, &f, nullptr));
+    EXPECT_EQ(5.0f, f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("3.4028235e38", 12, &f, nullptr));
+    EXPECT_EQ(std::numeric_limits<float>::max(), f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("1e-45", 5, &f, nullptr));
+    EXPECT_EQ(std::numeric_limits<float>::denorm_min(), f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("1e-50", 5, &f, nullptr));
+    EXPECT_EQ(0.0f, f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("-inf", 4, &f, nullptr));
+    EXPECT_EQ(-std::numeric_limits<float>::infinity(), f);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("NaN", 3, &f, nullptr));
+    EXPECT_TRUE(std::isnan(f));
+    f = 42.0f;
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseFloat("3.5e38", 6, &f, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseFloat("", 0, &f, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseFloat(".", 1, &f, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseFloat("1e", 2, &f, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseFloat("1,5", 3, &f, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseFloat("1.5.", 4, &f, nullptr));
+    EXPECT_EQ(42.0f, f);
+    uint32_t consumed = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseFloat("0.5, 1", 6, &f, &consumed));
+    EXPECT_EQ(0.5f, f);
+    EXPECT_EQ(3u, consumed);
+
+    double d = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("0.1", 3, &d, nullptr));
+    EXPECT_EQ(0.1, d);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("-0", 2, &d, nullptr));
+    EXPECT_TRUE(std::signbit(d));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("1.7976931348623157e308", 22, &d, nullptr));
+    EXPECT_EQ(std::numeric_limits<double>::max(), d);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("2.2250738585072011e-308", 23, &d, nullptr));
+    EXPECT_EQ(strtod("2.2250738585072011e-308", nullptr), d);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("4.9406564584124654e-324", 23, &d, nullptr));
+    EXPECT_EQ(std::numeric_limits<double>::denorm_min(), d);
+    // Exactly halfway between two doubles, rounds to even
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("9007199254740993", 16, &d, nullptr));
+    EXPECT_EQ(9007199254740992.0, d);
+    // A digit far behind the halfway point rounds up
+    const std::string halfway_up = "9007199254740993" + std::string(900, '0') + "1e-901";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble(halfway_up.c_str(), halfway_up.size(), &d, nullptr));
+    EXPECT_EQ(9007199254740994.0, d);
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseDouble("1.8e308", 7, &d, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseDouble("1e100000000", 11, &d, nullptr));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseDouble("1e-100000000", 12, &d, nullptr));
+    EXPECT_EQ(0.0, d);
+
+    // Every formatted value parses back to exactly the same bits and matches strtod for other notations
+    uint64_t bits = 0xfedcba9876543210ull;
+    char buf[64];
+    for(int i = 0; i < 20000; i++) {
+        bits = bits * 6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if(!std::isfinite(value)) continue;
+        const uint32_t len = config_formatDouble(buf, value);
+        double parsed;
+        ASSERT_EQ(CFG_RC_SUCCESS, config_parseDouble(buf, len, &parsed, nullptr)) << std::string(buf, len);
+        ASSERT_EQ(0, memcmp(&value, &parsed, sizeof(value))) << std::string(buf, len);
+
+        const int precision_len = snprintf(buf, sizeof(buf), "%.*e", i % 20, value);
+        ASSERT_EQ(CFG_RC_SUCCESS, config_parseDouble(buf, precision_len, &parsed, nullptr)) << buf;
+        EXPECT_EQ(strtod(buf, nullptr), parsed) << buf;
+
+        const uint32_t float_bits = static_cast<uint32_t>(bits >> 32);
+        float float_value;
+        memcpy(&float_value, &float_bits, sizeof(float_value));
+        if(!std::isfinite(float_value)) continue;
+        const int float_len = snprintf(buf, sizeof(buf), "%.*g", i % 12, static_cast<double>(float_value));
+        float parsed_float;
+        ASSERT_EQ(CFG_RC_SUCCESS, config_parseFloat(buf, float_len, &parsed_float, nullptr)) << buf;
+        EXPECT_EQ(strtof(buf, nullptr), parsed_float) << buf;
+    }
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "config_parallel.h"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace {
+constexpr uint32_t table_count = 12;
+
+// Load function recording the largest number of tables loaded at the same time
+std::atomic<uint32_t> active_loads{0};
+std::atomic<uint32_t> max_active_loads{0};
+CfgRet_t slowLoadFunc(ConfigTable_t* cfg, const char* filename) {
+    const uint32_t active = ++active_loads;
+    uint32_t max = max_active_loads.load();
+    while(active > max && !max_active_loads.compare_exchange_weak(max, active));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    --active_loads;
+    return config_loadFromFileBuffered(cfg, filename, nullptr, nullptr);
+}
+}  // namespace
+
+class Config_Parallel_Test : public testing::Test {
+protected:
+    // One table per module, all with the same layout but their own values and files
+    struct Module {
+        uint32_t id = 0;
+        char name[16] = "";
+        ConfigEntry_t entries[2] = {
+            {"module.id", CONFIG_UINT32, &id, sizeof(id)},
+            {"module.name", CONFIG_STRING, &name, sizeof(name)},
+        };
+        ConfigTable_t table = {.entries = entries, .count = 2};
+        std::string filename;
+    };
+    Module modules[table_count];
+    ConfigParallelJob_t jobs[table_count];
+
+    void SetUp() override {
+        for(uint32_t i = 0; i < table_count; i++) {
+            modules[i].id = i;
+            snprintf(modules[i].name, sizeof(modules[i].name), "module %u", i);
+            modules[i].filename = "test_parallel_" + std::to_string(i) + ".txt";
+            jobs[i] = {&modules[i].table, modules[i].filename.c_str(), CFG_RC_ERROR};
+        }
+    }
+
+    void TearDown() override {
+        for(const Module& module : modules) remove(module.filename.c_str());
+    }
+
+    void clearValues() {
+        for(Module& module : modules) {
+            module.id = UINT32_MAX;
+            module.name[0] = '\0';
+        }
+    }
+};
+
+TEST_F(Config_Parallel_Test, SaveLoadTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_parallelSave(jobs, table_count, 4));
+    for(const ConfigParallelJob_t& job : jobs) EXPECT_EQ(CFG_RC_SUCCESS, job.result);
+
+    clearValues();
+    ASSERT_EQ(CFG_RC_SUCCESS, config_parallelLoad(jobs, table_count, 4));
+    for(uint32_t i = 0; i < table_count; i++) {
+        EXPECT_EQ(CFG_RC_SUCCESS, jobs[i].result);
+        EXPECT_EQ(i, modules[i].id);
+        EXPECT_EQ("module " + std::to_string(i), modules[i].name);
+    }
+
+    // More threads than jobs and no threads at all
+    clearValues();
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parallelLoad(jobs, 2, 100));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parallelLoad(jobs + 2, table_count - 2, 0));
+    for(uint32_t i = 0; i < table_count; i++) EXPECT_EQ(i, modules[i].id);
+}
+
+TEST_F(Config_Parallel_Test, ConcurrencyTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_parallelSave(jobs, table_count, 4));
+    // Every table uses its own io context, the process-wide functions stay untouched
+    const ConfigIo_t slow_io = {nullptr, slowLoadFunc, nullptr};
+    for(Module& module : modules) module.table.io = &slow_io;
+    clearValues();
+    max_active_loads = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_parallelLoad(jobs, table_count, 4));
+    EXPECT_GT(max_active_loads.load(), 1u);
+    EXPECT_LE(max_active_loads.load(), 4u);
+    for(uint32_t i = 0; i < table_count; i++) EXPECT_EQ(i, modules[i].id);
+}
+
+TEST_F(Config_Parallel_Test, FailedJobTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_parallelSave(jobs, table_count, 4));
+    remove(modules[3].filename.c_str());
+    clearValues();
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_parallelLoad(jobs, table_count, 4));
+    // The other tables have still been loaded
+    for(uint32_t i = 0; i < table_count; i++) {
+        EXPECT_EQ(i == 3 ? CFG_RC_ERROR : CFG_RC_SUCCESS, jobs[i].result);
+        EXPECT_EQ(i == 3 ? UINT32_MAX : i, modules[i].id);
+    }
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parallelLoad(nullptr, 0, 4));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_parallelLoad(nullptr, 1, 4));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_parallelSave(nullptr, 1, 4));
+}
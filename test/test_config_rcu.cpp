@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "config_rcu.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if CFG_RCU_SUPPORTED
+
+class Config_Rcu_Test : public testing::Test {
+protected:
+    char _ssid[16] = "home";
+    char _password[16] = "home";
+    uint32_t _channel = 6;
+
+    ConfigEntry_t config_entries[3] = {
+        {"wifi.ssid", CONFIG_STRING, &_ssid, sizeof(_ssid)},
+        {"wifi.password", CONFIG_STRING, &_password, sizeof(_password)},
+        {"wifi.channel", CONFIG_UINT32, &_channel, sizeof(_channel)},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigRcu_t rcu{};
+    ConfigRcuReader_t readers[4];
+
+    void SetUp() override {
+        ASSERT_EQ(CFG_RC_SUCCESS, config_rcuInit(&rcu, &config_table, readers, std::size(readers)));
+    }
+
+    void TearDown() override {
+        config_rcuDestroy(&rcu);
+    }
+};
+
+TEST_F(Config_Rcu_Test, SnapshotValuesTest) {
+    const ConfigSnapshot_t* snapshot = config_rcuReadLock(&rcu, 0);
+    ASSERT_NE(nullptr, snapshot);
+    EXPECT_STREQ("home", static_cast<const char*>(config_snapshotGetValue(snapshot, 0)));
+    EXPECT_EQ(6u, *static_cast<const uint32_t*>(config_snapshotGetValueByKey(snapshot, "wifi.channel")));
+    EXPECT_EQ(nullptr, config_snapshotGetValue(snapshot, 3));
+    EXPECT_EQ(nullptr, config_snapshotGetValueByKey(snapshot, "wifi.unknown"));
+    config_rcuReadUnlock(&rcu, 0);
+
+    EXPECT_EQ(nullptr, config_rcuReadLock(&rcu, 4));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_rcuInit(nullptr, &config_table, readers, std::size(readers)));
+}
+
+TEST_F(Config_Rcu_Test, SnapshotIsImmutableTest) {
+    const ConfigSnapshot_t* old_snapshot = config_rcuReadLock(&rcu, 0);
+    ASSERT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.ssid", "office", sizeof("office")));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "wifi.password", "office", sizeof("office")));
+    // Changes are invisible until published
+    EXPECT_STREQ("home", static_cast<const char*>(config_snapshotGetValue(old_snapshot, 0)));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_rcuPublish(&rcu));
+    EXPECT_STREQ("home", static_cast<const char*>(config_snapshotGetValue(old_snapshot, 1)));
+
+    const ConfigSnapshot_t* new_snapshot = config_rcuReadLock(&rcu, 1);
+    EXPECT_NE(old_snapshot, new_snapshot);
+    EXPECT_STREQ("office", static_cast<const char*>(config_snapshotGetValue(new_snapshot, 0)));
+    EXPECT_STREQ("office", static_cast<const char*>(config_snapshotGetValue(new_snapshot, 1)));
+    config_rcuReadUnlock(&rcu, 1);
+    config_rcuReadUnlock(&rcu, 0);
+}
+
+TEST_F(Config_Rcu_Test, GracePeriodTest) {
+    config_rcuReadLock(&rcu, 0);
+    ASSERT_EQ(CFG_RC_SUCCESS, config_rcuPublish(&rcu));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_rcuPublish(&rcu));
+    // Both replaced snapshots may still be referenced by reader 0
+    EXPECT_EQ(2u, config_rcuReclaim(&rcu));
+
+    // A reader entering later only holds the current snapshot
+    config_rcuReadLock(&rcu, 1);
+    config_rcuReadUnlock(&rcu, 0);
+    EXPECT_EQ(0u, config_rcuReclaim(&rcu));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_rcuPublish(&rcu));
+    EXPECT_EQ(1u, config_rcuReclaim(&rcu));
+    config_rcuReadUnlock(&rcu, 1);
+    EXPECT_EQ(0u, config_rcuReclaim(&rcu));
+}
+
+TEST_F(Config_Rcu_Test, SortedTableTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    // The offsets of the snapshots refer to the old entry order
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_rcuPublish(&rcu));
+    const ConfigSnapshot_t* snapshot = config_rcuReadLock(&rcu, 0);
+    EXPECT_EQ(nullptr, config_snapshotGetValueByKey(snapshot, "wifi.channel"));
+    EXPECT_EQ(6u, *static_cast<const uint32_t*>(config_snapshotGetValue(snapshot, 2)));
+    config_rcuReadUnlock(&rcu, 0);
+
+    config_rcuDestroy(&rcu);
+    ASSERT_EQ(CFG_RC_SUCCESS, config_rcuInit(&rcu, &config_table, readers, std::size(readers)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_rcuPublish(&rcu));
+    snapshot = config_rcuReadLock(&rcu, 0);
+    EXPECT_EQ(6u, *static_cast<const uint32_t*>(config_snapshotGetValueByKey(snapshot, "wifi.channel")));
+    config_rcuReadUnlock(&rcu, 0);
+}
+
+TEST_F(Config_Rcu_Test, ConcurrentReadersTest) {
+    constexpr uint32_t publish_count = 2000;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> inconsistent_reads{0};
+    std::vector<std::thread> threads;
+    for(uint32_t r = 0; r < std::size(readers); r++) {
+        threads.emplace_back([&, r] {
+            while(!done.load()) {
+                const ConfigSnapshot_t* snapshot = config_rcuReadLock(&rcu, r);
+                // SSID and password are always changed together
+                const char* ssid = static_cast<const char*>(config_snapshotGetValue(snapshot, 0));
+                const char* password = static_cast<const char*>(config_snapshotGetValue(snapshot, 1));
+                if(strcmp(ssid, password) != 0) inconsistent_reads++;
+                config_rcuReadUnlock(&rcu, r);
+            }
+        });
+    }
+    for(uint32_t i = 0; i < publish_count; i++) {
+        const std::string value = "net" + std::to_string(i);
+        config_setByIdx(&config_table, 0, value.c_str(), value.size() + 1);
+        config_setByIdx(&config_table, 1, value.c_str(), value.size() + 1);
+        ASSERT_EQ(CFG_RC_SUCCESS, config_rcuPublish(&rcu));
+    }
+    done = true;
+    for(auto& thread : threads) thread.join();
+    EXPECT_EQ(0u, inconsistent_reads.load());
+    EXPECT_EQ(0u, config_rcuReclaim(&rcu));
+}
+
+#endif
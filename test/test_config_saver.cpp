@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "config_saver.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#if CFG_SAVER_SUPPORTED
+
+namespace {
+constexpr char test_filename[] = "test_saver.txt";
+
+std::string readFile(const char* filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+}  // namespace
+
+class Config_Saver_Test : public testing::Test {
+protected:
+    uint32_t _counter = 0;
+    char _name[16] = "device";
+
+    ConfigEntry_t config_entries[2] = {
+        {"counter", CONFIG_UINT32, &_counter, sizeof(_counter)},
+        {"name", CONFIG_STRING, &_name, sizeof(_name)},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigSaver_t saver{};
+
+    void SetUp() override {
+        std::remove(test_filename);
+    }
+
+    void TearDown() override {
+        if(saver.cfg != nullptr) config_saverStop(&saver);
+        std::remove(test_filename);
+    }
+};
+
+TEST_F(Config_Saver_Test, FlushTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverStart(&saver, &config_table, test_filename, 60000));
+    // Nothing requested, nothing to wait for
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverFlush(&saver));
+
+    _counter = 5;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverRequest(&saver));
+    // The debounce window is far away, flushing saves right away
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverFlush(&saver));
+    EXPECT_EQ("counter: 5\nname: device\n", readFile(test_filename));
+
+    ConfigSaverStats_t stats;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverGetStats(&saver, &stats));
+    EXPECT_EQ(1u, stats.save_count);
+    EXPECT_EQ(1u, stats.request_count);
+    EXPECT_EQ(CFG_RC_SUCCESS, stats.last_error);
+}
+
+TEST_F(Config_Saver_Test, DebounceCoalescesRequestsTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverStart(&saver, &config_table, test_filename, 50));
+    for(uint32_t i = 1; i <= 100; i++) {
+        EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &i, sizeof(i)));
+        EXPECT_EQ(CFG_RC_SUCCESS, config_saverRequest(&saver));
+    }
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverFlush(&saver));
+    EXPECT_EQ("counter: 100\nname: device\n", readFile(test_filename));
+
+    ConfigSaverStats_t stats;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverGetStats(&saver, &stats));
+    EXPECT_EQ(100u, stats.request_count);
+    EXPECT_LT(stats.save_count, 100u);
+    EXPECT_GE(stats.save_count, 1u);
+}
+
+TEST_F(Config_Saver_Test, StopSavesPendingTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverStart(&saver, &config_table, test_filename, 60000));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "name", "sensor", sizeof("sensor")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverRequest(&saver));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverStop(&saver));
+    EXPECT_EQ("counter: 0\nname: sensor\n", readFile(test_filename));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_saverRequest(&saver));
+}
+
+TEST_F(Config_Saver_Test, ErrorReportingTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverStart(&saver, &config_table, "missing_directory/test_saver.txt", 0));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverRequest(&saver));
+    EXPECT_EQ(CFG_RC_ERROR, config_saverFlush(&saver));
+    ConfigSaverStats_t stats;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverGetStats(&saver, &stats));
+    EXPECT_EQ(CFG_RC_ERROR, stats.last_error);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_saverStart(&saver, nullptr, test_filename, 0));
+}
+
+TEST_F(Config_Saver_Test, SortedTableTest) {
+    std::swap(config_entries[0], config_entries[1]);
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverStart(&saver, &config_table, test_filename, 0));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    // The private copy still has the old entry order, nothing is saved
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverRequest(&saver));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_saverFlush(&saver));
+    EXPECT_EQ("", readFile(test_filename));
+
+    // Restarting prepares the copy for the sorted table
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_saverStop(&saver));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saverStart(&saver, &config_table, test_filename, 0));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverRequest(&saver));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saverFlush(&saver));
+    EXPECT_EQ("counter: 0\nname: device\n", readFile(test_filename));
+}
+
+#endif
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include "config_stats.h"
+#include "config_stream.h"
+#include "config_table.h"
+
+#include <cstdio>
+#include <cstring>
+
+static_assert(CFG_STATS, "This test has to be compiled with CFG_STATS=1");
+
+namespace {
+// Fake clock advanced by the tests
+uint64_t fake_now = 0;
+uint64_t fakeClock() {
+    return fake_now;
+}
+
+// Load function taking a fixed time on the fake clock
+uint64_t fake_load_duration = 0;
+CfgRet_t slowLoadFunc(ConfigTable_t*, const char*) {
+    fake_now += fake_load_duration;
+    return CFG_RC_SUCCESS;
+}
+}  // namespace
+
+class Config_Stats_Test : public testing::Test {
+protected:
+    uint32_t _uint = 1;
+    float _float = 2.0f;
+    char _str[16] = "str";
+    uint32_t _ro = 3;
+
+    ConfigEntry_t config_entries[4] = {
+        {"uint", CONFIG_UINT32, &_uint, sizeof(_uint)},
+        {"float", CONFIG_FLOAT, &_float, sizeof(_float)},
+        {"str", CONFIG_STRING, &_str, sizeof(_str)},
+        {"ro", CONFIG_UINT32, &_ro, sizeof(_ro), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigStats_t stats = {};
+
+    void SetUp() override {
+        fake_now = 0;
+        stats.clock = fakeClock;
+        ASSERT_EQ(CFG_RC_SUCCESS, config_statsAttach(&config_table, &stats));
+    }
+
+    uint64_t counter(ConfigStatCounter_t c) {
+        ConfigStats_t copy;
+        EXPECT_EQ(CFG_RC_SUCCESS, config_statsRead(&config_table, &copy));
+        return copy.counters[c];
+    }
+};
+
+TEST_F(Config_Stats_Test, LookupsTest) {
+    uint32_t uint = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint", &uint));
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_getUint32ByKey(&config_table, "missing", &uint));
+    EXPECT_EQ(-1, config_getIdxFromKey(&config_table, "other"));
+    // Accesses by index do not look up keys
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByIdx(&config_table, 0, &uint));
+    EXPECT_EQ(3u, counter(CFG_STAT_LOOKUPS));
+    EXPECT_EQ(2u, counter(CFG_STAT_LOOKUP_MISSES));
+}
+
+TEST_F(Config_Stats_Test, TypeMismatchTest) {
+    float f = 0;
+    uint32_t uint = 0;
+    ConfigHandle_t handle;
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getFloatByKey(&config_table, "uint", &f));
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getUint32ByIdx(&config_table, 1, &uint));
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getHandle(&config_table, "str", CONFIG_UINT32, &handle));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getFloatByKey(&config_table, "float", &f));
+    EXPECT_EQ(3u, counter(CFG_STAT_TYPE_MISMATCHES));
+}
+
+TEST_F(Config_Stats_Test, SetsTest) {
+    const uint32_t value = 5;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "uint", &value, sizeof(value)));
+    // Writing the current value again is still a write
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &value, sizeof(value)));
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, config_setByKey(&config_table, "ro", &value, sizeof(value)));
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_setByIdx(&config_table, 2, "a string too long for it", 25));
+    EXPECT_EQ(2u, counter(CFG_STAT_SETS));
+    EXPECT_EQ(1u, counter(CFG_STAT_READ_ONLY_REJECTIONS));
+}
+
+TEST_F(Config_Stats_Test, ParseErrorsTest) {
+    char buf[] = "uint:7\nfloat:abc\nno separator\nmissing:1\n\nstr:ok\n";
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_parseBuffer(&config_table, buf, strlen(buf), nullptr, nullptr));
+    EXPECT_EQ(7u, _uint);
+    EXPECT_STREQ("ok", _str);
+    EXPECT_EQ(3u, counter(CFG_STAT_PARSE_ERRORS));
+
+    char kv[] = "no separator";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&config_table, kv, sizeof(kv)));
+    EXPECT_EQ(4u, counter(CFG_STAT_PARSE_ERRORS));
+
+    // Lines of the streaming parser
+    uint8_t stream_buf[32];
+    ConfigStream_t stream = {};
+    stream.buffer = stream_buf;
+    stream.buffer_size = sizeof(stream_buf);
+    const char data[] = "uint:8\nfloat:x\n";
+    ASSERT_EQ(CFG_RC_SUCCESS, config_streamBegin(&stream, &config_table));
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_streamFeed(&stream, data, strlen(data)));
+    EXPECT_EQ(5u, counter(CFG_STAT_PARSE_ERRORS));
+    EXPECT_EQ(strlen(data), counter(CFG_STAT_BYTES_READ));
+}
+
+TEST_F(Config_Stats_Test, FileBytesTest) {
+    const char* filename = "stats_test.txt";
+    // Without the read-only entry, which could not be loaded again
+    config_table.count = 3;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saveToFile(&config_table, filename));
+    const uint64_t written = counter(CFG_STAT_BYTES_WRITTEN);
+    EXPECT_GT(written, 0u);
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    EXPECT_EQ(written, counter(CFG_STAT_BYTES_READ));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_loadFromFileBuffered(&config_table, filename, nullptr, nullptr));
+    EXPECT_EQ(2 * written, counter(CFG_STAT_BYTES_READ));
+    remove(filename);
+
+    ConfigStats_t copy;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_statsRead(&config_table, &copy));
+    EXPECT_EQ(1u, copy.histograms[CFG_STAT_SAVE].count);
+    EXPECT_EQ(1u, copy.histograms[CFG_STAT_LOAD].count);
+    // The buffered load parses the file with config_parseBuffer
+    EXPECT_EQ(1u, copy.histograms[CFG_STAT_PARSE].count);
+}
+
+TEST_F(Config_Stats_Test, HistogramTest) {
+    config_setSaveLoadFunctions(nullptr, slowLoadFunc);
+    const uint64_t durations[] = {0, 1, 3, 100, 100, 5000};
+    for(const uint64_t duration : durations) {
+        fake_load_duration = duration;
+        EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, "unused"));
+    }
+    config_setSaveLoadFunctions(nullptr, nullptr);
+
+    ConfigStats_t copy;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_statsRead(&config_table, &copy));
+    const ConfigHistogram_t* h = &copy.histograms[CFG_STAT_LOAD];
+    EXPECT_EQ(6u, h->count);
+    EXPECT_EQ(5204u, h->total_us);
+    EXPECT_EQ(5000u, h->max_us);
+    EXPECT_EQ(1u, h->buckets[0]);
+    EXPECT_EQ(1u, h->buckets[1]);
+    EXPECT_EQ(1u, h->buckets[2]);
+    EXPECT_EQ(2u, h->buckets[7]);
+    EXPECT_EQ(1u, h->buckets[13]);
+
+    EXPECT_EQ(0u, config_histogramPercentile(h, 0));
+    EXPECT_EQ(3u, config_histogramPercentile(h, 50));
+    EXPECT_EQ(127u, config_histogramPercentile(h, 80));
+    // The upper bound of the last bucket is limited to the maximum
+    EXPECT_EQ(5000u, config_histogramPercentile(h, 99));
+    EXPECT_EQ(5000u, config_histogramPercentile(h, 100));
+    EXPECT_EQ(0u, config_histogramPercentile(nullptr, 50));
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_statsReset(&config_table));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_statsRead(&config_table, &copy));
+    EXPECT_EQ(0u, copy.histograms[CFG_STAT_LOAD].count);
+    EXPECT_EQ(0u, config_histogramPercentile(&copy.histograms[CFG_STAT_LOAD], 50));
+}
+
+TEST_F(Config_Stats_Test, DetachedTest) {
+    config_table.stats = nullptr;
+    uint32_t uint = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint", &uint));
+    EXPECT_EQ(0u, stats.counters[CFG_STAT_LOOKUPS]);
+
+    ConfigStats_t copy;
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_statsRead(&config_table, &copy));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_statsReset(&config_table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_statsRead(nullptr, &copy));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_statsAttach(&config_table, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_statsAttach(nullptr, &stats));
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include "config_notify.h"
+#include "config_stream.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+void recordError(void* ctx, uint32_t line, CfgRet_t error) {
+    static_cast<std::vector<std::pair<uint32_t, CfgRet_t>>*>(ctx)->emplace_back(line, error);
+}
+
+void countBatches(void* ctx, const ConfigTable_t*, const uint32_t*, uint32_t) {
+    (*static_cast<uint32_t*>(ctx))++;
+}
+}  // namespace
+
+class Config_Stream_Test : public testing::Test {
+protected:
+    uint32_t _baud_rate = 115200;
+    int32_t _offset = -42;
+    float _gain = 1.5f;
+    char _ssid[16] = "home";
+    bool _enabled = true;
+    float _gains[3] = {0.5f, 1.0f, 1.5f};
+    double _ratio = 0.25;
+    uint32_t _read_only = 7;
+
+    ConfigEntry_t config_entries[8] = {
+        {"uart.baud_rate", CONFIG_UINT32, &_baud_rate, sizeof(_baud_rate)},
+        {"offset", CONFIG_INT32, &_offset, sizeof(_offset)},
+        {"gain", CONFIG_FLOAT, &_gain, sizeof(_gain)},
+        {"wifi.ssid", CONFIG_STRING, &_ssid, sizeof(_ssid)},
+        {"enabled", CONFIG_BOOL, &_enabled, sizeof(_enabled)},
+        {"cal.gains", CONFIG_FLOAT_ARRAY, &_gains, sizeof(_gains)},
+        {"ratio", CONFIG_DOUBLE, &_ratio, sizeof(_ratio)},
+        {"read_only", CONFIG_UINT32, &_read_only, sizeof(_read_only), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    std::vector<std::pair<uint32_t, CfgRet_t>> errors;
+    uint8_t buffer[sizeof(_ssid) + 1];
+    ConfigStream_t stream = {
+        .buffer = buffer,
+        .buffer_size = sizeof(buffer),
+        .on_error = recordError,
+        .error_ctx = &errors,
+    };
+
+    // Feeds text in chunks of the given size and ends the stream
+    CfgRet_t feedChunked(const std::string& text, size_t chunk_size) {
+        EXPECT_EQ(CFG_RC_SUCCESS, config_streamBegin(&stream, &config_table));
+        for(size_t pos = 0; pos < text.size(); pos += chunk_size) {
+            const size_t len = std::min(chunk_size, text.size() - pos);
+            config_streamFeed(&stream, text.data() + pos, static_cast<uint32_t>(len));
+        }
+        return config_streamEnd(&stream);
+    }
+
+    std::vector<uint8_t> saveValues() const {
+        std::vector<uint8_t> values;
+        for(const ConfigEntry_t& entry : config_entries) {
+            const uint8_t* value = static_cast<const uint8_t*>(entry.value);
+            values.insert(values.end(), value, value + entry.size);
+        }
+        return values;
+    }
+
+    void restoreValues(const std::vector<uint8_t>& values) {
+        size_t offset = 0;
+        for(const ConfigEntry_t& entry : config_entries) {
+            std::memcpy(entry.value, values.data() + offset, entry.size);
+            offset += entry.size;
+        }
+    }
+};
+
+TEST_F(Config_Stream_Test, BufferSizeTest) {
+    // The string entry needs its size and one delimiter more than its content
+    EXPECT_EQ(sizeof(_ssid) + 1, config_streamBufferSize(&config_table));
+    EXPECT_EQ(0, config_streamBufferSize(nullptr));
+
+    ConfigStream_t no_buffer = {};
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_streamBegin(&no_buffer, &config_table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_streamBegin(&stream, nullptr));
+    // Not started
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_streamFeed(&stream, "a", 1));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_streamEnd(&stream));
+}
+
+TEST_F(Config_Stream_Test, ChunkBoundaryTest) {
+    const std::string text =
+        "uart.baud_rate: 9600\n"
+        "  offset :-7\r\n"
+        "\n"
+        "gain: 2.25e1\n"
+        "wifi.ssid: \"my net\"  \n"
+        "enabled: false\n"
+        "cal.gains: 1, 2.5 ,-3\n"
+        "ratio: 0.1";
+    // Every chunk size splits the lines at different positions
+    for(size_t chunk_size = 1; chunk_size <= text.size(); chunk_size++) {
+        _baud_rate = 0;
+        _offset = 0;
+        _gain = 0.0f;
+        strcpy(_ssid, "home");
+        _enabled = true;
+        _ratio = 0.0;
+        ASSERT_EQ(CFG_RC_SUCCESS, feedChunked(text, chunk_size)) << "chunk size " << chunk_size;
+        EXPECT_EQ(9600, _baud_rate);
+        EXPECT_EQ(-7, _offset);
+        EXPECT_EQ(22.5f, _gain);
+        EXPECT_STREQ("my net", _ssid);
+        EXPECT_FALSE(_enabled);
+        EXPECT_EQ(1.0f, _gains[0]);
+        EXPECT_EQ(2.5f, _gains[1]);
+        EXPECT_EQ(-3.0f, _gains[2]);
+        EXPECT_EQ(0.1, _ratio);
+    }
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_F(Config_Stream_Test, MatchesKeyValueParsingTest) {
+    const char* lines[] = {
+        "uart.baud_rate: 9600", "uart.baud_rate: -1", "uart.baud_rate: 0x1F", "uart.baud_rate: 12abc",
+        "uart.baud_rate:", "uart.baud_rate: 1 2", "offset: -2147483649", "gain: 1e39", "gain: 1,5",
+        "wifi.ssid: 0123456789abcde", "wifi.ssid: 0123456789abcdef", "wifi.ssid: \"0123456789abcde\"",
+        "wifi.ssid:   spaced  out  ", "wifi.ssid:", "enabled: T", "enabled: 0", "enabled: x", "enabled:",
+        "cal.gains: 1, 2", "cal.gains: 1, 2, 3, 4", "cal.gains: 1,", "cal.gains: ,1", "cal.gains: 1 2",
+        "cal.gains: 1,,2", "cal.gains:", "cal.gains: 1x, 2", "ratio: 1e-320", "read_only: 1",
+        "unknown: 1", "no separator", "  : 1",
+    };
+    for(const char* line : lines) {
+        const std::vector<uint8_t> initial = saveValues();
+        std::string str(line);
+        const CfgRet_t expected = config_parseKVStr(&config_table, str.data(), static_cast<uint32_t>(str.size() + 1));
+        const std::vector<uint8_t> parsed = saveValues();
+        for(size_t chunk_size : {1, 3, 64}) {
+            restoreValues(initial);
+            errors.clear();
+            const CfgRet_t ret = feedChunked(std::string(line) + "\n", chunk_size);
+            if(expected == CFG_RC_SUCCESS) {
+                EXPECT_EQ(CFG_RC_SUCCESS, ret) << line;
+                EXPECT_TRUE(errors.empty()) << line;
+            } else {
+                EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, ret) << line;
+                ASSERT_EQ(1, errors.size()) << line;
+                EXPECT_EQ(1, errors[0].first);
+                EXPECT_EQ(expected, errors[0].second) << line;
+            }
+            EXPECT_EQ(parsed, saveValues()) << line;
+        }
+    }
+}
+
+TEST_F(Config_Stream_Test, LongLineTest) {
+    // Whitespace is not stored, so the length of a line is not limited by the buffer
+    const std::string padding(10000, ' ');
+    std::string text = "wifi.ssid:" + padding + "\"long line\"" + padding + "\n";
+    text += "uart.baud_rate:" + padding + "57600" + padding + "\n";
+    text += "cal.gains:" + padding + "4," + padding + "5" + padding + "\n";
+    // Lines with unknown keys are skipped as a whole
+    text += "unknown." + std::string(10000, 'x') + ": " + std::string(10000, 'y') + "\n";
+    text += "offset: " + std::string(100, '1') + "\n";
+    text += "enabled: false" + std::string(10000, 'z') + "\n";
+    ASSERT_EQ(CFG_RC_ERROR_INCOMPLETE, feedChunked(text, 17));
+    EXPECT_STREQ("long line", _ssid);
+    EXPECT_EQ(57600, _baud_rate);
+    EXPECT_EQ(4.0f, _gains[0]);
+    EXPECT_EQ(5.0f, _gains[1]);
+    EXPECT_EQ(0.0f, _gains[2]);
+    EXPECT_FALSE(_enabled);
+    ASSERT_EQ(2, errors.size());
+    EXPECT_EQ(4, errors[0].first);
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, errors[0].second);
+    EXPECT_EQ(5, errors[1].first);
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, errors[1].second);
+    EXPECT_EQ(-42, _offset);
+
+    // A value larger than the buffer is rejected without touching the entry
+    uint8_t small_buffer[4];
+    stream.buffer = small_buffer;
+    stream.buffer_size = sizeof(small_buffer);
+    errors.clear();
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, feedChunked("wifi.ssid: abc\nuart.baud_rate: 1\n", 5));
+    EXPECT_STREQ("long line", _ssid);
+    EXPECT_EQ(1, _baud_rate);
+    ASSERT_EQ(1, errors.size());
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, errors[0].second);
+}
+
+TEST_F(Config_Stream_Test, ChunkResultTest) {
+    ASSERT_EQ(CFG_RC_SUCCESS, config_streamBegin(&stream, &config_table));
+    // The line is not complete yet, so nothing is applied or reported
+    EXPECT_EQ(CFG_RC_SUCCESS, config_streamFeed(&stream, "uart.baud_rate: 12", 18));
+    EXPECT_EQ(115200, _baud_rate);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_streamFeed(&stream, "34\nfoo", 6));
+    EXPECT_EQ(1234, _baud_rate);
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_streamFeed(&stream, ": 1\nread_only: 3\n", 17));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_streamFeed(&stream, "offset: 5", 9));
+    EXPECT_EQ(-42, _offset);
+    // The last line has no line ending
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_streamEnd(&stream));
+    EXPECT_EQ(5, _offset);
+    EXPECT_EQ(7, _read_only);
+    ASSERT_EQ(2, errors.size());
+    EXPECT_EQ(2, errors[0].first);
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, errors[0].second);
+    EXPECT_EQ(3, errors[1].first);
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, errors[1].second);
+    EXPECT_EQ(2, stream.error_count);
+}
+
+TEST_F(Config_Stream_Test, KeyLengthTest) {
+    const std::string key(CFG_STREAM_KEY_LEN, 'k');
+    bool long_key_value = false;
+    ConfigEntry_t entries[1] = {{key.c_str(), CONFIG_BOOL, &long_key_value, sizeof(long_key_value)}};
+    ConfigTable_t table = {.entries = entries, .count = 1};
+    ASSERT_EQ(CFG_RC_SUCCESS, config_streamBegin(&stream, &table));
+    // Trailing whitespace does not count towards the key length
+    const std::string text = key + "    : 1\n" + key + "k: 1\n";
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_streamFeed(&stream, text.data(), static_cast<uint32_t>(text.size())));
+    EXPECT_TRUE(long_key_value);
+    ASSERT_EQ(1, errors.size());
+    EXPECT_EQ(2, errors[0].first);
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, errors[0].second);
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_streamEnd(&stream));
+
+    // A table with a key which does not fit into the key storage is rejected
+    const std::string too_long_key(CFG_STREAM_KEY_LEN + 1, 'k');
+    entries[0].key = too_long_key.c_str();
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_streamBegin(&stream, &table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_streamFeed(&stream, "a", 1));
+}
+
+TEST_F(Config_Stream_Test, NotificationBatchTest) {
+    uint32_t pending[CFG_DIRTY_WORD_COUNT(std::size(config_entries))];
+    uint32_t changed[std::size(config_entries)];
+    uint32_t matched[std::size(config_entries)];
+    ConfigSubscription_t subscriptions[1];
+    ConfigNotifier_t notifier = {
+        .pending = pending,
+        .changed = changed,
+        .matched = matched,
+        .subscriptions = subscriptions,
+        .subscription_capacity = 1,
+        .inline_dispatch = true,
+    };
+    ASSERT_EQ(CFG_RC_SUCCESS, config_notifyAttach(&config_table, &notifier));
+    uint32_t batches = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, countBatches, &batches));
+    // All lines completed by one chunk are delivered together
+    EXPECT_EQ(CFG_RC_SUCCESS, feedChunked("uart.baud_rate: 1\noffset: 2\ngain: 3\n", 1000));
+    EXPECT_EQ(1, batches);
+}
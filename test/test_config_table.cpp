@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "config_table.h"
 
+#include <map>
+
 #define UINT32_T_DEFAULT_VALUE (115200)
 #define INT32_T_DEFAULT_VALUE (-42)
 #define FLOAT_DEFAULT_VALUE (1.5f)
@@ -52,6 +54,95 @@ TEST_F(Config_Table_Test, KeyToIndexResolutionTest) {
     EXPECT_EQ(resolved_idx, known_string_index);
 }
 
+TEST_F(Config_Table_Test, IndexedKeyLookupTest) {
+    ConfigIndexSlot_t slots[CFG_INDEX_SLOT_COUNT(sizeof(config_entries) / sizeof(config_entries[0]))];
+    ConfigIndex_t index = {.slots = slots, .slot_count = static_cast<uint32_t>(std::size(slots))};
+
+    // Too few slots must be rejected
+    ConfigIndex_t small_index = {.slots = slots, .slot_count = config_table.count};
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_buildIndex(&config_table, &small_index));
+    EXPECT_EQ(nullptr, config_table.index);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_buildIndex(&config_table, nullptr));
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_buildIndex(&config_table, &index));
+    EXPECT_EQ(&index, config_table.index);
+    // Every key has to resolve to the same index as with the linear search
+    for(uint32_t i = 0; i < config_table.count; i++) {
+        EXPECT_EQ(i, config_getIdxFromKey(&config_table, config_entries[i].key));
+    }
+    EXPECT_EQ(-1, config_getIdxFromKey(&config_table, "invalid"));
+    // Prefixes of valid keys must not match
+    EXPECT_EQ(-1, config_getIdxFromKey(&config_table, "uint32"));
+
+    // Key based access and parsing use the index
+    uint32_t uint = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint32_t", &uint));
+    EXPECT_EQ(UINT32_T_DEFAULT_VALUE, uint);
+    char uint_str[] = " uint32_t : 9600";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, uint_str, sizeof(uint_str)));
+    EXPECT_EQ(9600, _uint32_config_entry);
+    char unknown_str[] = "uint32: 1";
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_parseKVStr(&config_table, unknown_str, sizeof(unknown_str)));
+
+    // Detaching the index falls back to the linear search
+    config_table.index = nullptr;
+    EXPECT_EQ(config_getIdxFromKey(&config_table, "bool"), 4);
+}
+
+TEST_F(Config_Table_Test, SortedTableTest) {
+    uint32_t a = 1, ab = 2, b = 3, c = 4;
+    ConfigEntry_t local_config_entries[4] = {
+        {"cfg.c", CONFIG_UINT32, &c, sizeof(c)},
+        {"cfg.ab", CONFIG_UINT32, &ab, sizeof(ab)},
+        {"cfg.b", CONFIG_UINT32, &b, sizeof(b)},
+        {"cfg.a", CONFIG_UINT32, &a, sizeof(a)},
+    };
+    ConfigTable_t local_table = {
+        .entries = local_config_entries,
+        .count = static_cast<uint32_t>(std::size(local_config_entries))
+    };
+    ConfigHandle_t handle{};
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&local_table, "cfg.c", CONFIG_UINT32, &handle));
+
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_sortTable(nullptr));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&local_table));
+    EXPECT_TRUE(local_table.sorted);
+    for(uint32_t i = 1; i < local_table.count; i++) {
+        EXPECT_LT(strcmp(local_config_entries[i - 1].key, local_config_entries[i].key), 0);
+    }
+    // Entries have moved, so old handles must be stale
+    uint32_t value = 0;
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_getUint32ByHandle(&local_table, handle, &value));
+
+    // Binary search lookups
+    EXPECT_EQ(0, config_getIdxFromKey(&local_table, "cfg.a"));
+    EXPECT_EQ(1, config_getIdxFromKey(&local_table, "cfg.ab"));
+    EXPECT_EQ(3, config_getIdxFromKey(&local_table, "cfg.c"));
+    EXPECT_EQ(-1, config_getIdxFromKey(&local_table, "cfg."));
+    EXPECT_EQ(-1, config_getIdxFromKey(&local_table, "cfg.abc"));
+    EXPECT_EQ(-1, config_getIdxFromKey(&local_table, "cfg.d"));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&local_table, "cfg.b", &value));
+    EXPECT_EQ(3, value);
+
+    // Parsing must only match the full key, not an entry whose key starts with the parsed key
+    char prefix_str[] = "cfg.a: 10";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, prefix_str, sizeof(prefix_str)));
+    EXPECT_EQ(10, a);
+    EXPECT_EQ(2, ab);
+    char longer_str[] = "cfg.abc: 10";
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_parseKVStr(&local_table, longer_str, sizeof(longer_str)));
+
+    // Sorting an already sorted table does not move entries
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&local_table, "cfg.c", CONFIG_UINT32, &handle));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_sortTable(&local_table));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByHandle(&local_table, handle, &value));
+
+    // Duplicate keys are reported
+    local_config_entries[2].key = "cfg.a";
+    EXPECT_EQ(CFG_RC_ERROR_DUPLICATE_KEY, config_sortTable(&local_table));
+    EXPECT_FALSE(local_table.sorted);
+}
+
 TEST_F(Config_Table_Test, GenericGetterTest) {
     // Begin by testing valid keys
     ConfigEntry_t uint_entry{};
@@ -167,6 +258,106 @@ TEST_F(Config_Table_Test, SpecializedGetterTest) {
     EXPECT_EQ(b, BOOL_DEFAULT_VALUE);
 }
 
+TEST_F(Config_Table_Test, HandleTest) {
+    ConfigHandle_t uint_handle{};
+    ConfigHandle_t string_handle{};
+    ConfigHandle_t invalid_handle{};
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_getHandle(&config_table, "invalid", CONFIG_UINT32, &invalid_handle));
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getHandle(&config_table, "uint32_t", CONFIG_INT32, &invalid_handle));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_getHandle(&config_table, "uint32_t", CONFIG_UINT32, nullptr));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&config_table, "uint32_t", CONFIG_UINT32, &uint_handle));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&config_table, "string", CONFIG_STRING, &string_handle));
+
+    uint32_t uint = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByHandle(&config_table, uint_handle, &uint));
+    EXPECT_EQ(UINT32_T_DEFAULT_VALUE, uint);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setUint32ByHandle(&config_table, uint_handle, 9600));
+    EXPECT_EQ(9600, _uint32_config_entry);
+    // Accessors of the wrong type are rejected
+    int32_t integer = 0;
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getInt32ByHandle(&config_table, uint_handle, &integer));
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_setInt32ByHandle(&config_table, uint_handle, -1));
+    // A zero initialized handle is never valid
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getUint32ByHandle(&config_table, ConfigHandle_t{}, &uint));
+
+    char str[MAX_STRING_LEN] = "";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getStringByHandle(&config_table, string_handle, str, sizeof(str)));
+    EXPECT_STREQ(STRING_DEFAULT_VALUE, str);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setStringByHandle(&config_table, string_handle, "abc"));
+    EXPECT_STREQ("abc", _string_config_entry);
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_setStringByHandle(&config_table, string_handle, "This string is too long"));
+    char undersized_str[2] = "";
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_getStringByHandle(&config_table, string_handle, undersized_str, sizeof(undersized_str)));
+
+    // Read-only entries stay protected
+    config_entries[4].perm = CFG_PERM_RO;
+    ConfigHandle_t bool_handle{};
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&config_table, "bool", CONFIG_BOOL, &bool_handle));
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, config_setBoolByHandle(&config_table, bool_handle, false));
+    EXPECT_EQ(BOOL_DEFAULT_VALUE, _bool_config_entry);
+
+    // Handles become stale once the table generation changes
+    config_invalidateHandles(&config_table);
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_getUint32ByHandle(&config_table, uint_handle, &uint));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_setUint32ByHandle(&config_table, uint_handle, 1));
+    EXPECT_EQ(9600, _uint32_config_entry);
+}
+
+TEST_F(Config_Table_Test, BatchAccessTest) {
+    ConfigHandle_t handles[3];
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandleByIdx(&config_table, 0, CONFIG_UINT32, &handles[0]));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandleByIdx(&config_table, 3, CONFIG_STRING, &handles[1]));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&config_table, "bool", CONFIG_BOOL, &handles[2]));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_getHandleByIdx(&config_table, 5, CONFIG_UINT32, &handles[0]));
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getHandleByIdx(&config_table, 0, CONFIG_INT32, &handles[0]));
+
+    uint32_t uint = 0;
+    char str[MAX_STRING_LEN] = "";
+    bool boolean = false;
+    ConfigBatchItem_t items[3] = {
+        {handles[0], &uint, sizeof(uint)},
+        {handles[1], str, sizeof(str)},
+        {handles[2], &boolean, sizeof(boolean)},
+    };
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getBatch(&config_table, items, 3));
+    EXPECT_EQ(UINT32_T_DEFAULT_VALUE, uint);
+    EXPECT_STREQ(STRING_DEFAULT_VALUE, str);
+    EXPECT_EQ(BOOL_DEFAULT_VALUE, boolean);
+    for(const auto& item : items) EXPECT_EQ(CFG_RC_SUCCESS, item.result);
+
+    uint = 9600;
+    strcpy(str, "abc");
+    boolean = !BOOL_DEFAULT_VALUE;
+    items[1].size = sizeof("abc");
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setBatch(&config_table, items, 3));
+    EXPECT_EQ(9600, _uint32_config_entry);
+    EXPECT_STREQ("abc", _string_config_entry);
+    EXPECT_EQ(!BOOL_DEFAULT_VALUE, _bool_config_entry);
+
+    // Failing items do not stop the others
+    config_entries[4].perm = CFG_PERM_RO;
+    uint = 1;
+    boolean = BOOL_DEFAULT_VALUE;
+    items[1].value = nullptr;
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_setBatch(&config_table, items, 3));
+    EXPECT_EQ(CFG_RC_SUCCESS, items[0].result);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, items[1].result);
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, items[2].result);
+    EXPECT_EQ(1, _uint32_config_entry);
+
+    char undersized_str[2] = "";
+    items[1] = {handles[1], undersized_str, sizeof(undersized_str)};
+    items[2].size = 0;
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_getBatch(&config_table, items, 3));
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, items[1].result);
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, items[2].result);
+
+    config_invalidateHandles(&config_table);
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_getBatch(&config_table, items, 1));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, items[0].result);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_getBatch(&config_table, nullptr, 1));
+}
+
 TEST_F(Config_Table_Test, KeyValueParsingTest) {
     // Test rejection of unknown keys
     char invalid_key_str[] = "foo: bar";
@@ -188,20 +379,48 @@ TEST_F(Config_Table_Test, KeyValueParsingTest) {
     EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint32_t", &parsed_uint));
     EXPECT_EQ(parsed_uint, 42);
     char invalid_uint_str[] = "uint32_t: -1";
-    EXPECT_EQ(CFG_RC_ERROR, config_parseKVStr(&config_table, invalid_uint_str, sizeof(invalid_uint_str)));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&config_table, invalid_uint_str, sizeof(invalid_uint_str)));
+    char oversized_uint_str[] = "uint32_t: 4294967296";
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&config_table, oversized_uint_str, sizeof(oversized_uint_str)));
+    char hex_uint_str[] = "uint32_t: 0xFFFFFFFF";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, hex_uint_str, sizeof(hex_uint_str)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint32_t", &parsed_uint));
+    EXPECT_EQ(parsed_uint, UINT32_MAX);
+    char binary_uint_str[] = "uint32_t: 0b1010";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, binary_uint_str, sizeof(binary_uint_str)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint32_t", &parsed_uint));
+    EXPECT_EQ(parsed_uint, 10);
+    // Malformed numbers leave the value unchanged
+    char trailing_uint_str[] = "uint32_t: 12abc";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&config_table, trailing_uint_str, sizeof(trailing_uint_str)));
+    char empty_uint_str[] = "uint32_t:";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&config_table, empty_uint_str, sizeof(empty_uint_str)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint32ByKey(&config_table, "uint32_t", &parsed_uint));
+    EXPECT_EQ(parsed_uint, 10);
     // int
     char valid_int_str[] = "int32_t: -50";
     EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, valid_int_str, sizeof(valid_int_str)));
     int32_t parsed_int = 0;
     EXPECT_EQ(CFG_RC_SUCCESS, config_getInt32ByKey(&config_table, "int32_t", &parsed_int));
+    EXPECT_EQ(parsed_int, -50);
     char invalid_int_str[] = "int32_t: 4294967295"; // out of range
-    EXPECT_EQ(CFG_RC_ERROR, config_parseKVStr(&config_table, invalid_int_str, sizeof(invalid_int_str)));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&config_table, invalid_int_str, sizeof(invalid_int_str)));
+    char min_int_str[] = "int32_t: -2147483648";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, min_int_str, sizeof(min_int_str)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getInt32ByKey(&config_table, "int32_t", &parsed_int));
+    EXPECT_EQ(parsed_int, INT32_MIN);
+    char below_min_int_str[] = "int32_t: -2147483649";
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&config_table, below_min_int_str, sizeof(below_min_int_str)));
     // float
     char valid_float_str[] = "float: 1.5";
     EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, valid_float_str, sizeof(valid_float_str)));
     float parsed_float = 0;
     EXPECT_EQ(CFG_RC_SUCCESS, config_getFloatByKey(&config_table, "float", &parsed_float));
     EXPECT_NEAR(parsed_float, 1.5, FLT_EPSILON);
+    char oversized_float_str[] = "float: 1e39";
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&config_table, oversized_float_str, sizeof(oversized_float_str)));
+    char invalid_float_str[] = "float: 1,5";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&config_table, invalid_float_str, sizeof(invalid_float_str)));
     // string
     char valid_str_1[] = "string: valid string";
     EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, valid_str_1, sizeof(valid_str_1)));
@@ -264,6 +483,124 @@ TEST_F(Config_Table_Test, KeyValueParsingTest) {
     parsed_bool = true;
 }
 
+TEST_F(Config_Table_Test, WideNumericTypeTest) {
+    uint64_t uint64 = 0;
+    int64_t int64 = 0;
+    double dbl = 0;
+    ConfigEntry_t local_entries[3] = {
+        {"uint64", CONFIG_UINT64, &uint64, sizeof(uint64)},
+        {"int64", CONFIG_INT64, &int64, sizeof(int64)},
+        {"double", CONFIG_DOUBLE, &dbl, sizeof(dbl)},
+    };
+    ConfigTable_t local_table = {.entries = local_entries, .count = static_cast<uint32_t>(std::size(local_entries))};
+
+    char uint64_str[] = "uint64: 18446744073709551615";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, uint64_str, sizeof(uint64_str)));
+    EXPECT_EQ(UINT64_MAX, uint64);
+    char negative_uint64_str[] = "uint64: -1";
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&local_table, negative_uint64_str, sizeof(negative_uint64_str)));
+    char int64_str[] = "int64: -9223372036854775808";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, int64_str, sizeof(int64_str)));
+    EXPECT_EQ(INT64_MIN, int64);
+    char invalid_int64_str[] = "int64: 9223372036854775808";
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_parseKVStr(&local_table, invalid_int64_str, sizeof(invalid_int64_str)));
+    char double_str[] = "double: 0.30000000000000004";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, double_str, sizeof(double_str)));
+    EXPECT_EQ(0.1 + 0.2, dbl);
+
+    // Typed getters check the type
+    uint64_t uint64_value = 0;
+    int64_t int64_value = 0;
+    double double_value = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getUint64ByKey(&local_table, "uint64", &uint64_value));
+    EXPECT_EQ(UINT64_MAX, uint64_value);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getInt64ByIdx(&local_table, 1, &int64_value));
+    EXPECT_EQ(INT64_MIN, int64_value);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getDoubleByKey(&local_table, "double", &double_value));
+    EXPECT_EQ(0.1 + 0.2, double_value);
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getDoubleByKey(&local_table, "int64", &double_value));
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_getUint64ByKey(&config_table, "uint32_t", &uint64_value));
+
+    ConfigHandle_t handle;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&local_table, "double", CONFIG_DOUBLE, &handle));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setDoubleByHandle(&local_table, handle, -2.5));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getDoubleByHandle(&local_table, handle, &double_value));
+    EXPECT_EQ(-2.5, double_value);
+    EXPECT_EQ(CFG_RC_ERROR_TYPE_MISMATCH, config_setInt64ByHandle(&local_table, handle, 1));
+
+    // All values are formatted exactly
+    char buf[256];
+    uint32_t len = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_formatTable(&local_table, buf, sizeof(buf), &len));
+    EXPECT_EQ("uint64: 18446744073709551615\nint64: -9223372036854775808\ndouble: -2.5\n", std::string(buf, len));
+}
+
+TEST_F(Config_Table_Test, ArrayTypeTest) {
+    float gains[4] = {0.5f, 1.0f, 1.5f, 2.0f};
+    int32_t offsets[3] = {};
+    double coefficients[2] = {};
+    ConfigEntry_t local_entries[3] = {
+        {"gains", CONFIG_FLOAT_ARRAY, gains, sizeof(gains)},
+        {"offsets", CONFIG_INT32_ARRAY, offsets, sizeof(offsets)},
+        {"coefficients", CONFIG_DOUBLE_ARRAY, coefficients, sizeof(coefficients)},
+    };
+    ConfigTable_t local_table = {.entries = local_entries, .count = static_cast<uint32_t>(std::size(local_entries))};
+    EXPECT_EQ(4, config_getArrayLength(&local_table, 0));
+    EXPECT_EQ(3, config_getArrayLength(&local_table, 1));
+    EXPECT_EQ(0, config_getArrayLength(&config_table, 0));
+
+    char offsets_str[] = "offsets: -1,2 , 3";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, offsets_str, sizeof(offsets_str)));
+    EXPECT_EQ(-1, offsets[0]);
+    EXPECT_EQ(2, offsets[1]);
+    EXPECT_EQ(3, offsets[2]);
+
+    // Missing trailing elements are set to 0
+    char short_str[] = "offsets: 7";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, short_str, sizeof(short_str)));
+    EXPECT_EQ(7, offsets[0]);
+    EXPECT_EQ(0, offsets[1]);
+    EXPECT_EQ(0, offsets[2]);
+
+    // Invalid arrays leave the entry unchanged
+    char long_str[] = "offsets: 1, 2, 3, 4";
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_parseKVStr(&local_table, long_str, sizeof(long_str)));
+    char trailing_comma_str[] = "offsets: 1, 2,";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&local_table, trailing_comma_str, sizeof(trailing_comma_str)));
+    char missing_element_str[] = "offsets: 1,,2";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&local_table, missing_element_str, sizeof(missing_element_str)));
+    char garbage_str[] = "offsets: 1 2";
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, config_parseKVStr(&local_table, garbage_str, sizeof(garbage_str)));
+    EXPECT_EQ(7, offsets[0]);
+
+    char coefficients_str[] = "coefficients: 0.1, -1e300";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&local_table, coefficients_str, sizeof(coefficients_str)));
+    EXPECT_EQ(0.1, coefficients[0]);
+    EXPECT_EQ(-1e300, coefficients[1]);
+
+    char buf[256];
+    uint32_t len = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_formatTable(&local_table, buf, sizeof(buf), &len));
+    EXPECT_EQ("gains: 0.5, 1, 1.5, 2\noffsets: 7, 0, 0\ncoefficients: 0.1, -1e300\n", std::string(buf, len));
+
+    // Saved arrays load back and dirty arrays are patched in place
+    constexpr char filename[] = "test_arrays.txt";
+    remove(filename);
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saveToFile(&local_table, filename));
+    memset(gains, 0, sizeof(gains));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&local_table, filename));
+    EXPECT_EQ(1.5f, gains[2]);
+    uint32_t bitmap[CFG_DIRTY_WORD_COUNT(3)];
+    ASSERT_EQ(CFG_RC_SUCCESS, config_enableDirtyTracking(&local_table, bitmap, std::size(bitmap)));
+    const int32_t new_offsets[3] = {1, 2, 3};
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&local_table, "offsets", new_offsets, sizeof(new_offsets)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&local_table, filename));
+    memset(offsets, 0, sizeof(offsets));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&local_table, filename));
+    EXPECT_EQ(3, offsets[2]);
+    remove(filename);
+}
+
 TEST_F(Config_Table_Test, SaveLoadTest) {
     constexpr char filename[] = "test.txt";
     EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_saveToFile(nullptr, filename));
@@ -314,4 +651,252 @@ TEST_F(Config_Table_Test, SaveLoadTest) {
 
     // Delete file at end of tests
     remove(filename);
-}
\ No newline at end of file
+}
+TEST_F(Config_Table_Test, BufferedLoadTest) {
+    constexpr char filename[] = "test_buffered.txt";
+    char long_string_entry[FILE_MAX_LINE_LEN * 2] = "";
+    uint32_t uint = 0;
+    ConfigEntry_t local_config_entries[2] = {
+        {"long_string", CONFIG_STRING, &long_string_entry, sizeof(long_string_entry)},
+        {"uint32_t", CONFIG_UINT32, &uint, sizeof(uint)},
+    };
+    ConfigTable_t local_table = {
+        .entries = local_config_entries,
+        .count = static_cast<uint32_t>(std::size(local_config_entries))
+    };
+    const std::string long_value(FILE_MAX_LINE_LEN + 10, 'a');
+
+    FILE* file_ptr = fopen(filename, "w");
+    ASSERT_NE(nullptr, file_ptr);
+    fprintf(file_ptr, "long_string: %s\n", long_value.c_str());
+    fprintf(file_ptr, "\n");
+    fprintf(file_ptr, "unknown_key: 1\r\n");
+    fprintf(file_ptr, "missing separator\n");
+    // Last line without a line ending
+    fprintf(file_ptr, "uint32_t: 42");
+    fclose(file_ptr);
+
+    std::vector<std::pair<uint32_t, CfgRet_t>> errors;
+    auto on_error = [](void* ctx, uint32_t line, CfgRet_t error) {
+        static_cast<std::vector<std::pair<uint32_t, CfgRet_t>>*>(ctx)->emplace_back(line, error);
+    };
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_loadFromFileBuffered(&local_table, filename, on_error, &errors));
+    EXPECT_STREQ(long_value.c_str(), long_string_entry);
+    EXPECT_EQ(42, uint);
+    ASSERT_EQ(2, errors.size());
+    EXPECT_EQ(3, errors[0].first);
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, errors[0].second);
+    EXPECT_EQ(4, errors[1].first);
+    EXPECT_EQ(CFG_RC_ERROR_FORMAT, errors[1].second);
+
+    // The default loader must not parse the remainder of an overlong line as a new entry
+    uint = 0;
+    memset(long_string_entry, 0, sizeof(long_string_entry));
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_loadFromFile(&local_table, filename));
+    EXPECT_STREQ("", long_string_entry);
+    EXPECT_EQ(42, uint);
+
+    // A line starting with a NUL character is skipped by the default loader
+    constexpr char nul_filename[] = "test_nul_line.txt";
+    constexpr char nul_line[] = "\0abc\nuint32_t: 7\n";
+    file_ptr = fopen(nul_filename, "wb");
+    ASSERT_NE(nullptr, file_ptr);
+    fwrite(nul_line, 1, sizeof(nul_line) - 1, file_ptr);
+    fclose(file_ptr);
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_loadFromFile(&local_table, nul_filename));
+    EXPECT_EQ(7, uint);
+    remove(nul_filename);
+
+    // The buffered loader can replace the default load function
+    config_setSaveLoadFunctions(nullptr, config_bufferedLoadFunc);
+    EXPECT_EQ(CFG_RC_ERROR_INCOMPLETE, config_loadFromFile(&local_table, filename));
+    EXPECT_STREQ(long_value.c_str(), long_string_entry);
+    config_setSaveLoadFunctions(nullptr, nullptr);
+
+    EXPECT_EQ(CFG_RC_ERROR, config_loadFromFileBuffered(&local_table, "unknown_file.txt", nullptr, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_loadFromFileBuffered(nullptr, filename, nullptr, nullptr));
+    remove(filename);
+}
+
+TEST_F(Config_Table_Test, IoContextTest) {
+    // In-memory backend keeping one text per file name in its context
+    using Storage = std::map<std::string, std::string>;
+    auto save = [](const ConfigTable_t* cfg, const char* filename) {
+        std::string text(config_getFormattedSize(cfg), '\0');
+        uint32_t len = 0;
+        const CfgRet_t ret = config_formatTable(cfg, text.data(), text.size(), &len);
+        text.resize(len);
+        (*static_cast<Storage*>(cfg->io->ctx))[filename] = text;
+        return ret;
+    };
+    auto load = [](ConfigTable_t* cfg, const char* filename) {
+        Storage* storage = static_cast<Storage*>(cfg->io->ctx);
+        if(storage->count(filename) == 0) return CFG_RC_ERROR;
+        std::string text = (*storage)[filename];
+        return config_parseBuffer(cfg, text.data(), text.size(), nullptr, nullptr);
+    };
+    Storage storage;
+    const ConfigIo_t memory_io = {save, load, &storage};
+    config_table.io = &memory_io;
+
+    constexpr char filename[] = "test_io.txt";
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saveToFile(&config_table, filename));
+    ASSERT_EQ(1, storage.count(filename));
+    EXPECT_NE(std::string::npos, storage[filename].find("uint32_t: 115200"));
+    // Nothing was written to the file system
+    EXPECT_EQ(nullptr, fopen(filename, "r"));
+
+    _uint32_config_entry = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    EXPECT_EQ(UINT32_T_DEFAULT_VALUE, _uint32_config_entry);
+    EXPECT_EQ(CFG_RC_ERROR, config_loadFromFile(&config_table, "unknown_file.txt"));
+
+    // The process-wide functions are not used by tables with an io context
+    auto failing_load = [](ConfigTable_t*, const char*) { return CFG_RC_ERROR_INVALID; };
+    config_setSaveLoadFunctions(nullptr, failing_load);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    config_table.io = nullptr;
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_loadFromFile(&config_table, filename));
+    config_setSaveLoadFunctions(nullptr, nullptr);
+
+    // Functions left NULL in the context use the default text format
+    const ConfigIo_t default_io = {};
+    config_table.io = &default_io;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_saveToFile(&config_table, filename));
+    _uint32_config_entry = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    EXPECT_EQ(UINT32_T_DEFAULT_VALUE, _uint32_config_entry);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_loadFromFile(nullptr, filename));
+    remove(filename);
+}
+
+TEST_F(Config_Table_Test, FormatTableTest) {
+    _float_config_entry = 0.1f;
+    const uint32_t size = config_getFormattedSize(&config_table);
+    std::vector<char> buf(size);
+    uint32_t len = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_formatTable(&config_table, buf.data(), size, &len));
+    EXPECT_LE(len, size);
+    EXPECT_EQ("uint32_t: 115200\n"
+              "int32_t: -42\n"
+              "float: 0.1\n"
+              "string: foobar\n"
+              "bool: 1\n",
+              std::string(buf.data(), len));
+
+    // Only complete lines are written to a buffer which is too small
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_formatTable(&config_table, buf.data(), 25, &len));
+    EXPECT_EQ("uint32_t: 115200\n", std::string(buf.data(), len));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_formatTable(&config_table, nullptr, size, &len));
+
+    // Saved floats keep their full precision
+    constexpr char filename[] = "test_format.txt";
+    _float_config_entry = 3.14159274f;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveToFile(&config_table, filename));
+    _float_config_entry = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    EXPECT_EQ(3.14159274f, _float_config_entry);
+    remove(filename);
+}
+
+TEST_F(Config_Table_Test, DirtyTrackingTest) {
+    uint32_t bitmap[CFG_DIRTY_WORD_COUNT(sizeof(config_entries) / sizeof(config_entries[0]))] = {UINT32_MAX};
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_enableDirtyTracking(&config_table, bitmap, 0));
+    EXPECT_EQ(nullptr, config_table.dirty);
+    // Without a bitmap nothing is tracked
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_markDirty(&config_table, 0));
+    EXPECT_FALSE(config_isDirty(&config_table, 0));
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_enableDirtyTracking(&config_table, bitmap, std::size(bitmap)));
+    EXPECT_EQ(0, config_getDirtyCount(&config_table));
+
+    uint32_t uint = 42;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &uint, sizeof(uint)));
+    EXPECT_TRUE(config_isDirty(&config_table, 0));
+    EXPECT_FALSE(config_isDirty(&config_table, 1));
+    char bool_str[] = "bool: 0";
+    EXPECT_EQ(CFG_RC_SUCCESS, config_parseKVStr(&config_table, bool_str, sizeof(bool_str)));
+    EXPECT_TRUE(config_isDirty(&config_table, 4));
+    EXPECT_EQ(2, config_getDirtyCount(&config_table));
+
+    // Writing the stored value again does not mark the entry dirty
+    EXPECT_EQ(CFG_RC_SUCCESS, config_clearDirty(&config_table, 0));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &uint, sizeof(uint)));
+    EXPECT_FALSE(config_isDirty(&config_table, 0));
+    // Neither do failed writes
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_setByKey(&config_table, "string", "0123456789abcdefg", 18));
+    EXPECT_FALSE(config_isDirty(&config_table, 3));
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_markDirty(&config_table, 2));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_markDirty(&config_table, config_table.count));
+    EXPECT_EQ(2, config_getDirtyCount(&config_table));
+    config_clearAllDirty(&config_table);
+    EXPECT_EQ(0, config_getDirtyCount(&config_table));
+
+    // Sorting moves the entries, so all of them are considered dirty
+    EXPECT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    EXPECT_EQ(config_table.count, config_getDirtyCount(&config_table));
+}
+
+TEST_F(Config_Table_Test, SaveDirtyTest) {
+    constexpr char filename[] = "test_save_dirty.txt";
+    remove(filename);
+    uint32_t bitmap[CFG_DIRTY_WORD_COUNT(sizeof(config_entries) / sizeof(config_entries[0]))];
+    ASSERT_EQ(CFG_RC_SUCCESS, config_enableDirtyTracking(&config_table, bitmap, std::size(bitmap)));
+
+    // Nothing dirty, nothing written
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ(nullptr, fopen(filename, "rb"));
+
+    // Without an existing file the whole table is saved
+    EXPECT_EQ(CFG_RC_SUCCESS, config_markDirty(&config_table, 0));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ(0, config_getDirtyCount(&config_table));
+    auto readFile = [&]() {
+        std::string contents;
+        FILE* file_ptr = fopen(filename, "rb");
+        if(file_ptr == nullptr) return contents;
+        char buf[256];
+        size_t read;
+        while((read = fread(buf, 1, sizeof(buf), file_ptr)) > 0) contents.append(buf, read);
+        fclose(file_ptr);
+        return contents;
+    };
+    EXPECT_EQ("uint32_t: 115200\nint32_t: -42\nfloat: 1.5\nstring: foobar\nbool: 1\n", readFile());
+
+    // Shorter values are padded in place
+    uint32_t uint = 7;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &uint, sizeof(uint)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "string", "foo", sizeof("foo")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ(0, config_getDirtyCount(&config_table));
+    EXPECT_EQ("uint32_t: 7     \nint32_t: -42\nfloat: 1.5\nstring: foo   \nbool: 1\n", readFile());
+
+    // Values which fit into the padded line are written in place as well
+    uint = 123456;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 0, &uint, sizeof(uint)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ("uint32_t: 123456\nint32_t: -42\nfloat: 1.5\nstring: foo   \nbool: 1\n", readFile());
+
+    // Longer values require a full rewrite
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "string", "foobarbaz", sizeof("foobarbaz")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ("uint32_t: 123456\nint32_t: -42\nfloat: 1.5\nstring: foobarbaz\nbool: 1\n", readFile());
+
+    // Entries missing from the file are appended, even after a last line without line ending
+    FILE* file_ptr = fopen(filename, "wb");
+    ASSERT_NE(nullptr, file_ptr);
+    fputs("int32_t: -42", file_ptr);
+    fclose(file_ptr);
+    bool boolean = false;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByKey(&config_table, "bool", &boolean, sizeof(boolean)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_saveDirty(&config_table, filename));
+    EXPECT_EQ("int32_t: -42\nbool: 0\n", readFile());
+
+    // The patched file loads back the current values
+    _uint32_config_entry = 0;
+    _bool_config_entry = true;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_loadFromFile(&config_table, filename));
+    EXPECT_FALSE(_bool_config_entry);
+    remove(filename);
+}
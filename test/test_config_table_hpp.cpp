@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "config_table.hpp"
+
+namespace {
+struct TestConfiguration {
+    uint32_t uint = 1;
+    int32_t integer = -1;
+    float f = 0.5f;
+    char str[16] = "foo";
+    bool b = true;
+} test_cfg;
+
+constexpr auto test_schema = cfgtable::makeSchema(
+    CFG_TABLE_ENTRY(test_cfg.uint),
+    CFG_TABLE_ENTRY(test_cfg.integer),
+    CFG_TABLE_ENTRY(test_cfg.f),
+    CFG_TABLE_ENTRY_PERM(test_cfg.str, CFG_PERM_RO),
+    CFG_TABLE_ENTRY(test_cfg.b)
+);
+}  // namespace
+
+TEST(Config_Table_Hpp_Test, SchemaTest) {
+    static_assert(test_schema.size() == 5);
+    static_assert(test_schema.contains("test_cfg.uint"));
+    static_assert(!test_schema.contains("test_cfg"));
+    static_assert(CFG_KEY_IDX(test_schema, "test_cfg.uint") == 0);
+    static_assert(CFG_KEY_IDX_TYPED(test_schema, "test_cfg.b", CONFIG_BOOL) == 4);
+    static_assert(!test_schema.isSorted());
+    static_assert(cfgtable::makeSchema(CFG_TABLE_ENTRY(test_cfg.b), CFG_TABLE_ENTRY(test_cfg.f)).isSorted());
+
+    // Types and sizes are derived from the variables
+    EXPECT_EQ(CONFIG_UINT32, test_schema.entries[0].type);
+    EXPECT_EQ(CONFIG_INT32, test_schema.entries[1].type);
+    EXPECT_EQ(CONFIG_FLOAT, test_schema.entries[2].type);
+    EXPECT_EQ(CONFIG_STRING, test_schema.entries[3].type);
+    EXPECT_EQ(sizeof(test_cfg.str), test_schema.entries[3].size);
+    EXPECT_EQ(CFG_PERM_RO, test_schema.entries[3].perm);
+    EXPECT_EQ(CONFIG_BOOL, test_schema.entries[4].type);
+    EXPECT_EQ(&test_cfg.b, test_schema.entries[4].value);
+    static_assert(cfgtable::detail::TypeOf<uint64_t>::value == CONFIG_UINT64);
+    static_assert(cfgtable::detail::TypeOf<double>::value == CONFIG_DOUBLE);
+    static_assert(cfgtable::detail::TypeOf<float[4]>::value == CONFIG_FLOAT_ARRAY);
+    static_assert(cfgtable::detail::TypeOf<int64_t[2]>::value == CONFIG_INT64_ARRAY);
+}
+
+TEST(Config_Table_Hpp_Test, TableAccessTest) {
+    auto entries = test_schema.entries;
+    ConfigTable_t table = cfgtable::makeTable(entries);
+    EXPECT_EQ(test_schema.size(), table.count);
+    EXPECT_EQ(nullptr, table.index);
+
+    // Compile time indices agree with the runtime lookup
+    constexpr uint32_t int_idx = CFG_KEY_IDX(test_schema, "test_cfg.integer");
+    EXPECT_EQ(static_cast<int32_t>(int_idx), config_getIdxFromKey(&table, "test_cfg.integer"));
+
+    int32_t value = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_getInt32ByIdx(&table, int_idx, &value));
+    EXPECT_EQ(-1, value);
+    value = 42;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&table, int_idx, &value, sizeof(value)));
+    EXPECT_EQ(42, test_cfg.integer);
+
+    constexpr char new_str[] = "bar";
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY,
+              config_setByIdx(&table, CFG_KEY_IDX(test_schema, "test_cfg.str"), new_str, sizeof(new_str)));
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "config_binary.h"
+#include "config_log.h"
+#include "config_table.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static_assert(CFG_THREAD_SAFE, "This test has to be compiled with CFG_THREAD_SAFE=1");
+
+namespace {
+// Values alternated by the writers. A torn read would mix both patterns or their lengths
+const std::string long_str(15, 'A');
+const std::string short_str(3, 'B');
+constexpr uint32_t low_pattern = 0x00000000u;
+constexpr uint32_t high_pattern = 0xFFFFFFFFu;
+constexpr uint32_t writes_per_writer = 20000;
+}  // namespace
+
+class Config_Thread_Safety_Test : public testing::Test {
+protected:
+    char _name[16] = "AAAAAAAAAAAAAAA";
+    uint32_t _pattern = low_pattern;
+
+    ConfigEntry_t config_entries[2] = {
+        {"name", CONFIG_STRING, &_name, sizeof(_name)},
+        {"pattern", CONFIG_UINT32, &_pattern, sizeof(_pattern)},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+};
+
+TEST_F(Config_Thread_Safety_Test, ConcurrentStringReadsTest) {
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> torn_reads{0};
+    ConfigHandle_t handle;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getHandle(&config_table, "name", CONFIG_STRING, &handle));
+
+    std::vector<std::thread> writers;
+    for(int w = 0; w < 2; w++) {
+        writers.emplace_back([&] {
+            for(uint32_t i = 0; i < writes_per_writer; i++) {
+                const std::string& str = (i % 2 == 0) ? short_str : long_str;
+                config_setByIdx(&config_table, 0, str.c_str(), str.size() + 1);
+            }
+        });
+    }
+    std::vector<std::thread> readers;
+    for(int r = 0; r < 2; r++) {
+        readers.emplace_back([&, r] {
+            char str[16];
+            while(!done.load()) {
+                const CfgRet_t ret = (r == 0) ? config_getStringByIdx(&config_table, 0, str, sizeof(str))
+                                              : config_getStringByHandle(&config_table, handle, str, sizeof(str));
+                if(ret != CFG_RC_SUCCESS || (str != long_str && str != short_str)) torn_reads++;
+            }
+        });
+    }
+    for(auto& writer : writers) writer.join();
+    done = true;
+    for(auto& reader : readers) reader.join();
+    EXPECT_EQ(0, torn_reads.load());
+}
+
+TEST_F(Config_Thread_Safety_Test, ConcurrentCopyAndFormatTest) {
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> torn_reads{0};
+
+    std::thread writer([&] {
+        for(uint32_t i = 0; i < writes_per_writer; i++) {
+            const uint32_t value = (i % 2 == 0) ? high_pattern : low_pattern;
+            config_setByIdx(&config_table, 1, &value, sizeof(value));
+        }
+    });
+    std::thread copy_reader([&] {
+        while(!done.load()) {
+            uint32_t value;
+            config_copyValueByIdx(&config_table, 1, &value, sizeof(value));
+            if(value != low_pattern && value != high_pattern) torn_reads++;
+        }
+    });
+    std::thread format_reader([&] {
+        char buf[64];
+        uint32_t len;
+        while(!done.load()) {
+            if(config_formatEntry(&config_table, 1, buf, sizeof(buf), &len) != CFG_RC_SUCCESS) {
+                torn_reads++;
+                continue;
+            }
+            const std::string line(buf, len);
+            if(line != "pattern: 0\n" && line != "pattern: 4294967295\n") torn_reads++;
+        }
+    });
+    writer.join();
+    done = true;
+    copy_reader.join();
+    format_reader.join();
+    EXPECT_EQ(0, torn_reads.load());
+}
+
+TEST_F(Config_Thread_Safety_Test, ConcurrentWritersTest) {
+    std::vector<std::thread> writers;
+    for(int w = 0; w < 4; w++) {
+        writers.emplace_back([&] {
+            for(uint32_t i = 0; i < writes_per_writer; i++) {
+                const std::string& str = (i % 2 == 0) ? short_str : long_str;
+                config_setByIdx(&config_table, 0, str.c_str(), str.size() + 1);
+            }
+        });
+    }
+    for(auto& writer : writers) writer.join();
+    // Writers exclude each other, so the value is one of both strings with the padding cleared
+    char str[16];
+    ASSERT_EQ(CFG_RC_SUCCESS, config_getStringByIdx(&config_table, 0, str, sizeof(str)));
+    EXPECT_TRUE(str == long_str || str == short_str);
+    for(size_t i = strlen(_name); i < sizeof(_name); i++) EXPECT_EQ('\0', _name[i]);
+    // Even sequence number, no write in progress
+    EXPECT_EQ(0u, config_entries[0].seq % 2);
+}
+
+TEST_F(Config_Thread_Safety_Test, BackgroundLogCompactionTest) {
+    constexpr char snapshot_filename[] = "test_thread_log_snapshot.txt";
+    constexpr char log_filename[] = "test_thread_log_changes.txt";
+    constexpr uint32_t write_count = 2000;
+    std::remove(snapshot_filename);
+    std::remove(log_filename);
+    ConfigLog_t log;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 256));
+    std::atomic<uint32_t> requests{0};
+    log.request_compaction = [](void* ctx) { (*static_cast<std::atomic<uint32_t>*>(ctx))++; };
+    log.request_ctx = &requests;
+
+    // The background task compacts while the writer keeps appending to the new log file
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> failed_compactions{0};
+    std::thread compactor([&] {
+        uint32_t handled = 0;
+        while(!done.load() || handled != requests.load()) {
+            if(handled == requests.load()) {
+                std::this_thread::yield();
+                continue;
+            }
+            handled = requests.load();
+            if(config_logCompactPrevious(&config_table) != CFG_RC_SUCCESS) failed_compactions++;
+        }
+    });
+    for(uint32_t i = 1; i <= write_count; i++) {
+        EXPECT_EQ(CFG_RC_SUCCESS, config_setByIdx(&config_table, 1, &i, sizeof(i)));
+    }
+    done = true;
+    compactor.join();
+    EXPECT_GT(requests.load(), 0u);
+    EXPECT_EQ(0u, failed_compactions.load());
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+
+    _pattern = 0;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 256));
+    EXPECT_EQ(write_count, _pattern);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+    std::remove(snapshot_filename);
+    std::remove(log_filename);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "config_tokenizer.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<ConfigKVSpan_t> tokenizeAll(const std::string& str, uint32_t max_spans) {
+    std::vector<ConfigKVSpan_t> result;
+    std::vector<ConfigKVSpan_t> spans(max_spans);
+    ConfigTokenizer_t tokenizer;
+    config_tokenizerInit(&tokenizer, str.data(), static_cast<uint32_t>(str.size()));
+    CfgRet_t ret;
+    do {
+        uint32_t count = 0;
+        ret = config_tokenizerNext(&tokenizer, spans.data(), max_spans, &count);
+        EXPECT_LE(count, max_spans);
+        result.insert(result.end(), spans.begin(), spans.begin() + count);
+    } while(ret == CFG_RC_ERROR_INCOMPLETE);
+    EXPECT_EQ(CFG_RC_SUCCESS, ret);
+    return result;
+}
+
+std::string keyOf(const std::string& str, const ConfigKVSpan_t& span) {
+    return str.substr(span.key_offset, span.key_len);
+}
+
+std::string valueOf(const std::string& str, const ConfigKVSpan_t& span) {
+    return str.substr(span.value_offset, span.value_len);
+}
+}  // namespace
+
+TEST(Config_Tokenizer_Test, SpanTest) {
+    const std::string str =
+        "  first.key :  value one \r\n"
+        "\n"
+        "   \t \n"
+        "url: http://example.com\n"
+        "no separator here\n"
+        "empty:\n"
+        "last: 42";
+    const auto spans = tokenizeAll(str, 16);
+    ASSERT_EQ(5, spans.size());
+
+    EXPECT_EQ("first.key", keyOf(str, spans[0]));
+    EXPECT_EQ("value one", valueOf(str, spans[0]));
+    EXPECT_EQ(1, spans[0].line);
+    EXPECT_TRUE(spans[0].has_separator);
+
+    // Only the first separator splits key and value
+    EXPECT_EQ("url", keyOf(str, spans[1]));
+    EXPECT_EQ("http://example.com", valueOf(str, spans[1]));
+    EXPECT_EQ(4, spans[1].line);
+
+    EXPECT_EQ("no separator here", keyOf(str, spans[2]));
+    EXPECT_FALSE(spans[2].has_separator);
+    EXPECT_EQ(5, spans[2].line);
+
+    EXPECT_EQ("empty", keyOf(str, spans[3]));
+    EXPECT_EQ(0, spans[3].value_len);
+
+    EXPECT_EQ("last", keyOf(str, spans[4]));
+    EXPECT_EQ("42", valueOf(str, spans[4]));
+    EXPECT_EQ(7, spans[4].line);
+}
+
+TEST(Config_Tokenizer_Test, LongLinesAndBatchesTest) {
+    // Lines spanning several SIMD blocks and a span array smaller than the number of lines
+    std::string str;
+    for(int i = 0; i < 100; i++) {
+        str += "cfg.module" + std::to_string(i) + ".setting:" + std::string(i, ' ') + std::string(i * 3, 'x') + "\n";
+    }
+    const auto spans = tokenizeAll(str, 7);
+    ASSERT_EQ(100, spans.size());
+    for(uint32_t i = 0; i < spans.size(); i++) {
+        EXPECT_EQ("cfg.module" + std::to_string(i) + ".setting", keyOf(str, spans[i]));
+        EXPECT_EQ(std::string(i * 3, 'x'), valueOf(str, spans[i]));
+        EXPECT_EQ(i + 1, spans[i].line);
+    }
+
+    ConfigTokenizer_t tokenizer;
+    config_tokenizerInit(&tokenizer, "", 0);
+    ConfigKVSpan_t span;
+    uint32_t count = 1;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_tokenizerNext(&tokenizer, &span, 1, &count));
+    EXPECT_EQ(0, count);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_tokenizerNext(&tokenizer, nullptr, 1, &count));
+
+    // Without space for a span the tokenizer would never advance
+    config_tokenizerInit(&tokenizer, "key: 1\n", 7);
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_tokenizerNext(&tokenizer, &span, 0, &count));
+    EXPECT_EQ(0, count);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "config_trie.h"
+
+#include <string>
+#include <vector>
+
+class Config_Trie_Test : public testing::Test {
+protected:
+    uint32_t _values[10] = {};
+
+    ConfigEntry_t config_entries[10] = {
+        {"cfg.wifi.ssid", CONFIG_UINT32, &_values[0], sizeof(uint32_t)},
+        {"cfg.wifi2.ssid", CONFIG_UINT32, &_values[1], sizeof(uint32_t)},
+        {"cfg.wifi", CONFIG_UINT32, &_values[2], sizeof(uint32_t)},
+        {"cfg.wifi-ap.ssid", CONFIG_UINT32, &_values[3], sizeof(uint32_t)},
+        {"cfg.wifi.password", CONFIG_UINT32, &_values[4], sizeof(uint32_t)},
+        {"cfg.uart.baud_rate", CONFIG_UINT32, &_values[5], sizeof(uint32_t)},
+        {"cfg.wifi.ap.channel", CONFIG_UINT32, &_values[6], sizeof(uint32_t)},
+        {"enabled", CONFIG_UINT32, &_values[7], sizeof(uint32_t)},
+        {"odd..key", CONFIG_UINT32, &_values[8], sizeof(uint32_t)},
+        {"odd.", CONFIG_UINT32, &_values[9], sizeof(uint32_t)},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigTrieNode_t nodes[32];
+    uint32_t order[10];
+    ConfigTrie_t trie = {
+        .nodes = nodes,
+        .node_capacity = static_cast<uint32_t>(std::size(nodes)),
+        .order = order,
+    };
+
+    void SetUp() override {
+        ASSERT_EQ(CFG_RC_SUCCESS, config_trieBuild(&trie, &config_table));
+    }
+
+    std::vector<std::string> prefixKeys(const char* prefix) {
+        const uint32_t* indices = nullptr;
+        uint32_t count = 0;
+        std::vector<std::string> keys;
+        if(config_trieGetPrefix(&trie, prefix, &indices, &count) != CFG_RC_SUCCESS) return keys;
+        for(uint32_t i = 0; i < count; i++) keys.emplace_back(config_entries[indices[i]].key);
+        return keys;
+    }
+};
+
+TEST_F(Config_Trie_Test, NodeCountTest) {
+    EXPECT_EQ(28u, config_trieNodeCount(&config_table));
+    EXPECT_EQ(0u, config_trieNodeCount(nullptr));
+    // Shared segments only need one node
+    EXPECT_LT(trie.node_count, config_trieNodeCount(&config_table));
+
+    ConfigTrie_t small = {nodes, 4, order};
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_trieBuild(&small, &config_table));
+    EXPECT_EQ(-1, config_trieGetIdx(&small, "enabled"));
+    small.node_capacity = trie.node_count;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_trieBuild(&small, &config_table));
+
+    ConfigTrie_t no_storage = {};
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieBuild(&no_storage, &config_table));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieBuild(&trie, nullptr));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieBuild(nullptr, &config_table));
+}
+
+TEST_F(Config_Trie_Test, ExactLookupTest) {
+    for(uint32_t i = 0; i < config_table.count; i++) {
+        EXPECT_EQ(static_cast<int32_t>(i), config_trieGetIdx(&trie, config_entries[i].key)) << config_entries[i].key;
+    }
+    // Paths without an entry and partial segments
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "cfg"));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "cfg.wifi.ap"));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "cfg.wif"));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "cfg.wifi.ssid2"));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "cfg.wifi."));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "odd"));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, ""));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, nullptr));
+    EXPECT_EQ(-1, config_trieGetIdx(nullptr, "enabled"));
+}
+
+TEST_F(Config_Trie_Test, PathLookupTest) {
+    const char* ssid[] = {"cfg", "wifi", "ssid"};
+    EXPECT_EQ(0, config_trieGetIdxFromPath(&trie, ssid, 3));
+    EXPECT_EQ(2, config_trieGetIdxFromPath(&trie, ssid, 2));
+    EXPECT_EQ(-1, config_trieGetIdxFromPath(&trie, ssid, 1));
+    EXPECT_EQ(-1, config_trieGetIdxFromPath(&trie, ssid, 0));
+
+    const char* odd[] = {"odd", "", "key"};
+    EXPECT_EQ(8, config_trieGetIdxFromPath(&trie, odd, 3));
+    EXPECT_EQ(9, config_trieGetIdxFromPath(&trie, odd, 2));
+    // Segments must not contain separators
+    const char* dotted[] = {"cfg", "wifi.ssid"};
+    EXPECT_EQ(-1, config_trieGetIdxFromPath(&trie, dotted, 2));
+    const char* missing[] = {"cfg", nullptr};
+    EXPECT_EQ(-1, config_trieGetIdxFromPath(&trie, missing, 2));
+    EXPECT_EQ(-1, config_trieGetIdxFromPath(&trie, nullptr, 1));
+}
+
+TEST_F(Config_Trie_Test, PrefixTest) {
+    const std::vector<std::string> wifi = {"cfg.wifi", "cfg.wifi.ap.channel", "cfg.wifi.password", "cfg.wifi.ssid"};
+    EXPECT_EQ(wifi, prefixKeys("cfg.wifi"));
+    EXPECT_EQ(std::vector<std::string>{"cfg.wifi.ap.channel"}, prefixKeys("cfg.wifi.ap"));
+    EXPECT_EQ(std::vector<std::string>{"enabled"}, prefixKeys("enabled"));
+    EXPECT_EQ(7u, prefixKeys("cfg").size());
+    EXPECT_EQ((std::vector<std::string>{"odd.", "odd..key"}), prefixKeys("odd"));
+
+    const uint32_t* indices = nullptr;
+    uint32_t count = 0;
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_trieGetPrefix(&trie, "cfg.wif", &indices, &count));
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_trieGetPrefix(&trie, "cfg.wifi.", &indices, &count));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieGetPrefix(&trie, nullptr, &indices, &count));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieGetPrefix(&trie, "cfg", nullptr, &count));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieGetPrefix(&trie, "cfg", &indices, nullptr));
+
+    // Path segments, without segments the whole table
+    const char* wifi_path[] = {"cfg", "wifi"};
+    ASSERT_EQ(CFG_RC_SUCCESS, config_trieGetPrefixFromPath(&trie, wifi_path, 2, &indices, &count));
+    EXPECT_EQ(wifi.size(), count);
+    ASSERT_EQ(CFG_RC_SUCCESS, config_trieGetPrefixFromPath(&trie, nullptr, 0, &indices, &count));
+    EXPECT_EQ(config_table.count, count);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_trieGetPrefixFromPath(&trie, nullptr, 1, &indices, &count));
+}
+
+TEST_F(Config_Trie_Test, DuplicateKeysTest) {
+    config_entries[7].key = "cfg.wifi";
+    ASSERT_EQ(CFG_RC_SUCCESS, config_trieBuild(&trie, &config_table));
+    // The first entry is found like by the linear search, both are part of the prefix
+    EXPECT_EQ(2, config_trieGetIdx(&trie, "cfg.wifi"));
+    EXPECT_EQ(config_getIdxFromKey(&config_table, "cfg.wifi"), config_trieGetIdx(&trie, "cfg.wifi"));
+    EXPECT_EQ(5u, prefixKeys("cfg.wifi").size());
+}
+
+TEST_F(Config_Trie_Test, OutdatedTest) {
+    const uint32_t* indices = nullptr;
+    uint32_t count = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    EXPECT_EQ(-1, config_trieGetIdx(&trie, "enabled"));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_trieGetPrefix(&trie, "cfg", &indices, &count));
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_trieBuild(&trie, &config_table));
+    for(uint32_t i = 0; i < config_table.count; i++) {
+        EXPECT_EQ(static_cast<int32_t>(i), config_trieGetIdx(&trie, config_entries[i].key));
+    }
+
+    ConfigTrie_t unbuilt = {nodes, 32, order};
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_trieGetPrefix(&unbuilt, "cfg", &indices, &count));
+}
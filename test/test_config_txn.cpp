@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "config_log.h"
+#include "config_notify.h"
+#include "config_txn.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+constexpr char snapshot_filename[] = "test_txn_snapshot.txt";
+constexpr char log_filename[] = "test_txn_log.txt";
+
+std::string readFile(const char* filename) {
+    std::ifstream file(filename, std::ios::binary);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+void countBatches(void* ctx, const ConfigTable_t*, const uint32_t*, uint32_t) {
+    (*static_cast<uint32_t*>(ctx))++;
+}
+}  // namespace
+
+class Config_Txn_Test : public testing::Test {
+protected:
+    char _ssid[16] = "home";
+    char _password[16] = "secret";
+    uint32_t _channel = 6;
+    uint32_t _read_only = 7;
+
+    ConfigEntry_t config_entries[4] = {
+        {"wifi.ssid", CONFIG_STRING, &_ssid, sizeof(_ssid)},
+        {"wifi.password", CONFIG_STRING, &_password, sizeof(_password)},
+        {"wifi.channel", CONFIG_UINT32, &_channel, sizeof(_channel)},
+        {"read_only", CONFIG_UINT32, &_read_only, sizeof(_read_only), CFG_PERM_RO},
+    };
+
+    ConfigTable_t config_table = {
+        .entries = config_entries,
+        .count = static_cast<uint32_t>(std::size(config_entries))
+    };
+
+    ConfigStagedWrite_t writes[3];
+    uint8_t buffer[64];
+    uint32_t changed_indices[3];
+    ConfigTxn_t txn = {
+        .writes = writes,
+        .write_capacity = static_cast<uint32_t>(std::size(writes)),
+        .buffer = buffer,
+        .buffer_size = sizeof(buffer),
+        .changed = changed_indices,
+    };
+
+    void SetUp() override {
+        std::remove(snapshot_filename);
+        std::remove(log_filename);
+        ASSERT_EQ(CFG_RC_SUCCESS, config_txnBegin(&txn, &config_table));
+    }
+
+    void TearDown() override {
+        if(config_table.log != nullptr) config_logClose(&config_table);
+        std::remove(snapshot_filename);
+        std::remove(log_filename);
+    }
+};
+
+TEST_F(Config_Txn_Test, CommitTest) {
+    uint32_t channel = 11;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.password", "hunter2", sizeof("hunter2")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &channel, sizeof(channel)));
+    // Nothing is applied before committing
+    EXPECT_STREQ("home", _ssid);
+    EXPECT_EQ(6u, _channel);
+
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnCommit(&txn));
+    EXPECT_STREQ("office", _ssid);
+    EXPECT_STREQ("hunter2", _password);
+    EXPECT_EQ(11u, _channel);
+    // The transaction has ended
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_txnSetByIdx(&txn, 2, &channel, sizeof(channel)));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_txnCommit(&txn));
+}
+
+TEST_F(Config_Txn_Test, RestageReplacesValueTest) {
+    uint32_t channel = 11;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &channel, sizeof(channel)));
+    channel = 13;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &channel, sizeof(channel)));
+    EXPECT_EQ(1u, txn.write_count);
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnCommit(&txn));
+    EXPECT_EQ(13u, _channel);
+}
+
+TEST_F(Config_Txn_Test, FailedStagingAppliesNothingTest) {
+    uint32_t value = 1;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &value, sizeof(value)));
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, config_txnSetByKey(&txn, "read_only", &value, sizeof(value)));
+    EXPECT_EQ(CFG_RC_ERROR_READ_ONLY, config_txnCommit(&txn));
+    EXPECT_STREQ("home", _ssid);
+    EXPECT_EQ(6u, _channel);
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_txnBegin(&txn, &config_table));
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_txnSetByKey(&txn, "wifi.ssid", "a much too long ssid",
+                                                         sizeof("a much too long ssid")));
+    EXPECT_EQ(CFG_RC_ERROR_UNKNOWN_KEY, config_txnSetByKey(&txn, "unknown", &value, sizeof(value)));
+    EXPECT_EQ(CFG_RC_ERROR_RANGE, config_txnSetByIdx(&txn, 4, &value, sizeof(value)));
+    // The first error is reported
+    EXPECT_EQ(CFG_RC_ERROR_TOO_LARGE, config_txnCommit(&txn));
+
+    ASSERT_EQ(CFG_RC_SUCCESS, config_txnBegin(&txn, &config_table));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &value, sizeof(value)));
+    config_txnAbort(&txn);
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_txnCommit(&txn));
+    EXPECT_EQ(6u, _channel);
+}
+
+TEST_F(Config_Txn_Test, SortedTableTest) {
+    uint32_t channel = 11;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &channel, sizeof(channel)));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_sortTable(&config_table));
+    EXPECT_EQ(CFG_RC_ERROR_INVALID, config_txnCommit(&txn));
+    EXPECT_EQ(6u, _channel);
+}
+
+TEST_F(Config_Txn_Test, OneNotificationAndLogWriteTest) {
+    uint32_t pending[1], changed[4], matched[4];
+    ConfigSubscription_t subscriptions[1];
+    ConfigNotifier_t notifier = {pending, changed, matched, subscriptions, 1};
+    notifier.inline_dispatch = true;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_notifyAttach(&config_table, &notifier));
+    uint32_t batch_count = 0;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_subscribeTable(&config_table, countBatches, &batch_count));
+    ConfigLog_t log;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+
+    uint32_t channel = 6;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.password", "hunter2", sizeof("hunter2")));
+    // Unchanged values are neither logged nor notified
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByIdx(&txn, 2, &channel, sizeof(channel)));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnCommit(&txn));
+
+    EXPECT_EQ(1u, batch_count);
+    EXPECT_EQ("wifi.ssid: office\nwifi.password: hunter2\n", readFile(log_filename));
+    config_table.notifier = nullptr;
+    // The log is local to this test
+    EXPECT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+}
+
+TEST_F(Config_Txn_Test, LogWithoutChangedStorageTest) {
+    ConfigLog_t log;
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logOpen(&config_table, &log, snapshot_filename, log_filename, 1024));
+    txn.changed = nullptr;
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(CFG_RC_ERROR_NULLPTR, config_txnCommit(&txn));
+    EXPECT_STREQ("home", _ssid);
+    EXPECT_EQ(&log, config_table.log);
+
+    // Without a log, the indices of changed entries are not needed
+    ASSERT_EQ(CFG_RC_SUCCESS, config_logClose(&config_table));
+    ASSERT_EQ(CFG_RC_SUCCESS, config_txnBegin(&txn, &config_table));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnSetByKey(&txn, "wifi.ssid", "office", sizeof("office")));
+    EXPECT_EQ(CFG_RC_SUCCESS, config_txnCommit(&txn));
+    EXPECT_STREQ("office", _ssid);
+}